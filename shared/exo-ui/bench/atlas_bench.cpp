@@ -0,0 +1,278 @@
+// ── ExoUI Icon Atlas Benchmark ──────────────────────────────
+// Skyline packing speed and fill on one page, then the sidebar's and the
+// toolbar's icons over a session of monitor moves (96, 144, 96, 120, 144,
+// 96 DPI): one bitmap per icon re-created at every new size, against one
+// atlas per control that keeps every size it has uploaded.
+//
+// Checks: packed rectangles stay inside the page and never overlap; the
+// atlas needs fewer live bitmaps, bitmap creations and upload bytes than
+// one bitmap per icon; a size seen before uploads nothing; and a sidebar
+// frame replayed from atlas pages matches the one replayed from separate
+// masks exactly; taking back a new page's slot keeps every other slot.
+// Exits non-zero if any check fails. Portable: builds and runs on Linux.
+
+#include <exo/atlas.h>
+#include <exo/controls/control_paint.h>
+#include <exo/display_list.h>
+#include <exo/soft_canvas.h>
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace exo;
+using namespace exo::bench;
+
+namespace {
+
+constexpr int kSession[] = { 96, 144, 96, 120, 144, 96 };
+
+// Dark palette, see Theme::PaintColors().
+constexpr ControlColors kColors{
+    0xFF1E1E1E, 0xFF282828, 0xFF373737, 0xFF0078D4, 0xFF2D2D2D, 0xFFE6E6E6, 0xFFA0A0A0,
+    0xFF3C3C3C, 0xFF0078D4, 0xFF232323, 0xFFA0A0A0, 0xFFE6E6E6,
+};
+
+// The controls' icons; the names and indices are made up, only their
+// count matters.
+constexpr SidebarItem kSidebarItems[] = {
+    { L"All", "0" }, { L"System", "1" }, { L"Network", "2" }, { L"Security", "3" },
+    { L"Display", "4" }, { L"Programs", "5" }, { L"Storage", "6" }, { L"Devices", "7" },
+    { L"Updates", "8" }, { L"Settings", "9" },
+};
+constexpr int kSidebarCount   = static_cast<int>(std::size(kSidebarItems));
+constexpr int kToolbarIcons[] = { 10, 9, 11 };     // refresh, settings, theme
+
+// A ring whose radius depends on the icon, standing in for its mask.
+std::vector<uint8_t> Ring(int index, int size) {
+    std::vector<uint8_t> mask(static_cast<size_t>(size) * size);
+    float c = size / 2.0f, r = size * (0.2f + 0.02f * static_cast<float>(index % 10));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float d = std::fabs(std::hypot(x + 0.5f - c, y + 0.5f - c) - r) - size * 0.06f;
+            float a = d < -0.5f ? 1.0f : d > 0.5f ? 0.0f : 0.5f - d;
+            mask[static_cast<size_t>(y) * size + x] = static_cast<uint8_t>(a * 255.0f + 0.5f);
+        }
+    }
+    return mask;
+}
+
+// ── Packer ──────────────────────────────────────────────────
+
+void PackerRun(const char* name, int minSide, int maxSide, bool square) {
+    constexpr int kPage = 1024;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> side(minSide, maxSide);
+
+    SkylinePacker packer;
+    packer.Reset(kPage, kPage);
+    std::vector<uint8_t> used(static_cast<size_t>(kPage) * kPage);
+    int placed = 0, misses = 0;
+    double us = 0;
+    bool inside = true, disjoint = true;
+
+    // Keep going until a run of rectangles in a row no longer fits.
+    while (misses < 32) {
+        int w = side(rng), h = square ? w : side(rng);
+        int x = 0, y = 0;
+        auto t0 = Clock::now();
+        bool ok = packer.Insert(w, h, x, y);
+        us += Us(t0, Clock::now());
+        if (!ok) {
+            misses++;
+            continue;
+        }
+        misses = 0;
+        placed++;
+        if (x < 0 || y < 0 || x + w > kPage || y + h > kPage) {
+            inside = false;
+            continue;
+        }
+        for (int yy = y; yy < y + h; yy++) {
+            for (int xx = x; xx < x + w; xx++) {
+                uint8_t& cell = used[static_cast<size_t>(yy) * kPage + xx];
+                if (cell) disjoint = false;
+                cell = 1;
+            }
+        }
+    }
+    Check(inside, "packed rectangle outside the page");
+    Check(disjoint, "packed rectangles overlap");
+    printf("%-18s  %7d  %7.1f%%  %9.0f\n", name, placed,
+           100.0 * static_cast<double>(packer.UsedArea()) / (static_cast<double>(kPage) * kPage),
+           us * 1000.0 / std::max(placed, 1));
+}
+
+// ── Session ─────────────────────────────────────────────────
+
+struct SessionCost {
+    uint64_t liveBitmaps;
+    uint64_t created;
+    uint64_t uploadBytes;
+    uint64_t uploads;
+};
+
+// One bitmap per icon, rebuilt whenever the icon size changes: what the
+// controls did before the atlas.
+SessionCost PerIcon(int iconCount, int baseSize) {
+    SessionCost cost{};
+    int cached = 0;
+    for (int dpi : kSession) {
+        int size = PaintScale(baseSize, dpi);
+        if (size == cached) continue;
+        cost.created     += iconCount;
+        cost.uploads     += iconCount;
+        cost.uploadBytes += static_cast<uint64_t>(iconCount) * size * size;
+        cached = size;
+    }
+    cost.liveBitmaps = iconCount;
+    return cost;
+}
+
+SessionCost Atlas(const int* indices, int iconCount, int baseSize, bool& revisitFree) {
+    MaskAtlas atlas;
+    SessionCost cost{};
+    std::vector<int> seen;
+    revisitFree = true;
+    for (int dpi : kSession) {
+        int size = PaintScale(baseSize, dpi);
+        bool revisit = std::find(seen.begin(), seen.end(), size) != seen.end();
+        uint64_t before = cost.uploads;
+        for (int i = 0; i < iconCount; i++) {
+            if (atlas.Find(indices[i], size) >= 0) continue;
+            if (atlas.Insert(indices[i], size) < 0) {
+                Check(false, "atlas full");
+                continue;
+            }
+            int cell = size + 2 * MaskAtlas::kPadding;
+            cost.uploads++;
+            cost.uploadBytes += static_cast<uint64_t>(cell) * cell;
+        }
+        if (revisit && cost.uploads != before) revisitFree = false;
+        seen.push_back(size);
+    }
+    cost.liveBitmaps = atlas.PageCount();
+    cost.created     = atlas.PageCount();
+    return cost;
+}
+
+void SessionRow(const char* name, const int* indices, int iconCount, int baseSize) {
+    bool revisitFree = false;
+    SessionCost before = PerIcon(iconCount, baseSize);
+    SessionCost after  = Atlas(indices, iconCount, baseSize, revisitFree);
+    printf("%-8s  %5llu -> %-3llu  %5llu -> %-3llu  %6llu -> %-4llu  %7.1f -> %.1f\n", name,
+           static_cast<unsigned long long>(before.liveBitmaps),
+           static_cast<unsigned long long>(after.liveBitmaps),
+           static_cast<unsigned long long>(before.created),
+           static_cast<unsigned long long>(after.created),
+           static_cast<unsigned long long>(before.uploads),
+           static_cast<unsigned long long>(after.uploads),
+           before.uploadBytes / 1024.0, after.uploadBytes / 1024.0);
+
+    Check(after.liveBitmaps < before.liveBitmaps, "atlas keeps as many bitmaps as icons");
+    Check(after.created < before.created, "atlas creates as many bitmaps");
+    Check(after.uploadBytes < before.uploadBytes, "atlas uploads as much");
+    Check(revisitFree, "a size seen before uploaded again");
+}
+
+// ── Replay ──────────────────────────────────────────────────
+
+// The sidebar frame drawn from separate masks and from atlas pages holding
+// the same masks must be identical.
+void CheckReplay(int dpi) {
+    SidebarPaint p;
+    p.items    = kSidebarItems;
+    p.count    = kSidebarCount;
+    p.selected = 2;
+    p.hovered  = 4;
+    p.dpi      = dpi;
+    p.width    = static_cast<float>(PaintScale(SidebarPaint::BASE_WIDTH, dpi));
+    p.height   = static_cast<float>(PaintScale(480, dpi));
+    p.colors   = kColors;
+    DisplayList list;
+    p.Record(list);
+
+    int size = p.IconSize();
+    MaskAtlas atlas;
+    std::vector<std::vector<uint8_t>> masks, pages;
+    std::vector<DlImage> separate, packed;
+    for (int i = 0; i < kSidebarCount; i++) {
+        masks.push_back(Ring(i, size));
+        separate.push_back(DlImage{ masks.back().data(), size, size, size });
+    }
+    for (int i = 0; i < kSidebarCount; i++) {
+        int slot = atlas.Insert(i, size);
+        if (slot < 0) {
+            Check(false, "sidebar icons don't fit the atlas");
+            return;
+        }
+        const AtlasSlot& s = atlas.Slot(slot);
+        int page = atlas.PageSize();
+        while (static_cast<int>(pages.size()) <= s.page)
+            pages.emplace_back(static_cast<size_t>(page) * page, 0);
+        for (int y = 0; y < size; y++) {
+            memcpy(&pages[s.page][static_cast<size_t>(s.y + y) * page + s.x],
+                   &masks[i][static_cast<size_t>(y) * size], size);
+        }
+    }
+    for (int i = 0; i < kSidebarCount; i++) {
+        const AtlasSlot& s = atlas.Slot(atlas.Find(i, size));
+        int page = atlas.PageSize();
+        packed.push_back(DlImage{ &pages[s.page][static_cast<size_t>(s.y) * page + s.x],
+                                  size, size, page });
+    }
+
+    int w = static_cast<int>(p.width), h = static_cast<int>(p.height);
+    SoftwareCanvas a(w, h), b(w, h);
+    a.Replay(list, separate.data(), static_cast<int>(separate.size()));
+    b.Replay(list, packed.data(), static_cast<int>(packed.size()));
+    Check(memcmp(a.Pixels(), b.Pixels(), static_cast<size_t>(a.Stride()) * h) == 0,
+          "frame from the atlas differs");
+}
+
+// A page whose bitmap can't be made is given back without disturbing the
+// slots already handed out.
+void CheckRemoveLast() {
+    MaskAtlas atlas(64, 2);
+    int first = atlas.Insert(0, 60);
+    int second = atlas.Insert(1, 60);
+    AtlasSlot kept = atlas.Slot(first);
+    atlas.RemoveLast(1, 60);
+    Check(second == 1 && atlas.PageCount() == 1 && atlas.SlotCount() == 1,
+          "removing a new page's slot left the page behind");
+    Check(atlas.Find(1, 60) < 0, "removed slot still found");
+    const AtlasSlot& s = atlas.Slot(atlas.Find(0, 60));
+    Check(s.page == kept.page && s.x == kept.x && s.y == kept.y, "earlier slot moved");
+    Check(atlas.Insert(1, 60) == 1 && atlas.PageCount() == 2, "removed page not reopened");
+}
+
+} // namespace
+
+int main() {
+    printf("ExoUI icon atlas benchmark\n\n");
+    printf("Skyline packing into one 1024 x 1024 page\n");
+    printf("%-18s  %7s  %8s  %9s\n", "rectangles", "placed", "fill", "ns/insert");
+    PackerRun("icons 16-48 sq", 18, 50, true);
+    PackerRun("icons 16-128 sq", 18, 130, true);
+    PackerRun("mixed 8-96", 8, 96, false);
+
+    int sidebar[kSidebarCount];
+    for (int i = 0; i < kSidebarCount; i++) sidebar[i] = i;
+    printf("\nSession at");
+    for (int dpi : kSession) printf(" %d", dpi);
+    printf(" DPI: per-icon bitmaps -> atlas\n");
+    printf("%-8s  %11s  %11s  %14s  %15s\n", "control", "live bmps", "created", "uploads", "upload KB");
+    SessionRow("sidebar", sidebar, kSidebarCount, SidebarPaint::BASE_ICON_SIZE);
+    SessionRow("toolbar", kToolbarIcons, static_cast<int>(std::size(kToolbarIcons)),
+               ToolbarPaint::BASE_ICON_SIZE);
+
+    for (int dpi : { 96, 144 }) CheckReplay(dpi);
+    CheckRemoveLast();
+
+    return Finish();
+}
@@ -0,0 +1,36 @@
+#pragma once
+// ── ExoUI Bench Helpers ─────────────────────────────────────
+// Timing and check bookkeeping shared by the benchmarks. Each bench is
+// its own executable, so there is one failure count per program; main
+// ends with `return Finish();`.
+
+#include <chrono>
+#include <cstdio>
+
+namespace exo::bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double Us(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+inline double Ns(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::nano>(b - a).count();
+}
+
+inline int failures = 0;
+
+inline void Check(bool ok, const char* what) {
+    if (ok) return;
+    fprintf(stderr, "%s\n", what);
+    failures++;
+}
+
+// Prints the verdict line and returns the exit code.
+inline int Finish() {
+    printf("\n%s: %d failed checks\n", failures ? "FAIL" : "OK", failures);
+    return failures ? 1 : 0;
+}
+
+} // namespace exo::bench
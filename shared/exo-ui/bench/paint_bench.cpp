@@ -0,0 +1,267 @@
+// ── ExoUI Paint Benchmark ───────────────────────────────────
+// Headless cost of the controls' retained paint path: record a frame,
+// diff it against the one on screen and replay only the changed areas on
+// the software canvas, next to a full replay of the same frame. Covers a
+// 100-item sidebar, the toolbar and the status bar at 96 and 144 DPI.
+//
+// Checks, per state change: recording the same state twice gives equal
+// lists and an empty diff; every pixel that changed lies inside the diff;
+// and the partially repainted canvas matches the full replay exactly.
+// Exits non-zero if any check fails. Portable: builds and runs on Linux.
+
+#include <exo/controls/control_paint.h>
+#include <exo/display_list.h>
+#include <exo/soft_canvas.h>
+#include "bench_util.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace exo;
+using namespace exo::bench;
+
+namespace {
+
+constexpr int kDpis[]       = { 96, 144 };
+constexpr int kSidebarItems = 100;
+
+// Dark palette, see Theme::PaintColors().
+constexpr ControlColors kColors{
+    0xFF1E1E1E, 0xFF282828, 0xFF373737, 0xFF0078D4, 0xFF2D2D2D, 0xFFE6E6E6, 0xFFA0A0A0,
+    0xFF3C3C3C, 0xFF0078D4, 0xFF232323, 0xFFA0A0A0, 0xFFE6E6E6,
+};
+
+struct Totals {
+    int      steps;
+    double   recordUs;
+    double   diffUs;
+    double   partialUs;
+    double   fullUs;
+    uint64_t partialPixels;
+    uint64_t fullPixels;
+    int      failures;
+};
+
+// Anti-aliased disc, standing in for an icon mask.
+std::vector<uint8_t> Disc(int size) {
+    std::vector<uint8_t> mask(static_cast<size_t>(size) * size);
+    float c = size / 2.0f, r = size * 0.4f;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float d = std::hypot(x + 0.5f - c, y + 0.5f - c) - r;
+            float a = d < -0.5f ? 1.0f : d > 0.5f ? 0.0f : 0.5f - d;
+            mask[static_cast<size_t>(y) * size + x] = static_cast<uint8_t>(a * 255.0f + 0.5f);
+        }
+    }
+    return mask;
+}
+
+bool Inside(const std::vector<DlRect>& rects, int x, int y) {
+    for (const auto& r : rects) {
+        if (x >= std::floor(r.left) && x < std::ceil(r.right) &&
+            y >= std::floor(r.top) && y < std::ceil(r.bottom))
+            return true;
+    }
+    return false;
+}
+
+uint64_t ClippedArea(const DlRect& r, int width, int height) {
+    float w = std::fmin(std::ceil(r.right), static_cast<float>(width)) - std::fmax(std::floor(r.left), 0.0f);
+    float h = std::fmin(std::ceil(r.bottom), static_cast<float>(height)) - std::fmax(std::floor(r.top), 0.0f);
+    return w > 0 && h > 0 ? static_cast<uint64_t>(w) * static_cast<uint64_t>(h) : 0;
+}
+
+// Walk a control through `states` (record(i, list) records state i; state
+// 0 is what's on screen first), repainting each change both ways.
+template <typename RecordFn>
+Totals Run(const char* name, int dpi, int width, int height, int states,
+           const std::vector<DlImage>& images, RecordFn record)
+{
+    Totals t{};
+    const DlImage* img = images.data();
+    int imgCount = static_cast<int>(images.size());
+
+    SoftwareCanvas shown(width, height), full(width, height);
+    DisplayList list, next, again;
+    std::vector<DlRect> changed, none;
+
+    record(0, list);
+    shown.Replay(list, img, imgCount);
+
+    for (int s = 1; s < states; s++) {
+        auto t0 = Clock::now();
+        record(s, next);
+        auto t1 = Clock::now();
+        changed.clear();
+        DisplayList::Diff(list, next, changed);
+        auto t2 = Clock::now();
+
+        SoftwareCanvas before = shown;
+        auto t3 = Clock::now();
+        for (const auto& r : changed) shown.Replay(next, img, imgCount, &r);
+        auto t4 = Clock::now();
+        full.Clear(0);
+        full.Replay(next, img, imgCount);
+        auto t5 = Clock::now();
+
+        t.steps++;
+        t.recordUs  += Us(t0, t1);
+        t.diffUs    += Us(t1, t2);
+        t.partialUs += Us(t3, t4);
+        t.fullUs    += Us(t4, t5);
+        for (const auto& r : changed) t.partialPixels += ClippedArea(r, width, height);
+        t.fullPixels += static_cast<uint64_t>(width) * height;
+
+        record(s, again);
+        none.clear();
+        DisplayList::Diff(next, again, none);
+        if (!(again == next) || !none.empty()) {
+            fprintf(stderr, "%s @%d state %d: re-recording differs\n", name, dpi, s);
+            t.failures++;
+        }
+
+        int outside = 0, mismatched = 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                uint32_t want = full.Pixel(x, y);
+                if (shown.Pixel(x, y) != want) mismatched++;
+                if (before.Pixel(x, y) != want && !Inside(changed, x, y)) outside++;
+            }
+        }
+        if (outside) {
+            fprintf(stderr, "%s @%d state %d: %d changed pixels outside the diff\n",
+                    name, dpi, s, outside);
+            t.failures++;
+        }
+        if (mismatched) {
+            fprintf(stderr, "%s @%d state %d: partial repaint differs from full in %d pixels\n",
+                    name, dpi, s, mismatched);
+            t.failures++;
+        }
+
+        std::swap(list, next);
+    }
+    return t;
+}
+
+void Report(const char* name, int dpi, const Totals& t) {
+    double n = t.steps ? t.steps : 1;
+    printf("%-9s  %4d  %5d  %9.1f  %7.2f  %10.1f  %8.1f  %7.1fx  %8.1f%%\n",
+        name, dpi, t.steps, t.recordUs / n, t.diffUs / n, t.partialUs / n, t.fullUs / n,
+        t.partialUs > 0 ? t.fullUs / t.partialUs : 0.0,
+        t.fullPixels ? 100.0 * static_cast<double>(t.partialPixels) / static_cast<double>(t.fullPixels) : 0.0);
+}
+
+} // namespace
+
+int main() {
+    std::vector<std::wstring> labels;
+    std::vector<SidebarItem> items;
+    labels.reserve(kSidebarItems);
+    for (int i = 0; i < kSidebarItems; i++)
+        labels.push_back(L"Category " + std::to_wstring(i + 1));
+    for (const auto& label : labels)
+        items.push_back({ label.c_str(), "view-list" });
+
+    static constexpr ToolbarButton kButtons[] = {
+        { 1001, L"Large",   "view-large-icons", 52, true,  false },
+        { 1002, L"Small",   "view-small-icons", 50, true,  false },
+        { 1003, L"List",    "view-list",        42, true,  false },
+        { 1004, L"Details", "view-details",     58, true,  false },
+        { 1010, L"",        "refresh",          36, false, false },
+        { 1020, L"",        "settings",         36, false, true  },
+        { 1030, L"",        "theme-dark",       36, false, true  },
+    };
+    constexpr int kButtonCount = static_cast<int>(std::size(kButtons));
+
+    static constexpr const wchar_t* kMessages[] = {
+        L"Ready", L"Large Icons", L"Small Icons", L"List", L"Details",
+        L"Refreshing...", L"Ready",
+    };
+    constexpr int kMessageCount = static_cast<int>(std::size(kMessages));
+
+    printf("ExoUI paint benchmark: per state change, record + diff + partial replay "
+           "vs full replay (software canvas)\n\n");
+    printf("%-9s  %4s  %5s  %9s  %7s  %10s  %8s  %8s  %9s\n",
+        "control", "dpi", "steps", "record us", "diff us", "partial us", "full us",
+        "speedup", "repainted");
+
+    for (int dpi : kDpis) {
+        // Sidebar: hover down every item, leave, then move the selection.
+        SidebarPaint sidebar;
+        sidebar.items  = items.data();
+        sidebar.count  = kSidebarItems;
+        sidebar.dpi    = dpi;
+        sidebar.width  = static_cast<float>(PaintScale(SidebarPaint::BASE_WIDTH, dpi));
+        sidebar.height = std::ceil(sidebar.ItemsTop()) +
+                         static_cast<float>(kSidebarItems * sidebar.ItemHeight());
+        sidebar.colors = kColors;
+
+        std::vector<std::pair<int, int>> sidebarStates{ { 0, -1 } };    // selected, hovered
+        for (int i = 0; i < kSidebarItems; i++) sidebarStates.push_back({ 0, i });
+        sidebarStates.push_back({ 0, -1 });
+        for (int sel : { 5, 50, kSidebarItems - 1, 0 }) sidebarStates.push_back({ sel, -1 });
+
+        auto mask = Disc(sidebar.IconSize());
+        std::vector<DlImage> masks(kSidebarItems,
+            DlImage{ mask.data(), sidebar.IconSize(), sidebar.IconSize(), sidebar.IconSize() });
+
+        Totals t = Run("sidebar", dpi, static_cast<int>(sidebar.width), static_cast<int>(sidebar.height),
+            static_cast<int>(sidebarStates.size()), masks,
+            [&](int s, DisplayList& out) {
+                sidebar.selected = sidebarStates[s].first;
+                sidebar.hovered  = sidebarStates[s].second;
+                sidebar.Record(out);
+            });
+        Report("sidebar", dpi, t);
+        failures += t.failures;
+
+        // Toolbar: hover across every button, then switch views.
+        ToolbarPaint toolbar;
+        toolbar.buttons  = kButtons;
+        toolbar.count    = kButtonCount;
+        toolbar.dpi      = dpi;
+        toolbar.width    = static_cast<float>(PaintScale(800, dpi));
+        toolbar.height   = static_cast<float>(PaintScale(ToolbarPaint::BASE_HEIGHT, dpi));
+        toolbar.colors   = kColors;
+        ToolbarLayout layout;
+        layout.Build(kButtons, kButtonCount, dpi, toolbar.width);
+        toolbar.layout   = &layout;
+
+        std::vector<std::pair<uint16_t, int>> toolbarStates{ { 1001, -1 } };  // active, hovered
+        for (int i = 0; i < kButtonCount; i++) toolbarStates.push_back({ 1001, i });
+        toolbarStates.push_back({ 1001, -1 });
+        for (uint16_t id : { 1002, 1003, 1004, 1001 }) toolbarStates.push_back({ id, -1 });
+
+        t = Run("toolbar", dpi, static_cast<int>(toolbar.width), static_cast<int>(toolbar.height),
+            static_cast<int>(toolbarStates.size()), {},
+            [&](int s, DisplayList& out) {
+                toolbar.activeId = toolbarStates[s].first;
+                toolbar.hovered  = toolbarStates[s].second;
+                toolbar.Record(out);
+            });
+        Report("toolbar", dpi, t);
+        failures += t.failures;
+
+        // Status bar: a run of messages.
+        StatusBarPaint status;
+        status.dpi    = dpi;
+        status.width  = static_cast<float>(PaintScale(800, dpi));
+        status.height = static_cast<float>(PaintScale(StatusBarPaint::BASE_HEIGHT, dpi));
+        status.colors = kColors;
+
+        t = Run("statusbar", dpi, static_cast<int>(status.width), static_cast<int>(status.height),
+            kMessageCount, {},
+            [&](int s, DisplayList& out) {
+                status.text = kMessages[s];
+                status.Record(out);
+            });
+        Report("statusbar", dpi, t);
+        failures += t.failures;
+    }
+
+    return Finish();
+}
@@ -0,0 +1,183 @@
+// ── ExoUI Paint Statistics Benchmark ────────────────────────
+// What recording a paint costs, alone and while another thread keeps
+// taking snapshots the way the profiler overlay does, and the report
+// the overlay and a dump are built from.
+//
+// Checks: durations land in the right buckets; mean and percentiles come
+// out of a known mix; Reset() clears everything; snapshots taken during
+// recording never go backwards and the final one is exact; report rates
+// are per second between reports and absent after a reset. Exits non-zero
+// if any check fails. Portable: builds and runs on Linux.
+
+#include <exo/paint_stats.h>
+#include "bench_util.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+using namespace exo;
+using namespace exo::bench;
+
+namespace {
+
+uint64_t BucketTotal(const PaintSnapshot& s) {
+    uint64_t total = 0;
+    for (uint64_t n : s.buckets) total += n;
+    return total;
+}
+
+bool HasLine(const ProfileReport& report, const char* text) {
+    for (const auto& line : report.Lines())
+        if (line.find(text) != std::string::npos) return true;
+    return false;
+}
+
+// ── Buckets and percentiles ─────────────────────────────────
+
+void CheckBuckets() {
+    Check(PaintSnapshot::BucketFor(0) == 0, "0us not in bucket 0");
+    Check(PaintSnapshot::BucketFor(63) == 0, "63us not in bucket 0");
+    Check(PaintSnapshot::BucketFor(64) == 1, "64us not in bucket 1");
+    Check(PaintSnapshot::BucketFor(127) == 1, "127us not in bucket 1");
+    Check(PaintSnapshot::BucketFor(128) == 2, "128us not in bucket 2");
+    Check(PaintSnapshot::BucketFor(UINT64_MAX) == PaintSnapshot::kBuckets - 1, "longest paint not in last bucket");
+    for (int b = 0; b < PaintSnapshot::kBuckets - 1; b++) {
+        uint64_t limit = PaintSnapshot::BucketLimitUs(b);
+        if (PaintSnapshot::BucketFor(limit - 1) != b || PaintSnapshot::BucketFor(limit) != b + 1)
+            Check(false, "bucket limit disagrees with BucketFor");
+    }
+
+    PaintRecorder rec;
+    PaintSnapshot empty = rec.Snapshot();
+    Check(empty.PercentileUs(0.5) == 0 && empty.MeanUs() == 0, "empty recorder has a percentile");
+
+    for (int i = 0; i < 90; i++) rec.Record(100, 1000, 5);
+    for (int i = 0; i < 10; i++) rec.Record(5000, 4000, 20);
+    rec.RecordRecreate();
+    PaintSnapshot s = rec.Snapshot();
+    Check(s.paints == 100 && s.pixels == 130000 && s.items == 650, "counters wrong");
+    Check(s.microseconds == 59000 && s.maxMicroseconds == 5000, "durations wrong");
+    Check(s.recreates == 1, "recreate not counted");
+    Check(s.MeanUs() == 590.0, "mean wrong");
+    Check(s.PercentileUs(0.5) == 128, "p50 not the 64-128us bucket");
+    Check(s.PercentileUs(0.9) == 128, "p90 not the 64-128us bucket");
+    Check(s.PercentileUs(0.95) == 5000, "p95 not capped at the longest paint");
+    Check(BucketTotal(s) == s.paints, "bucket counts don't add up");
+
+    rec.Reset();
+    PaintSnapshot r = rec.Snapshot();
+    Check(r.paints == 0 && r.pixels == 0 && r.items == 0 && r.microseconds == 0 &&
+          r.maxMicroseconds == 0 && r.recreates == 0 && BucketTotal(r) == 0, "Reset left counters");
+}
+
+// ── Recording cost ──────────────────────────────────────────
+
+constexpr int kPaints = 2000000;
+
+double RecordRun(PaintRecorder& rec) {
+    auto t0 = Clock::now();
+    for (int i = 0; i < kPaints; i++) rec.Record(static_cast<uint64_t>(i % 3000), 10, 3);
+    return Ns(t0, Clock::now()) / kPaints;
+}
+
+void Cost() {
+    PaintRecorder alone;
+    double aloneNs = RecordRun(alone);
+
+    PaintRecorder rec;
+    std::atomic<bool> done{ false };
+    uint64_t snapshots = 0;
+    bool monotonic = true;
+    std::thread reader([&] {
+        PaintSnapshot last{};
+        while (!done.load(std::memory_order_acquire)) {
+            PaintSnapshot s = rec.Snapshot();
+            if (s.paints < last.paints || s.pixels < last.pixels || s.items < last.items ||
+                s.microseconds < last.microseconds || s.maxMicroseconds < last.maxMicroseconds)
+                monotonic = false;
+            for (int b = 0; b < PaintSnapshot::kBuckets; b++)
+                if (s.buckets[b] < last.buckets[b]) monotonic = false;
+            last = s;
+            snapshots++;
+        }
+    });
+    double sharedNs = RecordRun(rec);
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    PaintSnapshot s = rec.Snapshot();
+    Check(monotonic, "a snapshot went backwards");
+    Check(s.paints == kPaints && s.pixels == 10ull * kPaints && s.items == 3ull * kPaints,
+          "counters lost updates");
+    Check(BucketTotal(s) == kPaints, "buckets lost updates");
+    Check(s.maxMicroseconds == 2999, "max wrong");
+
+    printf("%-28s %8.1f\n", "Record(), alone", aloneNs);
+    printf("%-28s %8.1f   (%llu snapshots taken)\n", "Record(), reader polling", sharedNs,
+           static_cast<unsigned long long>(snapshots));
+}
+
+// ── Report ──────────────────────────────────────────────────
+
+void CheckReport() {
+    PaintRecorder rec;
+    for (int i = 0; i < 20; i++) rec.Record(300, 50000, 40);
+
+    ProfileReport report;
+    report.Begin(0);
+    report.Paint("sidebar", rec.Snapshot());
+    report.Hits("layouts", 90, 10);
+    report.Rate("renders", 100);
+    Check(report.Lines().size() == 3, "one line per row expected");
+    Check(HasLine(report, "-/s"), "first report has a rate");
+    Check(HasLine(report, "90.0% hit"), "hit rate wrong");
+
+    for (int i = 0; i < 50; i++) rec.Record(300, 50000, 40);
+    report.Begin(2000);
+    report.Paint("sidebar", rec.Snapshot());
+    report.Hits("layouts", 190, 30);
+    report.Rate("renders", 160);
+    Check(report.Lines().size() == 3, "Begin didn't clear lines");
+    Check(HasLine(report, "25.0/s"), "paint rate wrong");
+    Check(HasLine(report, "10.0/s"), "miss rate wrong");
+    Check(HasLine(report, "30.0/s"), "total rate wrong");
+
+    // A reset counter has no rate until the next report.
+    rec.Reset();
+    report.Begin(3000);
+    report.Paint("sidebar", rec.Snapshot());
+    Check(HasLine(report, "-/s"), "rate across a reset");
+
+    PaintRecorder mix;
+    for (int i = 0; i < 90; i++) mix.Record(100, 1000, 5);
+    for (int i = 0; i < 10; i++) mix.Record(5000, 4000, 20);
+    report.Begin(4000);
+    report.Histogram("item view", mix.Snapshot());
+    Check(report.Lines().size() == 3, "histogram: title and two buckets expected");
+    report.Histogram("empty", PaintRecorder().Snapshot());
+    Check(report.Lines().size() == 3, "empty histogram printed");
+
+    std::string text = report.Text();
+    Check(!text.empty() && text.back() == '\n', "text not newline-terminated");
+
+    printf("\n");
+    report.Begin(5000);
+    report.Paint("item view", mix.Snapshot());
+    report.Histogram("item view", mix.Snapshot());
+    printf("%s", report.Text().c_str());
+}
+
+} // namespace
+
+int main() {
+    printf("ExoUI paint statistics benchmark\n\n");
+    CheckBuckets();
+
+    printf("%-28s %8s\n", "operation", "ns/paint");
+    Cost();
+    CheckReport();
+
+    return Finish();
+}
@@ -0,0 +1,212 @@
+// ── ExoUI Toolbar Layout Benchmark ──────────────────────────
+// Cost of ToolbarLayout (build once per resize, binary-search hit tests)
+// against the per-call placement it replaced, which recomputed every
+// button's rectangle on each hit test.
+//
+// Checks: with room to spare the stock buttons land exactly where the old
+// placement put them; visible buttons never overlap and stay in order;
+// every left button is either visible or, from the first that didn't fit
+// on, in the overflow menu, and only the innermost right buttons
+// overflow; HitTest agrees with a linear scan at every pixel column.
+// Exits non-zero if any check fails. Portable: builds and runs on Linux.
+
+#include <exo/controls/control_paint.h>
+#include "bench_util.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+using namespace exo;
+using namespace exo::bench;
+
+namespace {
+
+constexpr int kDpis[]   = { 96, 144 };
+constexpr int kCounts[] = { 7, 32, 128, 512 };
+constexpr int kWidths[] = { 120, 400, 800, 1600, 3200 };   // at 96 DPI
+
+constexpr ToolbarButton kStock[] = {
+    { 1001, L"Large",   "view-large-icons", 52, true,  false },
+    { 1002, L"Small",   "view-small-icons", 50, true,  false },
+    { 1003, L"List",    "view-list",        42, true,  false },
+    { 1004, L"Details", "view-details",     58, true,  false },
+    { 1010, L"",        "refresh",          36, false, false },
+    { 1020, L"",        "settings",         36, false, true  },
+    { 1030, L"",        "theme-dark",       36, false, true  },
+};
+
+// The stock set, then extension buttons: mostly left-aligned, every
+// eighth on the right.
+std::vector<ToolbarButton> Buttons(int count) {
+    std::vector<ToolbarButton> out(std::begin(kStock), std::end(kStock));
+    for (int i = static_cast<int>(out.size()); i < count; i++) {
+        out.push_back({ static_cast<uint16_t>(2000 + i), L"Ext", "puzzle",
+                        32 + (i * 7) % 40, false, i % 8 == 0 });
+    }
+    out.resize(count);
+    return out;
+}
+
+// The placement ToolbarLayout replaced: one button's rectangle, walking
+// the whole set each time.
+DlRect OldButtonRect(const ToolbarButton* b, int count, int idx, int dpi, float width) {
+    float pad    = static_cast<float>(PaintScale(4, dpi));
+    float margin = static_cast<float>(PaintScale(8, dpi));
+    float h      = static_cast<float>(PaintScale(ToolbarPaint::BASE_HEIGHT, dpi));
+    auto w = [&](int i) { return static_cast<float>(PaintScale(b[i].baseWidth, dpi)); };
+
+    if (b[idx].rightAlign) {
+        float rightX = width - margin;
+        for (int i = count - 1; i >= idx; i--)
+            if (b[i].rightAlign) rightX -= w(i) + pad;
+        return DlRect{ rightX, pad, rightX + w(idx), h - pad };
+    }
+    float x = margin;
+    for (int i = 0; i < idx; i++)
+        if (!b[i].rightAlign) x += w(i) + pad;
+    if (idx > 0 && !b[idx].toggle && b[idx - 1].toggle) x += margin;
+    return DlRect{ x, pad, x + w(idx), h - pad };
+}
+
+int OldHitTest(const ToolbarButton* b, int count, int dpi, float width, float x, float y) {
+    for (int i = 0; i < count; i++) {
+        DlRect r = OldButtonRect(b, count, i, dpi, width);
+        if (x >= r.left && x <= r.right && y >= r.top && y <= r.bottom) return i;
+    }
+    return -1;
+}
+
+int ScanHitTest(const ToolbarLayout& layout, float x, float y) {
+    for (int i = 0; i < layout.Count(); i++) {
+        if (!layout.Visible(i)) continue;
+        const DlRect& r = layout.Rect(i);
+        if (x >= r.left && x <= r.right && y >= r.top && y <= r.bottom) return i;
+    }
+    if (layout.HasOverflow()) {
+        const DlRect& r = layout.ChevronRect();
+        if (x >= r.left && x <= r.right && y >= r.top && y <= r.bottom) return ToolbarLayout::kChevron;
+    }
+    return -1;
+}
+
+void Fail(const char* what, int count, int dpi, float width) {
+    fprintf(stderr, "%d buttons @%d, width %.0f: %s\n", count, dpi, width, what);
+    failures++;
+}
+
+void Check(const std::vector<ToolbarButton>& buttons, const ToolbarLayout& layout,
+           int dpi, float width)
+{
+    int count = static_cast<int>(buttons.size());
+    float y = static_cast<float>(PaintScale(ToolbarPaint::BASE_HEIGHT, dpi)) / 2;
+
+    // Overflow: every hidden button, in order. Hidden left buttons run
+    // from the first that didn't fit; hidden right ones are the innermost.
+    std::vector<int> hidden;
+    for (int i = 0; i < count; i++)
+        if (!layout.Visible(i)) hidden.push_back(i);
+    if (hidden != layout.Overflow()) Fail("overflow list mismatch", count, dpi, width);
+    bool leftHidden = false, rightShown = false;
+    for (int i = 0; i < count; i++) {
+        if (buttons[i].rightAlign) {
+            if (layout.Visible(i)) rightShown = true;
+            else if (rightShown) Fail("outer right button hidden", count, dpi, width);
+        } else {
+            if (!layout.Visible(i)) leftHidden = true;
+            else if (leftHidden) Fail("overflow not a suffix", count, dpi, width);
+        }
+    }
+
+    // Left buttons in order and apart, and clear of the right group.
+    float lastRight = -1e9f, rightGroup = 1e9f;
+    for (int i = 0; i < count; i++)
+        if (buttons[i].rightAlign && layout.Visible(i)) rightGroup = std::min(rightGroup, layout.Rect(i).left);
+    for (int i = 0; i < count; i++) {
+        if (buttons[i].rightAlign || !layout.Visible(i)) continue;
+        const DlRect& r = layout.Rect(i);
+        if (r.left <= lastRight) Fail("left buttons overlap", count, dpi, width);
+        if (r.right > rightGroup) Fail("left button under the right group", count, dpi, width);
+        lastRight = r.right;
+    }
+    if (layout.HasOverflow()) {
+        const DlRect& c = layout.ChevronRect();
+        if (c.left <= lastRight || c.right > rightGroup)
+            Fail("chevron overlaps a button", count, dpi, width);
+    }
+
+    for (int x = -4; x <= static_cast<int>(width) + 4; x++) {
+        for (float py : { y, 0.0f, y * 2 }) {
+            float px = static_cast<float>(x);
+            if (layout.HitTest(px, py) != ScanHitTest(layout, px, py)) {
+                Fail("HitTest disagrees with a scan", count, dpi, width);
+                return;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    // With everything fitting, the stock buttons keep their old places.
+    for (int dpi : kDpis) {
+        float width = static_cast<float>(PaintScale(800, dpi));
+        ToolbarLayout layout;
+        layout.Build(kStock, static_cast<int>(std::size(kStock)), dpi, width);
+        if (layout.HasOverflow()) Fail("stock set overflowed", 7, dpi, width);
+        for (int i = 0; i < static_cast<int>(std::size(kStock)); i++) {
+            DlRect a = layout.Rect(i);
+            DlRect b = OldButtonRect(kStock, static_cast<int>(std::size(kStock)), i, dpi, width);
+            if (a.left != b.left || a.right != b.right || a.top != b.top || a.bottom != b.bottom)
+                Fail("stock button moved", 7, dpi, width);
+        }
+    }
+
+    printf("ExoUI toolbar layout benchmark: build once + binary-search hit test "
+           "vs per-call placement\n\n");
+    printf("%7s  %4s  %6s  %8s  %8s  %11s  %11s  %8s\n",
+        "buttons", "dpi", "width", "visible", "build us", "old hit ns", "new hit ns", "speedup");
+
+    for (int dpi : kDpis) {
+        for (int count : kCounts) {
+            auto buttons = Buttons(count);
+            for (int baseWidth : kWidths) {
+                float width = static_cast<float>(PaintScale(baseWidth, dpi));
+                float y = static_cast<float>(PaintScale(ToolbarPaint::BASE_HEIGHT, dpi)) / 2;
+
+                ToolbarLayout layout;
+                constexpr int kBuilds = 50;
+                auto t0 = Clock::now();
+                for (int r = 0; r < kBuilds; r++) layout.Build(buttons.data(), count, dpi, width);
+                auto t1 = Clock::now();
+                Check(buttons, layout, dpi, width);
+
+                // One mouse move per pixel column, as a sweep across the bar.
+                int columns = static_cast<int>(width);
+                long sink = 0;
+                auto t2 = Clock::now();
+                for (int x = 0; x < columns; x++)
+                    sink += OldHitTest(buttons.data(), count, dpi, width, static_cast<float>(x), y);
+                auto t3 = Clock::now();
+                constexpr int kRounds = 200;
+                for (int r = 0; r < kRounds; r++)
+                    for (int x = 0; x < columns; x++)
+                        sink += layout.HitTest(static_cast<float>(x), y);
+                auto t4 = Clock::now();
+                if (sink == 42) printf(" ");
+
+                int visible = 0;
+                for (int i = 0; i < count; i++) visible += layout.Visible(i);
+                double oldNs = Us(t2, t3) * 1000.0 / columns;
+                double newNs = Us(t3, t4) * 1000.0 / (static_cast<double>(columns) * kRounds);
+                printf("%7d  %4d  %6.0f  %8d  %8.2f  %11.1f  %11.1f  %7.0fx\n",
+                    count, dpi, width, visible, Us(t0, t1) / kBuilds, oldNs, newNs,
+                    newNs > 0 ? oldNs / newNs : 0.0);
+            }
+        }
+    }
+
+    return Finish();
+}
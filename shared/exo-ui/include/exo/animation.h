@@ -0,0 +1,97 @@
+#pragma once
+// ── ExoUI Animation Timeline ────────────────────────────────
+// One timeline advances every running tween per frame. Tweens update
+// their owner's state; each owner then gets a single OnAnimationFrame()
+// per frame to re-record and invalidate, however many of its tweens ran.
+// Portable: the clock is the caller's (milliseconds), and the Win32
+// driver that ticks it once per vblank lives in animator.h.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "export.h"
+
+namespace exo {
+
+enum class Easing : uint8_t {
+    Linear,
+    InQuad,
+    OutQuad,
+    InOutQuad,
+    OutCubic,
+    InOutCubic,
+};
+
+// Eased progress for `t` in [0, 1]; 0 and 1 map to themselves.
+EXOUI_API float Ease(Easing easing, float t);
+
+// Receives a frame after its tweens have updated.
+class EXOUI_API Animated {
+public:
+    virtual ~Animated() = default;
+    virtual void OnAnimationFrame() = 0;
+};
+
+using AnimationId = uint32_t;   // 0 is never a running tween
+
+struct FrameStats {
+    uint64_t frames;        // ticks that advanced at least one tween
+    uint64_t updates;       // tween updates delivered
+    uint64_t flushes;       // OnAnimationFrame calls
+    uint64_t longFrames;    // intervals over 1.5x the frame budget
+    double   intervalMs;    // sum of intervals between frames
+    double   maxIntervalMs;
+    double   tickUs;        // time spent inside Tick
+};
+
+class EXOUI_API Timeline {
+public:
+    using Update = std::function<void(float value)>;
+
+    // Tween from `from` to `to` over `durationMs` starting at `now`. The
+    // first update comes with the next Tick; the last delivers `to`
+    // exactly, then the tween is gone. Safe to call from an update.
+    AnimationId Start(Animated* owner, double now, float from, float to,
+                      double durationMs, Easing easing, Update update);
+    // Stops without a final update; false if it had already finished.
+    bool Cancel(AnimationId id);
+    // Drop every tween of `owner`, e.g. as its window is destroyed.
+    void CancelOwner(const Animated* owner);
+    bool Running(AnimationId id) const;
+
+    // Advance every tween to `now`, then flush each touched owner once.
+    // Returns whether anything is still running; when not, the driver
+    // can stop ticking altogether.
+    bool Tick(double now);
+    bool   Active() const { return !m_tweens.empty() || !m_started.empty(); }
+    size_t Count() const;
+
+    // Expected frame interval, for FrameStats::longFrames.
+    void SetFrameBudget(double ms) { m_budgetMs = ms; }
+    const FrameStats& Stats() const { return m_stats; }
+    void ResetStats() { m_stats = {}; }
+
+private:
+    struct Tween {
+        AnimationId id;
+        Animated*   owner;
+        double      start;
+        double      duration;
+        float       from;
+        float       to;
+        Easing      easing;
+        bool        cancelled;
+        Update      update;
+    };
+
+    std::vector<Tween>     m_tweens;
+    std::vector<Tween>     m_started;   // started during a Tick, merged after it
+    std::vector<Animated*> m_touched;
+    AnimationId m_nextId   = 1;
+    double      m_lastTick = -1;        // < 0 while idle
+    double      m_budgetMs = 1000.0 / 60.0;
+    bool        m_ticking  = false;
+    FrameStats  m_stats{};
+};
+
+} // namespace exo
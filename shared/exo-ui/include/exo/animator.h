@@ -0,0 +1,35 @@
+#pragma once
+// ── ExoUI Animator ──────────────────────────────────────────
+// The UI thread's animation clock: a shared Timeline ticked once per
+// display refresh. A worker waits on DwmFlush() and posts one tick at a
+// time to a message-only window, so ticks land between input and
+// WM_PAINT on the UI thread and never queue up behind a slow frame. With
+// nothing animating the worker blocks on an event: no timers, no wakeups.
+
+#include <windows.h>
+#include "animation.h"
+#include "export.h"
+
+namespace exo {
+
+class EXOUI_API Animator {
+public:
+    // Timeline::Start on the shared clock; starts the worker on first use.
+    // UI thread only, as are the other calls.
+    static AnimationId Start(Animated* owner, float from, float to,
+                             double durationMs, Easing easing, Timeline::Update update);
+    static bool Cancel(AnimationId id);
+    static void CancelOwner(const Animated* owner);
+    static bool Active();
+
+    // Milliseconds on the animation clock (QueryPerformanceCounter).
+    static double Now();
+
+    static FrameStats Stats();
+    static void ResetStats();
+
+    // Stop the worker; call before exit.
+    static void Shutdown();
+};
+
+} // namespace exo
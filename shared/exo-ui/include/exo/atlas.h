@@ -0,0 +1,92 @@
+#pragma once
+// ── ExoUI Mask Atlas ────────────────────────────────────────
+// Packs a control's icon masks into a few large pages, so it creates and
+// binds one bitmap where it used to make one per icon, and a size it has
+// shown before is still there when it comes back. Bookkeeping only: the
+// pages' pixels live wherever the backend keeps them (A8 D2D bitmaps in
+// IconAtlas, plain buffers in the benchmarks). Portable.
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "export.h"
+
+namespace exo {
+
+// Skyline bottom-left packing of rectangles into one fixed-size page:
+// the skyline is the top edge of everything placed so far, as segments
+// left to right, and each rectangle goes where its top ends lowest.
+class EXOUI_API SkylinePacker {
+public:
+    void Reset(int width, int height);
+    // Place a width×height rectangle; false if it doesn't fit.
+    bool Insert(int width, int height, int& x, int& y);
+
+    int      Width() const    { return m_width; }
+    int      Height() const   { return m_height; }
+    uint64_t UsedArea() const { return m_used; }
+
+private:
+    struct Segment {
+        int x, y, width;
+    };
+
+    int                  m_width  = 0;
+    int                  m_height = 0;
+    uint64_t             m_used   = 0;
+    std::vector<Segment> m_skyline;     // covers [0, m_width), ordered by x
+
+    bool Fit(size_t i, int width, int height, int& y) const;
+};
+
+// Where one square mask sits: its top-left pixel in `page`, inside a
+// transparent border of MaskAtlas::kPadding so scaled draws don't pick up
+// a neighbour.
+struct AtlasSlot {
+    int page;
+    int x;
+    int y;
+    int size;
+};
+
+// (icon, size) masks packed into pages of pageSize², at most maxPages of
+// them. Slots stay put until Clear(); once every page is full further
+// inserts fail.
+class EXOUI_API MaskAtlas {
+public:
+    static constexpr int kPadding  = 1;
+    static constexpr int kPageSize = 256;
+    static constexpr int kMaxPages = 4;
+
+    explicit MaskAtlas(int pageSize = kPageSize, int maxPages = kMaxPages);
+
+    int Find(int index, int size) const;        // slot or -1
+    // A new slot for the mask (Find() it first), or -1 if no page has room.
+    int Insert(int index, int size);
+    // Take back the last Insert(index, size), as when the backend can't
+    // create the page it opened. Every other slot keeps its number.
+    void RemoveLast(int index, int size);
+    const AtlasSlot& Slot(int slot) const { return m_slots[slot]; }
+
+    int      PageSize() const  { return m_pageSize; }
+    int      PageCount() const { return static_cast<int>(m_pages.size()); }
+    int      SlotCount() const { return static_cast<int>(m_slots.size()); }
+    uint64_t UsedArea() const;
+    // UsedArea() as a fraction of every page it may create.
+    float    Fill() const;
+    void     Clear();
+
+private:
+    int                                m_pageSize;
+    int                                m_maxPages;
+    std::vector<SkylinePacker>         m_pages;
+    std::vector<AtlasSlot>             m_slots;
+    std::unordered_map<uint32_t, int>  m_lookup;    // Key(index, size) -> slot
+
+    static uint32_t Key(int index, int size) {
+        return (static_cast<uint32_t>(index) << 16) | static_cast<uint32_t>(size & 0xFFFF);
+    }
+};
+
+} // namespace exo
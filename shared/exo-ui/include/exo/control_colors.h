@@ -0,0 +1,26 @@
+#pragma once
+// ── ExoUI Control Colors ────────────────────────────────────
+// The theme as the portable paint code sees it, shared by the Theme
+// system (which resolves it) and control_paint.h (which draws with it).
+
+#include <cstdint>
+
+namespace exo {
+
+// Theme colors as 0xAARRGGBB, see Theme::PaintColors().
+struct ControlColors {
+    uint32_t background;
+    uint32_t surface;
+    uint32_t surfaceHover;
+    uint32_t surfaceActive;
+    uint32_t toolbar;
+    uint32_t text;
+    uint32_t textSecondary;
+    uint32_t border;
+    uint32_t accent;
+    uint32_t statusBar;
+    uint32_t statusBarText;
+    uint32_t icon;
+};
+
+} // namespace exo
@@ -0,0 +1,274 @@
+#pragma once
+// ── ExoUI Control Painting ──────────────────────────────────
+// The layout and paint code of the built-in controls, free of Win32: a
+// control fills in its paint state and records a frame into a
+// DisplayList, which the control replays through D2D and benchmarks
+// replay on a SoftwareCanvas. Coordinates are pixels (the controls' D2D
+// targets run at 96 DPI and scale explicitly).
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../control_colors.h"
+#include "../display_list.h"
+#include "../export.h"
+
+namespace exo {
+
+// Dpi::Scale without MulDiv, for non-negative values.
+inline int PaintScale(int value, int dpi) { return (value * dpi + 48) / 96; }
+inline float PaintScaleF(float value, int dpi) { return value * static_cast<float>(dpi) / 96.0f; }
+
+// ── Sidebar ─────────────────────────────────────────────────
+
+struct SidebarItem {
+    const wchar_t* label;
+    const char*    iconName;
+};
+
+struct EXOUI_API SidebarPaint {
+    static constexpr int BASE_WIDTH       = 200;
+    static constexpr int BASE_ITEM_HEIGHT = 40;
+    static constexpr int BASE_PADDING_X   = 16;
+    static constexpr int BASE_FONT_SIZE   = 14;
+    static constexpr int BASE_HEADER_FONT = 11;
+    static constexpr int BASE_ICON_SIZE   = 18;
+
+    const SidebarItem* items     = nullptr;
+    int                count     = 0;
+    int                selected  = 0;
+    int                hovered   = -1;
+    float              hoverFade = 1.0f;    // hovered item's highlight, 0..1
+    int                fading    = -1;      // item whose highlight fades out
+    float              fadeOut   = 0.0f;
+    int                dpi       = 96;
+    float              width     = 0;
+    float              height    = 0;
+    ControlColors      colors{};
+
+    int    ItemHeight() const { return PaintScale(BASE_ITEM_HEIGHT, dpi); }
+    int    IconSize() const   { return PaintScale(BASE_ICON_SIZE, dpi); }
+    float  ItemsTop() const   { return PaintScaleF(44.0f, dpi); }
+    DlRect ItemRect(int i) const;
+    int    HitTest(float y) const;     // item index or -1
+
+    // Item i's icon is Mask image i.
+    void Record(DisplayList& out) const;
+};
+
+// ── Toolbar ─────────────────────────────────────────────────
+
+struct ToolbarButton {
+    uint16_t       id;
+    const wchar_t* label;
+    const char*    iconName;
+    int            baseWidth;
+    bool           toggle;
+    bool           rightAlign;
+};
+
+// Where every button sits for one (button set, width, DPI). Built once per
+// change of any of those and searched on every mouse move: visible slots
+// are kept in x order, so hit testing is a binary search. Left-aligned
+// buttons that would run into the right-aligned group overflow, in order,
+// into a menu behind a chevron slot.
+class EXOUI_API ToolbarLayout {
+public:
+    static constexpr int BASE_CHEVRON_WIDTH = 28;
+    static constexpr int kChevron           = -2;   // HitTest result for the chevron
+
+    void Build(const ToolbarButton* buttons, int count, int dpi, float width);
+
+    int    Count() const                { return static_cast<int>(m_rects.size()); }
+    bool   Visible(int idx) const       { return m_visible[idx] != 0; }
+    const  DlRect& Rect(int idx) const  { return m_rects[idx]; }    // empty when overflowed
+    bool   HasOverflow() const          { return !m_overflow.empty(); }
+    const  DlRect& ChevronRect() const  { return m_chevron; }
+    const  std::vector<int>& Overflow() const { return m_overflow; }   // button indices
+
+    // Button index, kChevron or -1.
+    int HitTest(float x, float y) const;
+
+private:
+    struct Slot {
+        float left, right;
+        int   index;        // button index or kChevron
+    };
+
+    std::vector<DlRect>  m_rects;
+    std::vector<uint8_t> m_visible;
+    std::vector<int>     m_overflow;
+    std::vector<Slot>    m_slots;      // sorted by left, non-overlapping
+    DlRect               m_chevron{};
+    float                m_top    = 0;
+    float                m_bottom = 0;
+};
+
+struct EXOUI_API ToolbarPaint {
+    static constexpr int BASE_HEIGHT    = 40;
+    static constexpr int BASE_FONT_SIZE = 13;
+    static constexpr int BASE_ICON_SIZE = 16;
+
+    const ToolbarButton* buttons  = nullptr;
+    int                  count    = 0;
+    const ToolbarLayout* layout   = nullptr;    // built for buttons, dpi and width
+    uint16_t             activeId = 0;          // checked toggle button
+    int                  hovered  = -1;         // button index or ToolbarLayout::kChevron
+    int                  dpi      = 96;
+    float                width    = 0;
+    float                height   = 0;
+    ControlColors        colors{};
+
+    int IconSize() const { return PaintScale(BASE_ICON_SIZE, dpi); }
+
+    // Buttons without a label show their icon, as Mask image i for button i.
+    void Record(DisplayList& out) const;
+};
+
+// ── Status bar ──────────────────────────────────────────────
+
+struct EXOUI_API StatusBarPaint {
+    static constexpr int BASE_HEIGHT    = 24;
+    static constexpr int BASE_FONT_SIZE = 12;
+    static constexpr int BASE_PADDING_X = 10;
+
+    std::wstring_view text;
+    int               dpi    = 96;
+    float             width  = 0;
+    float             height = 0;
+    ControlColors     colors{};
+
+    void Record(DisplayList& out) const;
+};
+
+// ── Profiler overlay ────────────────────────────────────────
+
+struct EXOUI_API ProfilerPaint {
+    static constexpr int BASE_WIDTH       = 780;
+    static constexpr int BASE_LINE_HEIGHT = 15;
+    static constexpr int BASE_FONT_SIZE   = 11;
+    static constexpr int BASE_PADDING     = 8;
+
+    const std::wstring* lines  = nullptr;
+    int                 count  = 0;
+    int                 dpi    = 96;
+    float               width  = 0;
+    float               height = 0;
+    ControlColors       colors{};
+
+    // Panel height that fits `count` lines.
+    static int HeightFor(int count, int dpi);
+
+    // One Text command per line, so a refresh repaints only the lines
+    // whose numbers changed.
+    void Record(DisplayList& out) const;
+};
+
+// ── Item view ───────────────────────────────────────────────
+
+enum class ItemViewMode : uint8_t {
+    LargeIcons,
+    SmallIcons,
+    List,           // column-major, scrolls sideways
+    Details,
+};
+
+// What an ItemView shows. The view only asks about items in view, so a
+// model may front any indexable store; it must not change under the view
+// without a call to ItemView::ModelChanged().
+class ItemModel {
+public:
+    virtual ~ItemModel() = default;
+    virtual int               Count() const = 0;
+    virtual std::wstring_view Label(int item) const = 0;
+    // Details column `column` (1-based; column 0 is the label).
+    virtual std::wstring_view Detail(int item, int column) const { (void)item; (void)column; return {}; }
+    // Mask image for the item's icon, or -1.
+    virtual int               Icon(int item) const { (void)item; return -1; }
+};
+
+struct ItemColumn {
+    const wchar_t* title;
+    int            baseWidth;
+};
+
+// Where items sit for one (mode, count, DPI, viewport). Cells are uniform,
+// so every query is arithmetic on the cell grid: nothing is stored per
+// item, and a view of 100k items costs what one of 100 does. Positions
+// are in view pixels for a scroll offset along the scroll axis.
+class EXOUI_API ItemViewLayout {
+public:
+    void Build(ItemViewMode mode, int count, int dpi, float width, float height,
+               const ItemColumn* columns, int columnCount);
+
+    ItemViewMode Mode() const      { return m_mode; }
+    int   Count() const            { return m_count; }
+    bool  Horizontal() const       { return m_mode == ItemViewMode::List; }
+    int   IconSize() const         { return m_iconSize; }
+    // What IconSize() would be after Build(mode, ..., dpi, ...).
+    static int IconSizeFor(ItemViewMode mode, int dpi);
+    float HeaderHeight() const     { return m_header; }
+    float CellWidth() const        { return m_cellW; }
+    float CellHeight() const       { return m_cellH; }
+    int   PerLine() const          { return m_perLine; }   // items per row (per column in List)
+    float Extent() const;          // content length along the scroll axis
+    float Viewport() const;        // visible length along the scroll axis
+    float LineLength() const       { return Horizontal() ? m_cellW : m_cellH; }
+    float ClampScroll(float scroll) const;
+
+    // Items overlapping the viewport, as [first, last).
+    void   Visible(float scroll, int& first, int& last) const;
+    DlRect ItemRect(int item, float scroll) const;
+    int    HitTest(float x, float y, float scroll) const;     // item or -1
+    // Nearest scroll that shows all of `item`.
+    float  ScrollToShow(int item, float scroll) const;
+
+    // The item at the viewport's leading edge, and how far into its line
+    // the edge sits (as a fraction, so it survives a change of cell size).
+    struct Anchor {
+        int   item;
+        float offset;
+    };
+    Anchor AnchorAt(float scroll) const;
+    float  ScrollFor(const Anchor& anchor) const;
+
+private:
+    ItemViewMode m_mode     = ItemViewMode::LargeIcons;
+    int          m_count    = 0;
+    float        m_width    = 0;
+    float        m_height   = 0;
+    float        m_cellW    = 0;
+    float        m_cellH    = 0;
+    float        m_pad      = 0;
+    float        m_header   = 0;
+    float        m_rowWidth = 0;    // Details
+    int          m_iconSize = 0;
+    int          m_perLine  = 1;    // items per row, or per column in List
+    int          m_lines    = 0;
+
+    float Start() const;            // content offset of line 0
+};
+
+struct EXOUI_API ItemViewPaint {
+    static constexpr int BASE_FONT_SIZE   = 13;
+    static constexpr int BASE_HEADER_FONT = 12;
+
+    const ItemModel*      model       = nullptr;
+    const ItemViewLayout* layout      = nullptr;
+    const ItemColumn*     columns     = nullptr;    // Details
+    int                   columnCount = 0;
+    float                 scroll      = 0;
+    int                   selected    = -1;
+    int                   hovered     = -1;
+    int                   dpi         = 96;
+    float                 width       = 0;
+    float                 height      = 0;
+    ControlColors         colors{};
+
+    // Records the items in view only; icons are Mask images from
+    // ItemModel::Icon.
+    void Record(DisplayList& out) const;
+};
+
+} // namespace exo
@@ -0,0 +1,122 @@
+#pragma once
+// ── ExoUI Item View Control ─────────────────────────────────
+// Owner-drawn, virtualized replacement for a list view: items come from an
+// ItemModel on demand and only the ones in view are recorded and drawn,
+// so painting and scrolling cost the same at 100 items or 100k.
+
+#include <windows.h>
+#include <wrl/client.h>
+#include <d2d1.h>
+#include <vector>
+#include "../export.h"
+#include "../dpi.h"
+#include "../theme.h"
+#include "../render.h"
+#include "../icons.h"
+#include "../icon_service.h"
+#include "../icon_atlas.h"
+#include "../display_list.h"
+#include "control_paint.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace exo {
+
+// HIWORD(wParam) of the WM_COMMAND an ItemView sends its parent; read the
+// item with Selected().
+enum ItemViewNotify : WORD {
+    IVN_SELCHANGE = 1,
+    IVN_ACTIVATE  = 2,      // double-click
+};
+
+class EXOUI_API ItemView : public IconClient {
+public:
+    void Create(HWND parent, HINSTANCE hInst, int id);
+    HWND Handle() const;
+    void Resize(int x, int y, int w, int h);
+    void Repaint();
+    void UpdateDpi(int dpi);
+    // Have the icon service render the icons shown so far or in view, and
+    // from now on each newly shown one, at the current mode's size for
+    // each DPI (see Dpi::MonitorDpis). An empty list stops prewarming.
+    void PrewarmDpis(const int* dpis, int count);
+
+    // `model` must outlive the view, or be replaced first; nullptr shows
+    // nothing. Scroll and selection reset.
+    void SetModel(const ItemModel* model);
+    // The model's items changed (a filter, a refresh). The item at the
+    // leading edge stays put; the selection is dropped if out of range.
+    void ModelChanged();
+
+    // Switching modes keeps the leading item in view.
+    void SetMode(ItemViewMode mode);
+    ItemViewMode Mode() const;
+    // Details columns; `columns` must outlive the view.
+    void SetColumns(const ItemColumn* columns, int count);
+
+    int  Selected() const;
+    void Select(int item);
+    void EnsureVisible(int item);
+
+    const ItemViewLayout& Layout() const;
+    PaintSnapshot GetPaintStats() const;
+    void ResetPaintStats();
+    const IconAtlasStats& GetAtlasStats() const;
+
+private:
+    // Room for a few hundred icons at Large Icons size; a model drawing
+    // on a whole icon pack may show more than one control's worth.
+    static constexpr int   ATLAS_PAGE_SIZE = 1024;
+    // Past this an icon-size change drops the old sizes instead of keeping
+    // them as placeholders.
+    static constexpr float ATLAS_TRIM_FILL = 0.5f;
+    // Screens of labels kept shaped: scrolling back is free, scrolling
+    // through 100k items doesn't keep them all.
+    static constexpr int   LABEL_SCREENS = 4;
+
+    HWND  m_hwnd     = nullptr;
+    HWND  m_parent   = nullptr;
+    int   m_dpi      = 96;
+    int   m_selected = -1;
+    int   m_hovered  = -1;
+    float m_scroll   = 0;
+    ItemViewMode      m_mode        = ItemViewMode::LargeIcons;
+    const ItemModel*  m_model       = nullptr;
+    const ItemColumn* m_columns     = nullptr;
+    int               m_columnCount = 0;
+    ItemViewLayout    m_layout;
+    ComPtr<ID2D1HwndRenderTarget> m_rt;
+    BrushCache m_brushes;
+    LabelCache m_labels;
+    PaintRecorder m_paintStats;
+
+    // Atlas slots by Lucide index, filled from the IconService as items
+    // scroll into view. After a size change the old masks are drawn scaled
+    // until their replacements arrive; switching back finds them still in
+    // the atlas.
+    IconAtlas            m_atlas{ ATLAS_PAGE_SIZE };
+    std::vector<int>     m_maskSlots;
+    std::vector<uint8_t> m_maskTried;
+    int                  m_maskSize = 0;
+    std::vector<int>     m_prewarmDpis;
+    std::vector<int>     m_fresh;       // scratch: newly requested icons
+
+    RetainedFrame m_frame;      // recorded from PaintState()
+
+    void CreateRenderTarget();
+    void Relayout(bool keepAnchor);
+    void ScrollTo(float scroll);
+    void UpdateScrollBar();
+    void OnScroll(int bar, int code);
+    void EnsureMasks();
+    void EvictMasks();
+    void Prewarm(const std::vector<int>& indices);
+    void OnIconReady(int index, int size, const IconRaster* mask) override;
+    ItemViewPaint PaintState() const;
+    void OnPaint(DirtyRegion& dirty);
+    void Notify(WORD code);
+
+    static LRESULT CALLBACK ItemViewProc(HWND, UINT, WPARAM, LPARAM);
+};
+
+} // namespace exo
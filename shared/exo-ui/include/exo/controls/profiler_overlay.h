@@ -0,0 +1,60 @@
+#pragma once
+// ── ExoUI Profiler Overlay ──────────────────────────────────
+// A translucent, click-through panel of ProfileReport lines, owned by an
+// app window and pinned over the top-right corner of one of its children.
+// It is a layered popup rather than a child so it always stays above the
+// sibling it covers. Hidden until Show(true).
+
+#include <windows.h>
+#include <wrl/client.h>
+#include <d2d1.h>
+#include <string>
+#include <vector>
+#include "../export.h"
+#include "../dpi.h"
+#include "../theme.h"
+#include "../render.h"
+#include "../display_list.h"
+#include "control_paint.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace exo {
+
+class EXOUI_API ProfilerOverlay {
+public:
+    static constexpr BYTE OPACITY   = 230;
+    static constexpr int  BASE_GAP  = 12;     // from the anchor's edges
+
+    void Create(HWND owner, HINSTANCE hInst);
+    HWND Handle() const;
+    bool Visible() const;
+    void Show(bool show);
+    // Moves the panel to the top-right corner of `anchor`; call again when
+    // the anchor moves or resizes.
+    void Place(HWND anchor);
+    void SetLines(const std::vector<std::string>& lines);
+
+    PaintSnapshot GetPaintStats() const;
+    void ResetPaintStats();
+
+private:
+    HWND m_hwnd    = nullptr;
+    HWND m_anchor  = nullptr;
+    int  m_dpi     = 96;
+    std::vector<std::wstring> m_lines;
+    ComPtr<ID2D1HwndRenderTarget> m_rt;
+    BrushCache m_brushes;
+    LabelCache m_labels;
+
+    RetainedFrame       m_frame;            // recorded from PaintState()
+    PaintRecorder       m_paintStats;
+
+    void Reposition();
+    ProfilerPaint PaintState() const;
+    void Repaint();
+    void OnPaint(DirtyRegion& dirty);
+    static LRESULT CALLBACK OverlayProc(HWND, UINT, WPARAM, LPARAM);
+};
+
+} // namespace exo
@@ -4,21 +4,22 @@
 #include <windows.h>
 #include <wrl/client.h>
 #include <d2d1.h>
+#include <vector>
 #include "../export.h"
 #include "../dpi.h"
 #include "../theme.h"
 #include "../render.h"
 #include "../icons.h"
+#include "../animator.h"
+#include "../icon_service.h"
+#include "../icon_atlas.h"
+#include "../display_list.h"
+#include "control_paint.h"
 
 using Microsoft::WRL::ComPtr;
 
 namespace exo {
 
-struct SidebarItem {
-    const wchar_t* label;
-    const char*    iconName;
-};
-
 inline constexpr SidebarItem kCategories[] = {
     { L"All",        "view-list"  },
     { L"System",     "system"     },
@@ -29,14 +30,15 @@ inline constexpr SidebarItem kCategories[] = {
 };
 inline constexpr int kCategoryCount = _countof(kCategories);
 
-class EXOUI_API Sidebar {
+class EXOUI_API Sidebar : public Animated, public IconClient {
 public:
-    static constexpr int BASE_WIDTH       = 200;
-    static constexpr int BASE_ITEM_HEIGHT = 40;
-    static constexpr int BASE_PADDING_X   = 16;
-    static constexpr int BASE_FONT_SIZE   = 14;
-    static constexpr int BASE_HEADER_FONT = 11;
-    static constexpr int BASE_ICON_SIZE   = 18;
+    static constexpr int BASE_WIDTH       = SidebarPaint::BASE_WIDTH;
+    static constexpr int BASE_ITEM_HEIGHT = SidebarPaint::BASE_ITEM_HEIGHT;
+    static constexpr int BASE_PADDING_X   = SidebarPaint::BASE_PADDING_X;
+    static constexpr int BASE_FONT_SIZE   = SidebarPaint::BASE_FONT_SIZE;
+    static constexpr int BASE_HEADER_FONT = SidebarPaint::BASE_HEADER_FONT;
+    static constexpr int BASE_ICON_SIZE   = SidebarPaint::BASE_ICON_SIZE;
+    static constexpr double HOVER_FADE_MS = 120;
 
     int ScaledWidth() const;
     void Create(HWND parent, HINSTANCE hInst, int id);
@@ -45,6 +47,18 @@ public:
     void Resize(int x, int y, int w, int h);
     void Repaint();
     void UpdateDpi(int dpi);
+    // Have the icon service render this sidebar's icons for each DPI in
+    // the background, so moving to a monitor at one of them is a cache
+    // lookup (see Dpi::MonitorDpis).
+    void PrewarmDpis(const int* dpis, int count);
+
+    // Replace the item list (kCategories by default); `items` must outlive
+    // the sidebar. Selection returns to the first item.
+    void SetItems(const SidebarItem* items, int count);
+
+    PaintSnapshot GetPaintStats() const;
+    void ResetPaintStats();
+    const IconAtlasStats& GetAtlasStats() const;
 
 private:
     HWND m_hwnd     = nullptr;
@@ -52,18 +66,36 @@ private:
     int  m_selected = 0;
     int  m_hovered  = -1;
     int  m_dpi      = 96;
+    // Hover highlight fades: the hovered item's in, the previous one's out.
+    float       m_hoverFade   = 1.0f;
+    int         m_fading      = -1;
+    float       m_fadeOut     = 0.0f;
+    AnimationId m_fadeInAnim  = 0;
+    AnimationId m_fadeOutAnim = 0;
     ComPtr<ID2D1HwndRenderTarget> m_rt;
-    ComPtr<ID2D1Bitmap> m_iconBitmaps[kCategoryCount];
+    BrushCache m_brushes;
+    LabelCache m_labels;
+    const SidebarItem* m_items     = kCategories;
+    int                m_itemCount = kCategoryCount;
+    IconAtlas        m_atlas;           // A8 coverage, tinted at draw
+    std::vector<int> m_iconSlots;       // per item; -1 until its mask is in
+    std::vector<int> m_iconIndex;
+    bool     m_iconsResolved   = false;
     int      m_cachedIconSize  = 0;
-    uint32_t m_cachedIconColor = 0;
+    PaintRecorder m_paintStats;
+
+    RetainedFrame m_frame;      // recorded from PaintState()
 
-    int ItemHeight() const;
-    int PaddingX() const;
     int IconSize() const;
     void CreateRenderTarget();
     void RebuildIconCache();
-    void OnPaint();
-    int  HitTest(int y);
+    void ResolveIcons();
+    SidebarPaint PaintState() const;
+    void OnPaint(DirtyRegion& dirty);
+    int  HitTest(int y) const;
+    void SetHovered(int idx);
+    void OnAnimationFrame() override;
+    void OnIconReady(int index, int size, const IconRaster* mask) override;
 
     static LRESULT CALLBACK SidebarProc(HWND, UINT, WPARAM, LPARAM);
 };
@@ -5,10 +5,13 @@
 #include <wrl/client.h>
 #include <d2d1.h>
 #include <string>
+#include <vector>
 #include "../export.h"
 #include "../dpi.h"
 #include "../theme.h"
 #include "../render.h"
+#include "../display_list.h"
+#include "control_paint.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -16,9 +19,9 @@ namespace exo {
 
 class EXOUI_API StatusBar {
 public:
-    static constexpr int BASE_HEIGHT    = 24;
-    static constexpr int BASE_FONT_SIZE = 12;
-    static constexpr int BASE_PADDING_X = 10;
+    static constexpr int BASE_HEIGHT    = StatusBarPaint::BASE_HEIGHT;
+    static constexpr int BASE_FONT_SIZE = StatusBarPaint::BASE_FONT_SIZE;
+    static constexpr int BASE_PADDING_X = StatusBarPaint::BASE_PADDING_X;
 
     int ScaledHeight() const;
     void Create(HWND parent, HINSTANCE hInst, int id);
@@ -28,14 +31,23 @@ public:
     void Repaint();
     void UpdateDpi(int dpi);
 
+    PaintSnapshot GetPaintStats() const;
+    void ResetPaintStats();
+
 private:
     HWND m_hwnd     = nullptr;
     HWND m_parent   = nullptr;
     int  m_dpi      = 96;
     std::wstring m_text = L"Ready";
     ComPtr<ID2D1HwndRenderTarget> m_rt;
+    BrushCache m_brushes;
+    LabelCache m_labels;
+
+    RetainedFrame       m_frame;            // recorded from PaintState()
+    PaintRecorder       m_paintStats;
 
-    void OnPaint();
+    StatusBarPaint PaintState() const;
+    void OnPaint(DirtyRegion& dirty);
     static LRESULT CALLBACK StatusProc(HWND, UINT, WPARAM, LPARAM);
 };
 
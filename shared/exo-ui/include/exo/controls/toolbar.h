@@ -4,10 +4,16 @@
 #include <windows.h>
 #include <wrl/client.h>
 #include <d2d1.h>
+#include <vector>
 #include "../export.h"
 #include "../dpi.h"
 #include "../theme.h"
 #include "../render.h"
+#include "../icons.h"
+#include "../icon_service.h"
+#include "../icon_atlas.h"
+#include "../display_list.h"
+#include "control_paint.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -23,11 +29,11 @@ enum ToolbarCmd : WORD {
     IDC_TB_THEME        = 1030,
 };
 
-class EXOUI_API Toolbar {
+class EXOUI_API Toolbar : public IconClient {
 public:
-    static constexpr int BASE_HEIGHT    = 40;
-    static constexpr int BASE_FONT_SIZE = 13;
-    static constexpr int BASE_ICON_SIZE = 16;
+    static constexpr int BASE_HEIGHT    = ToolbarPaint::BASE_HEIGHT;
+    static constexpr int BASE_FONT_SIZE = ToolbarPaint::BASE_FONT_SIZE;
+    static constexpr int BASE_ICON_SIZE = ToolbarPaint::BASE_ICON_SIZE;
 
     int ScaledHeight() const;
     void Create(HWND parent, HINSTANCE hInst, int id);
@@ -35,16 +41,24 @@ public:
     void Resize(int x, int y, int w, int h);
     void Repaint();
     void UpdateDpi(int dpi);
+    // Have the icon service render the icon buttons' icons for each DPI
+    // in the background (see Dpi::MonitorDpis).
+    void PrewarmDpis(const int* dpis, int count);
+
+    // Buttons from extensions. Left-aligned ones join the end of the left
+    // group, right-aligned ones the outer end of the right group; strings
+    // must outlive the toolbar. Clicks arrive as WM_COMMAND with the id.
+    void AddButton(const ToolbarButton& button);
+    bool RemoveButton(uint16_t id);
+
+    const ToolbarLayout& Layout() const;
+
+    PaintSnapshot GetPaintStats() const;
+    void ResetPaintStats();
+    const IconAtlasStats& GetAtlasStats() const;
 
 private:
-    struct Button {
-        WORD            id;
-        const wchar_t*  label;
-        const char*     iconName;
-        int             baseWidth;
-        bool            toggle;
-        bool            rightAlign;
-    };
+    using Button = ToolbarButton;
 
     static constexpr Button kButtons[] = {
         { IDC_TB_VIEW_LARGE,   L"Large",   "view-large-icons",  52, true,  false },
@@ -55,23 +69,39 @@ private:
         { IDC_TB_SETTINGS,     L"",        "settings",           36, false, true  },
         { IDC_TB_THEME,        L"",        "theme-dark",         36, false, true  },
     };
-    static constexpr int kButtonCount = _countof(kButtons);
 
     HWND  m_hwnd       = nullptr;
     HWND  m_parent     = nullptr;
     WORD  m_activeView = IDC_TB_VIEW_LARGE;
     int   m_hovered    = -1;
     int   m_dpi        = 96;
+    std::vector<Button> m_buttons{ std::begin(kButtons), std::end(kButtons) };
+    ToolbarLayout       m_layout;
     ComPtr<ID2D1HwndRenderTarget> m_rt;
+    BrushCache m_brushes;
+    LabelCache m_labels;
+    PaintRecorder m_paintStats;
+
+    // Icons of label-less buttons, by button index; -1 until the mask is
+    // in the atlas.
+    IconAtlas        m_atlas;
+    std::vector<int> m_iconIndex;
+    std::vector<int> m_iconSlots;
+    bool             m_iconsResolved  = false;
+    int              m_cachedIconSize = 0;
+
+    RetainedFrame m_frame;      // recorded from PaintState()
 
-    int BtnWidth(int idx) const;
-    int Pad() const;
-    int Margin() const;
-    int Height() const;
     void CreateRenderTarget();
-    D2D1_RECT_F ButtonRect(int idx, float totalWidth) const;
-    int HitTest(int mx, int my, float totalWidth);
-    void OnPaint();
+    void UpdateLayout();
+    void ResolveIcons();
+    void RebuildIconCache();
+    void OnIconReady(int index, int size, const IconRaster* mask) override;
+    void Click(int idx);
+    void ShowOverflowMenu();
+    ToolbarPaint PaintState() const;
+    int HitTest(int mx, int my) const;
+    void OnPaint(DirtyRegion& dirty);
 
     static LRESULT CALLBACK ToolbarProc(HWND, UINT, WPARAM, LPARAM);
 };
@@ -0,0 +1,104 @@
+#pragma once
+// ── ExoUI Display List ──────────────────────────────────────
+// Retained drawing commands. Controls record what a frame looks like into
+// a DisplayList when their state changes and replay it on WM_PAINT, so an
+// unchanged state never re-records, and two recordings can be diffed into
+// the areas that actually need repainting. Portable: the D2D backend
+// lives in render.h, the CPU backend in soft_canvas.h.
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "export.h"
+
+namespace exo {
+
+struct DlRect {
+    float left, top, right, bottom;
+
+    bool Intersects(const DlRect& r) const {
+        return left < r.right && r.left < right && top < r.bottom && r.top < bottom;
+    }
+};
+
+enum class DlAlign : uint8_t {
+    Leading,
+    Center,
+    Trailing,
+};
+
+// Text runs are vertically centered in their box, like the text formats
+// from RenderContext::TextFormat.
+struct DlFont {
+    std::wstring family;
+    float        size;
+    int          weight;    // DWRITE_FONT_WEIGHT
+    DlAlign      align;
+
+    bool operator==(const DlFont&) const = default;
+};
+
+enum class DlOp : uint8_t {
+    FillRect,
+    FillRoundedRect,
+    StrokeRoundedRect,
+    Line,               // rect.left/top to rect.right/bottom
+    Mask,               // tint a caller-supplied A8 image into rect
+    Text,
+};
+
+struct DlCommand {
+    DlOp     op;
+    uint8_t  font;      // Text: index into Fonts()
+    uint16_t image;     // Mask: index into the images handed to the backend
+    uint32_t color;     // 0xAARRGGBB, straight alpha
+    DlRect   rect;
+    float    radius;    // rounded rects
+    float    width;     // strokes and lines
+    uint32_t text;      // Text: offset into the text pool
+    uint32_t length;    // Text: characters
+};
+
+class EXOUI_API DisplayList {
+public:
+    void Clear();
+
+    void FillRect(const DlRect& r, uint32_t color);
+    void FillRoundedRect(const DlRect& r, float radius, uint32_t color);
+    void StrokeRoundedRect(const DlRect& r, float radius, float width, uint32_t color);
+    void Line(float x0, float y0, float x1, float y1, float width, uint32_t color);
+    void Mask(const DlRect& r, int image, uint32_t color);
+    void Text(const DlRect& r, std::wstring_view text, int font, uint32_t color);
+
+    // Index of `font` in this list, added on first use.
+    int Font(std::wstring_view family, float size, int weight, DlAlign align);
+
+    const std::vector<DlCommand>& Commands() const { return m_commands; }
+    const DlFont&    FontAt(int i) const { return m_fonts[i]; }
+    std::wstring_view TextOf(const DlCommand& c) const {
+        return std::wstring_view(m_text).substr(c.text, c.length);
+    }
+
+    // Area a command can touch, including stroke width and antialiasing.
+    static DlRect Bounds(const DlCommand& c);
+
+    bool operator==(const DisplayList& other) const;
+
+    // Areas that differ between `before` and `after`, appended to `out`:
+    // the bounds of every command that changed or, when commands were
+    // inserted or removed, the span between the common prefix and suffix.
+    // Empty when the frames match.
+    static void Diff(const DisplayList& before, const DisplayList& after,
+                     std::vector<DlRect>& out);
+
+private:
+    std::vector<DlCommand> m_commands;
+    std::vector<DlFont>    m_fonts;
+    std::wstring           m_text;
+
+    DlCommand& Push(DlOp op, const DlRect& r, uint32_t color);
+    static bool SameAt(const DisplayList& a, size_t i, const DisplayList& b, size_t j);
+};
+
+} // namespace exo
@@ -17,6 +17,9 @@ public:
     static float ScaleF(float value, int dpi) {
         return value * static_cast<float>(dpi) / 96.0f;
     }
+    // Distinct effective DPIs of the connected monitors, ascending; writes
+    // at most `max` and returns how many. Call again on WM_DISPLAYCHANGE.
+    static int MonitorDpis(int* out, int max);
 };
 
 } // namespace exo
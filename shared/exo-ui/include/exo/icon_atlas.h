@@ -0,0 +1,57 @@
+#pragma once
+// ── ExoUI Icon Atlas ────────────────────────────────────────
+// A control's icon masks as sub-rectangles of a few A8 D2D bitmaps (see
+// MaskAtlas). One bitmap serves every icon the control draws, so Replay
+// binds the same source from one icon to the next, and a mask is uploaded
+// once per render target however many items show it or how often the
+// control returns to its size.
+
+#include <windows.h>
+#include <d2d1.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <vector>
+#include "atlas.h"
+#include "export.h"
+#include "icons.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace exo {
+
+struct IconAtlasStats {
+    uint64_t pages;         // bitmaps created
+    uint64_t uploads;       // masks copied into a page
+    uint64_t uploadBytes;   // including each mask's transparent border
+    uint64_t reused;        // Add() calls for a mask already in the atlas
+    uint64_t full;          // masks dropped for lack of room
+};
+
+// Belongs to one render target, like the bitmaps in it: Reset() when the
+// target is replaced, and forget every slot handed out.
+class EXOUI_API IconAtlas {
+public:
+    explicit IconAtlas(int pageSize = MaskAtlas::kPageSize, int maxPages = MaskAtlas::kMaxPages);
+
+    int Find(int index, int size) const { return m_layout.Find(index, size); }
+    // Upload `mask` (size×size coverage) for (index, size) unless it is
+    // already in; returns its slot, or -1 if it could not be placed.
+    int Add(ID2D1RenderTarget* rt, int index, int size, const IconRaster& mask);
+
+    const AtlasSlot& Slot(int slot) const { return m_layout.Slot(slot); }
+    ID2D1Bitmap*     Page(int page) const { return m_pages[page].Get(); }
+    float            Fill() const         { return m_layout.Fill(); }
+    // Slot's pixels in its page, in DIPs (pages are 96 DPI).
+    D2D1_RECT_F      Source(int slot) const;
+
+    void Reset();
+    const IconAtlasStats& Stats() const { return m_stats; }
+
+private:
+    MaskAtlas                        m_layout;
+    std::vector<ComPtr<ID2D1Bitmap>> m_pages;
+    std::vector<uint8_t>             m_scratch;     // mask plus border, for one upload
+    IconAtlasStats                   m_stats{};
+};
+
+} // namespace exo
@@ -0,0 +1,57 @@
+#pragma once
+// ── ExoUI Icon Service ──────────────────────────────────────
+// Rasterizes icon masks on worker threads so WM_PAINT never waits on
+// Lucide. A control asks for the (icon, size) masks it needs and keeps
+// painting with what it has, typically the previous size's bitmaps
+// scaled, or nothing; each finished mask comes back on the UI thread
+// through IconClient::OnIconReady, where the control uploads it and
+// invalidates just the rectangles that show it. Sizes other monitors will
+// want can be prewarmed while idle, so a DPI change finds its masks
+// already in Lucide's cache.
+
+#include <windows.h>
+#include <cstdint>
+#include "export.h"
+#include "icons.h"
+
+namespace exo {
+
+class EXOUI_API IconClient {
+public:
+    virtual ~IconClient() = default;
+    // UI thread. `mask` (stride == size) is only valid during the call;
+    // it is nullptr if the icon could not be rendered.
+    virtual void OnIconReady(int index, int size, const IconRaster* mask) = 0;
+};
+
+struct IconServiceStats {
+    uint64_t requests;      // accepted, after de-duplication
+    uint64_t delivered;
+    uint64_t cancelled;     // dropped before delivery
+    uint64_t maxQueued;
+    uint64_t rasterUs;      // worker time spent in Lucide
+    uint64_t cacheHits;     // requests answered from the cache on the spot
+    uint64_t prewarmed;     // masks rendered ahead of need
+};
+
+class EXOUI_API IconService {
+public:
+    // A mask already in Lucide's cache is returned right away (release it
+    // with LucideIcons::Release) and nothing is queued. Otherwise returns
+    // nullptr and queues it; a request already pending for the same
+    // client, icon and size is not queued twice. UI thread; starts the
+    // workers on first use.
+    static const IconRaster* RequestMask(IconClient* client, int index, int size);
+    // Render masks into Lucide's cache without delivering them. Runs only
+    // when no RequestMask work is waiting. UI thread.
+    static void Prewarm(const int* indices, int count, int size);
+    // Forget every pending and in-flight request of `client`; nothing is
+    // delivered to it afterwards. Call before it is destroyed.
+    static void Cancel(const IconClient* client);
+
+    static IconServiceStats Stats();
+    // Stop the workers; call before exit.
+    static void Shutdown();
+};
+
+} // namespace exo
@@ -7,28 +7,80 @@
 
 namespace exo {
 
+// Layout-compatible with LucideRaster / LucideCacheStats in lucide.h.
+struct IconRaster {
+    const uint8_t* pixels;   // premultiplied RGBA, or 8-bit coverage for masks
+    int            size;
+    int            stride;
+};
+
+struct IconCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytesInUse;
+    uint64_t budgetBytes;
+    uint64_t diskHits;
+    uint64_t diskWrites;
+};
+
 class EXOUI_API LucideIcons {
 public:
     static bool Load();
     static int GetCount();
     static const char* GetName(int idx);
+    static int Find(const char* name);      // -1 if unknown; resolve once, render by index
+    // Map an icon pack file; returns the index of its first icon or -1.
+    static int LoadPack(const wchar_t* path);
     static uint8_t* Render(const char* name, int size, uint32_t color);
     static void Free(void* ptr);
     static HBITMAP CreateBitmap(const char* name, int size, uint32_t color);
 
+    // Borrow a cached raster from Lucide.dll; pair with Release().
+    static const IconRaster* Acquire(const char* name, int size, uint32_t color);
+    static const IconRaster* Acquire(int index, int size, uint32_t color);
+    // Borrow a color-independent coverage mask (stride == size); tint it at
+    // draw time. Pair with Release().
+    static const IconRaster* AcquireMask(int index, int size);
+    // AcquireMask() only if the mask is already cached; never renders, so
+    // it is safe on the UI thread. nullptr on a miss or an older DLL.
+    static const IconRaster* PeekMask(int index, int size);
+    static void Release(const IconRaster* raster);
+    static void SetCacheBudget(size_t bytes);
+    static IconCacheStats CacheStats();
+
 private:
     using FnGetCount  = int(*)();
     using FnGetName   = const char*(*)(int);
+    using FnFind      = int(*)(const char*);
+    using FnLoadPack  = int(*)(const wchar_t*);
     using FnRender    = uint8_t*(*)(const char*, int, uint32_t);
     using FnFree      = void(*)(void*);
     using FnCreateBmp = void*(*)(const char*, int, uint32_t);
+    using FnAcquire   = const IconRaster*(*)(const char*, int, uint32_t);
+    using FnAcquireIx = const IconRaster*(*)(int, int, uint32_t);
+    using FnAcqMask   = const IconRaster*(*)(int, int);
+    using FnPeekMask  = const IconRaster*(*)(int, int);
+    using FnRelease   = void(*)(const IconRaster*);
+    using FnSetBudget = void(*)(size_t);
+    using FnGetStats  = void(*)(IconCacheStats*);
 
     static HMODULE s_dll;
     static FnGetCount  s_getCount;
     static FnGetName   s_getName;
+    static FnFind      s_find;
+    static FnLoadPack  s_loadPack;
     static FnRender    s_render;
     static FnFree      s_free;
     static FnCreateBmp s_createBmp;
+    static FnAcquire   s_acquire;
+    static FnAcquireIx s_acquireIx;
+    static FnAcqMask   s_acquireMask;
+    static FnPeekMask  s_peekMask;
+    static FnRelease   s_release;
+    static FnSetBudget s_setBudget;
+    static FnGetStats  s_getStats;
 };
 
 } // namespace exo
@@ -0,0 +1,97 @@
+#pragma once
+// ── ExoUI Paint Statistics ──────────────────────────────────
+// Per-control paint counters cheap enough to leave on in release builds.
+// The UI thread records each paint with relaxed atomic adds; anything
+// else (the profiler overlay, a dump, a test on another thread) can take
+// a snapshot at any time without a lock. Durations land in power-of-two
+// buckets, so a snapshot carries the distribution and not just the mean.
+// ProfileReport turns snapshots and cache counters into the text lines the
+// overlay shows and a dump writes. Portable.
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "export.h"
+
+namespace exo {
+
+// A copy of a PaintRecorder's counters. Each is read atomically, but a
+// paint recorded mid-snapshot may show in some counters and not others.
+struct PaintSnapshot {
+    // Bucket 0 holds paints under kFirstBucketUs, bucket b those under
+    // kFirstBucketUs << b, and the last everything longer.
+    static constexpr int      kBuckets       = 16;
+    static constexpr uint64_t kFirstBucketUs = 64;
+
+    uint64_t paints;
+    uint64_t pixels;            // area repainted, summed over dirty rects
+    uint64_t items;             // display-list commands replayed
+    uint64_t microseconds;
+    uint64_t maxMicroseconds;
+    uint64_t recreates;         // EndDraw returned D2DERR_RECREATE_TARGET
+    uint64_t buckets[kBuckets];
+
+    static int      BucketFor(uint64_t microseconds);
+    static uint64_t BucketLimitUs(int bucket);      // exclusive; UINT64_MAX for the last
+
+    double MeanUs() const;
+    // Upper limit of the bucket holding the p-quantile (p in 0..1), capped
+    // at maxMicroseconds; 0 with no paints.
+    uint64_t PercentileUs(double p) const;
+};
+
+class EXOUI_API PaintRecorder {
+public:
+    void Record(uint64_t microseconds, uint64_t pixels, uint64_t items);
+    void RecordRecreate();
+
+    PaintSnapshot Snapshot() const;
+    // Not atomic as a whole: call it from the recording thread.
+    void Reset();
+
+private:
+    std::atomic<uint64_t> m_paints{ 0 };
+    std::atomic<uint64_t> m_pixels{ 0 };
+    std::atomic<uint64_t> m_items{ 0 };
+    std::atomic<uint64_t> m_microseconds{ 0 };
+    std::atomic<uint64_t> m_maxMicroseconds{ 0 };
+    std::atomic<uint64_t> m_recreates{ 0 };
+    std::atomic<uint64_t> m_buckets[PaintSnapshot::kBuckets]{};
+};
+
+// One line per row. Rates are per second since the previous Begin() on
+// the same report, from the totals it was given then; the first report
+// has none. Keep one report object per consumer.
+class EXOUI_API ProfileReport {
+public:
+    void Begin(double nowMs);
+
+    // Paints and their rate, mean, p50/p95/max time, pixels per paint and
+    // target recreations.
+    void Paint(const char* name, const PaintSnapshot& s);
+    // The paint-time distribution, one line per non-empty bucket.
+    void Histogram(const char* name, const PaintSnapshot& s);
+    // Hit rate, and misses per second.
+    void Hits(const char* name, uint64_t hits, uint64_t misses);
+    // A running total and its rate.
+    void Rate(const char* name, uint64_t total);
+    void Note(const char* text);
+
+    const std::vector<std::string>& Lines() const { return m_lines; }
+    std::string Text() const;
+
+private:
+    double                                    m_now       = 0;
+    double                                    m_elapsedMs = 0;     // 0: no rates yet
+    bool                                      m_started   = false;
+    std::vector<std::string>                  m_lines;
+    std::unordered_map<std::string, uint64_t> m_previous;
+
+    // Per-second change of `total` under `key`; negative if unknown.
+    double PerSecond(const std::string& key, uint64_t total);
+    void   Line(const char* format, ...);
+};
+
+} // namespace exo
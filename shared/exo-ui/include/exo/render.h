@@ -6,7 +6,14 @@
 #include <dwrite.h>
 #include <wrl/client.h>
 #include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "display_list.h"
 #include "export.h"
+#include "paint_stats.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -22,24 +29,261 @@ inline D2D1_COLOR_F ToD2DColor(COLORREF cr, float alpha = 1.0f) {
     );
 }
 
+// Hit/miss counters of the shared render-resource caches.
+struct RenderCacheStats {
+    uint64_t textFormatHits;
+    uint64_t textFormatMisses;
+    uint64_t brushHits;
+    uint64_t brushMisses;
+    uint64_t layoutHits;
+    uint64_t layoutMisses;
+    uint64_t layoutResizes;     // layouts re-wrapped to a new box, not rebuilt
+    uint64_t layoutEvictions;   // least recently drawn, past a cache's capacity
+    uint64_t invalidations;
+};
+
+class BrushCache;
+class LabelCache;
+class IconAtlas;
+
+// Where RenderContext::Replay draws a DisplayList: brushes and text
+// layouts come from the control's caches, and Mask image i is slot
+// maskSlots[i] of `atlas` (-1 entries are skipped).
+struct DisplayListTarget {
+    ID2D1RenderTarget* rt;
+    BrushCache*        brushes;
+    LabelCache*        labels;
+    const IconAtlas*   atlas;
+    const int*         maskSlots;
+    int                maskCount;
+};
+
 class EXOUI_API RenderContext {
 public:
     static bool Init();
     static ID2D1Factory* D2D();
     static IDWriteFactory* DWrite();
 
+    // Contents are retained between frames, so a paint may redraw only
+    // its dirty region.
     static ComPtr<ID2D1HwndRenderTarget> CreateHwndTarget(HWND hwnd);
 
+    // InvalidateRect for a DIP rectangle, grown to whole pixels plus one
+    // for antialiased edges.
+    static void InvalidateArea(HWND hwnd, const D2D1_RECT_F& area);
+
     static ComPtr<ID2D1Bitmap> CreateBitmapFromRGBA(
         ID2D1RenderTarget* rt, const uint8_t* rgba, int width, int height);
 
+    // A8 bitmap from an 8-bit coverage mask, for FillIconMask.
+    static ComPtr<ID2D1Bitmap> CreateAlphaMask(
+        ID2D1RenderTarget* rt, const uint8_t* mask, int width, int height, int stride);
+
+    // Paint `brush` through a coverage mask into `dest`. Color and opacity
+    // come from the brush, so one mask serves every theme and state.
+    static void FillIconMask(
+        ID2D1RenderTarget* rt, ID2D1Bitmap* mask, ID2D1Brush* brush, const D2D1_RECT_F& dest);
+
     static ComPtr<IDWriteTextFormat> CreateTextFormat(
         const wchar_t* fontFamily, float size,
         DWRITE_FONT_WEIGHT weight = DWRITE_FONT_WEIGHT_REGULAR);
 
+    // Shared text format for (family, size, weight, alignment), vertically
+    // centered like CreateTextFormat. Owned by the cache: don't modify it,
+    // and don't hold it across Invalidate().
+    static IDWriteTextFormat* TextFormat(
+        const wchar_t* fontFamily, float size,
+        DWRITE_FONT_WEIGHT weight = DWRITE_FONT_WEIGHT_REGULAR,
+        DWRITE_TEXT_ALIGNMENT alignment = DWRITE_TEXT_ALIGNMENT_LEADING);
+
+    // Draw the commands of `list` that touch `clip`; the caller has
+    // clipped to it. Returns the number of commands drawn.
+    static uint64_t Replay(const DisplayListTarget& target, const DisplayList& list,
+                           const D2D1_RECT_F& clip);
+
+    // Drop cached text formats and every BrushCache's brushes. Called on
+    // DPI and theme changes.
+    static void Invalidate();
+    static uint32_t Generation();
+    static RenderCacheStats CacheStats();
+
 private:
     static ComPtr<ID2D1Factory> s_d2dFactory;
     static ComPtr<IDWriteFactory> s_dwriteFactory;
 };
 
+// The part of a window a WM_PAINT must redraw, as non-overlapping
+// rectangles. Controls clear and draw each one under an axis-aligned clip
+// and skip whatever lies outside all of them.
+class EXOUI_API DirtyRegion {
+public:
+    static constexpr int kMaxRects = 8;
+
+    // Read the window's update region; call before BeginPaint validates
+    // it. Regions of more than kMaxRects pieces collapse to their bounds.
+    void Capture(HWND hwnd);
+    void SetAll(const D2D1_RECT_F& area);
+
+    int  Count() const { return m_count; }
+    const D2D1_RECT_F& Rect(int i) const { return m_rects[i]; }
+    bool Intersects(const D2D1_RECT_F& r) const;
+    uint64_t Area() const;
+
+private:
+    D2D1_RECT_F m_rects[kMaxRects] = {};
+    int         m_count = 0;
+};
+
+// Records one paint, its duration and what the control added to `pixels`,
+// `items` and `recreated` into a PaintRecorder when it goes out of scope.
+class EXOUI_API PaintTimer {
+public:
+    explicit PaintTimer(PaintRecorder& recorder);
+    ~PaintTimer();
+    PaintTimer(const PaintTimer&) = delete;
+    PaintTimer& operator=(const PaintTimer&) = delete;
+
+    uint64_t pixels    = 0;     // area cleared and redrawn
+    uint64_t items     = 0;     // display-list commands replayed
+    bool     recreated = false; // EndDraw returned D2DERR_RECREATE_TARGET
+
+private:
+    PaintRecorder& m_recorder;
+    int64_t        m_start;
+};
+
+// The frame a retained control has on screen, and the paint path around
+// it. The control only describes itself: any paint state with
+// Record(DisplayList&) const, e.g. SidebarPaint. State changes are diffed
+// against the frame so only what differs is invalidated; a paint
+// re-records when needed and replays just the dirty rectangles.
+class EXOUI_API RetainedFrame {
+public:
+    const DisplayList& List() const { return m_list; }
+    bool Valid() const { return m_valid; }
+
+    // Re-record on the next paint.
+    void Invalidate() { m_valid = false; }
+    // Re-record and repaint all of `hwnd`.
+    void Repaint(HWND hwnd);
+
+    // Re-record from `paint` after a hover, selection or text change and
+    // invalidate only what differs from the frame on screen. Without a
+    // valid frame all of `hwnd` is invalidated instead.
+    template <typename Paint>
+    void Apply(HWND hwnd, const Paint& paint) {
+        if (!m_valid) {
+            InvalidateRect(hwnd, nullptr, FALSE);
+            return;
+        }
+        paint.Record(m_next);
+        InvalidateChanges(hwnd);
+    }
+
+    // Start of a paint on `rt`. A fresh target has nothing retained to
+    // paint over, and a frame recorded in the previous theme's colors is
+    // re-recorded: either way every pixel is dirty, not just what happened
+    // to be invalid. An invalid frame is recorded from `paint`.
+    template <typename Paint>
+    void Update(ID2D1RenderTarget* rt, DirtyRegion& dirty, bool freshTarget, const Paint& paint) {
+        if (NeedsFullPaint(freshTarget)) {
+            auto size = rt->GetSize();
+            dirty.SetAll(D2D1::RectF(0, 0, size.width, size.height));
+        }
+        if (!m_valid) {
+            paint.Record(m_list);
+            m_valid = true;
+        }
+    }
+
+    // Replay each dirty rectangle under its clip and end the draw. False
+    // when the target has to be recreated: the control drops it and what
+    // was made on it; a full repaint is already pending.
+    bool Draw(HWND hwnd, const DisplayListTarget& target, const DirtyRegion& dirty, PaintTimer& timer);
+
+    // Invalidate where the frame draws Mask `image`, once its mask arrives.
+    void InvalidateImage(HWND hwnd, uint32_t image) const;
+
+private:
+    DisplayList         m_list;
+    DisplayList         m_next;             // scratch for Apply
+    std::vector<DlRect> m_changed;
+    bool                m_valid        = false;
+    uint32_t            m_themeVersion = 0;  // Theme::Version() m_list is in
+
+    bool NeedsFullPaint(bool freshTarget);
+    void InvalidateChanges(HWND hwnd);
+};
+
+// Solid-color brushes for one render target, keyed by color. Brushes
+// belong to the target that created them, so the cache empties itself
+// when handed a different target or after RenderContext::Invalidate();
+// call Reset() when the target is dropped on D2DERR_RECREATE_TARGET.
+class EXOUI_API BrushCache {
+public:
+    ID2D1SolidColorBrush* Get(ID2D1RenderTarget* rt, const D2D1_COLOR_F& color);
+    void Reset();
+
+private:
+    struct Entry {
+        uint32_t                     key;    // color as 8-bit RGBA
+        ComPtr<ID2D1SolidColorBrush> brush;
+    };
+
+    ComPtr<ID2D1RenderTarget> m_target;
+    uint32_t                  m_generation = 0;
+    std::vector<Entry>        m_entries;
+};
+
+// Shaped text layouts for a control's labels, built once per (string,
+// format) and drawn with DrawTextLayout, so unchanged labels skip
+// DirectWrite shaping on every frame. A new box size re-wraps the existing
+// layout; RenderContext::Invalidate() (DPI, theme) empties the cache.
+// Past its capacity the least recently drawn layout is dropped, so a
+// control scrolling through many labels keeps only those near the view.
+class EXOUI_API LabelCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    // Layout for `text` in `format` sized to maxWidth×maxHeight, or nullptr.
+    IDWriteTextLayout* Get(std::wstring_view text, IDWriteTextFormat* format,
+                           float maxWidth, float maxHeight);
+
+    // DrawText replacement: lays `text` out in `rect` through the cache.
+    void Draw(ID2D1RenderTarget* rt, std::wstring_view text, IDWriteTextFormat* format,
+              const D2D1_RECT_F& rect, ID2D1Brush* brush);
+
+    // At least one; shrinking evicts right away.
+    void   SetCapacity(size_t capacity);
+    size_t Capacity() const { return m_capacity; }
+
+    void   Reset();
+    size_t Size() const { return m_entries.size(); }
+
+private:
+    struct KeyView {
+        std::wstring_view  text;
+        IDWriteTextFormat* format;
+        bool operator==(const KeyView& o) const { return format == o.format && text == o.text; }
+    };
+    struct KeyHash {
+        size_t operator()(const KeyView& k) const;
+    };
+    struct Entry {
+        std::wstring              text;     // the index's key views this
+        ComPtr<IDWriteTextFormat> format;   // keeps the key's pointer valid
+        ComPtr<IDWriteTextLayout> layout;
+        float                     maxWidth;
+        float                     maxHeight;
+    };
+    using Order = std::list<Entry>;         // most recently drawn first
+
+    void Trim();
+
+    uint32_t m_generation = 0;
+    size_t   m_capacity   = DEFAULT_CAPACITY;
+    Order    m_entries;
+    std::unordered_map<KeyView, Order::iterator, KeyHash> m_index;
+};
+
 } // namespace exo
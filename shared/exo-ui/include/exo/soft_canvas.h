@@ -0,0 +1,65 @@
+#pragma once
+// ── ExoUI Software Canvas ───────────────────────────────────
+// CPU backend for DisplayList: replays a list into premultiplied RGBA
+// memory with no window, GPU or DirectWrite, so control paint code can be
+// pixel-tested and benchmarked headless (including on Linux).
+//
+// Shapes are antialiased analytically. There is no font rasterizer: each
+// non-space character of a text run is drawn as a solid box on a fixed
+// advance, positioned with the run's alignment, which is enough to diff
+// layout and state changes but not to judge typography.
+
+#include <cstdint>
+#include <vector>
+#include "display_list.h"
+#include "export.h"
+
+namespace exo {
+
+// An 8-bit coverage image referenced by DlOp::Mask commands.
+struct DlImage {
+    const uint8_t* pixels;
+    int            width;
+    int            height;
+    int            stride;
+};
+
+class EXOUI_API SoftwareCanvas {
+public:
+    SoftwareCanvas(int width, int height);
+
+    int Width() const  { return m_width; }
+    int Height() const { return m_height; }
+    int Stride() const { return m_width * 4; }
+    const uint8_t* Pixels() const { return m_pixels.data(); }
+
+    // 0xAARRGGBB of pixel (x, y), premultiplied.
+    uint32_t Pixel(int x, int y) const;
+
+    void Clear(uint32_t color);
+
+    // Draw every command of `list` that touches `clip` (the whole canvas
+    // if null), clipped to it. Mask commands read images[command.image].
+    void Replay(const DisplayList& list, const DlImage* images, int imageCount,
+                const DlRect* clip = nullptr);
+
+private:
+    int                  m_width;
+    int                  m_height;
+    std::vector<uint8_t> m_pixels;
+
+    struct Span {
+        int x0, y0, x1, y1;     // pixel bounds, exclusive end
+    };
+
+    Span Clip(const DlRect& r, const Span& clip) const;
+    void Blend(int x, int y, uint32_t color, float coverage);
+
+    void FillRect(const DlRect& r, uint32_t color, const Span& clip);
+    void RoundedRect(const DlCommand& c, bool stroke, const Span& clip);
+    void Line(const DlCommand& c, const Span& clip);
+    void Mask(const DlCommand& c, const DlImage& image, const Span& clip);
+    void Text(const DlCommand& c, const DisplayList& list, const Span& clip);
+};
+
+} // namespace exo
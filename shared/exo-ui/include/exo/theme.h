@@ -1,9 +1,17 @@
 #pragma once
 // ── ExoUI Theme System ──────────────────────────────────────
+// Colors are named tokens, resolved once per theme switch into every form
+// the paint code uses (COLORREF, D2D, 0xAARRGGBB), so lookups never
+// convert. Version() goes up on every switch: anything derived from theme
+// colors keeps the version it was built at and compares one integer to
+// know it is stale. Subscribers hear about switches on the UI thread.
 
 #include <windows.h>
 #include <dwmapi.h>
+#include <d2d1.h>
 #include <cstdint>
+#include <functional>
+#include "control_colors.h"
 #include "export.h"
 
 namespace exo {
@@ -25,18 +33,57 @@ struct ColorPalette {
 EXOUI_API extern const ColorPalette DarkPalette;
 EXOUI_API extern const ColorPalette LightPalette;
 
+enum class ThemeToken : uint8_t {
+    Background,
+    Surface,
+    SurfaceHover,
+    SurfaceActive,
+    Toolbar,
+    Text,
+    TextSecondary,
+    Border,
+    Accent,
+    StatusBar,
+    StatusBarText,
+    Icon,
+    IconSecondary,
+    Count,
+};
+
 class EXOUI_API Theme {
 public:
+    using Listener = std::function<void()>;
+
+    // Reads the system setting synchronously: meant for startup. After
+    // Init() the system setting is watched off the UI thread.
     static bool IsDarkMode();
     static const ColorPalette& Colors();
     static bool IsDark();
+    // Adopt the system setting and start following it; UI thread.
     static void Init();
     static void Toggle();
     static void SetDark(bool dark);
     static void ApplyToWindow(HWND hwnd);
-    static uint32_t IconColor();
+    static uint32_t IconColor();            // 0xRRGGBB
     static uint32_t SecondaryIconColor();
 
+    // Starts at 1; bumped on every switch.
+    static uint32_t Version();
+    static COLORREF Rgb(ThemeToken token);
+    static const D2D1_COLOR_F& Color(ThemeToken token);
+    static uint32_t Argb(ThemeToken token);
+
+    // The current palette as 0xAARRGGBB, for recording display lists.
+    static const ControlColors& PaintColors();
+
+    // Called on the UI thread after each switch, once the new colors are
+    // in place. Safe to (un)subscribe from inside a listener.
+    static uint32_t Subscribe(Listener listener);
+    static void Unsubscribe(uint32_t id);
+
+    // Stop watching the system setting; call before exit.
+    static void Shutdown();
+
 private:
     static bool s_dark;
 };
@@ -0,0 +1,140 @@
+#include <exo/animation.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace exo {
+
+float Ease(Easing easing, float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    switch (easing) {
+    case Easing::InQuad:    return t * t;
+    case Easing::OutQuad:   return t * (2 - t);
+    case Easing::InOutQuad: return t < 0.5f ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
+    case Easing::OutCubic: {
+        float u = 1 - t;
+        return 1 - u * u * u;
+    }
+    case Easing::InOutCubic: {
+        float u = 1 - t;
+        return t < 0.5f ? 4 * t * t * t : 1 - 4 * u * u * u;
+    }
+    case Easing::Linear:
+    default:                return t;
+    }
+}
+
+AnimationId Timeline::Start(Animated* owner, double now, float from, float to,
+                            double durationMs, Easing easing, Update update)
+{
+    // Coming out of idle: the first frame interval counts from here.
+    if (!Active()) m_lastTick = now;
+
+    AnimationId id = m_nextId++;
+    if (m_nextId == 0) m_nextId = 1;
+    Tween tw{ id, owner, now, durationMs, from, to, easing, false, std::move(update) };
+    // Mid-tick the tween array is being walked; new tweens wait until the
+    // tick is over.
+    (m_ticking ? m_started : m_tweens).push_back(std::move(tw));
+    return id;
+}
+
+bool Timeline::Cancel(AnimationId id) {
+    for (auto* list : { &m_tweens, &m_started }) {
+        auto it = std::find_if(list->begin(), list->end(),
+            [id](const Tween& tw) { return tw.id == id && !tw.cancelled; });
+        if (it == list->end()) continue;
+        if (m_ticking) it->cancelled = true;
+        else           list->erase(it);
+        return true;
+    }
+    return false;
+}
+
+void Timeline::CancelOwner(const Animated* owner) {
+    if (m_ticking) {
+        for (auto& tw : m_tweens)  if (tw.owner == owner) tw.cancelled = true;
+        for (auto& tw : m_started) if (tw.owner == owner) tw.cancelled = true;
+        // It may be gone by the time the flush would reach it.
+        std::replace(m_touched.begin(), m_touched.end(), const_cast<Animated*>(owner),
+                     static_cast<Animated*>(nullptr));
+        return;
+    }
+    std::erase_if(m_tweens, [owner](const Tween& tw) { return tw.owner == owner; });
+}
+
+bool Timeline::Running(AnimationId id) const {
+    for (const auto* list : { &m_tweens, &m_started })
+        for (const auto& tw : *list)
+            if (tw.id == id) return !tw.cancelled;
+    return false;
+}
+
+size_t Timeline::Count() const {
+    size_t n = 0;
+    for (const auto* list : { &m_tweens, &m_started })
+        for (const auto& tw : *list) n += !tw.cancelled;
+    return n;
+}
+
+bool Timeline::Tick(double now) {
+    if (!Active()) {
+        m_lastTick = -1;
+        return false;
+    }
+    auto t0 = std::chrono::steady_clock::now();
+
+    if (m_lastTick >= 0) {
+        double interval = now - m_lastTick;
+        m_stats.intervalMs   += interval;
+        m_stats.maxIntervalMs = std::max(m_stats.maxIntervalMs, interval);
+        if (interval > m_budgetMs * 1.5) m_stats.longFrames++;
+    }
+    m_lastTick = now;
+    m_stats.frames++;
+
+    // Updates. Finished and cancelled tweens are only marked here: an
+    // update may start or cancel tweens, and m_tweens must not move under
+    // the callback being run.
+    m_ticking = true;
+    m_touched.clear();
+    for (size_t i = 0; i < m_tweens.size(); i++) {
+        Tween& tw = m_tweens[i];
+        if (tw.cancelled) continue;
+
+        double t = tw.duration > 0 ? (now - tw.start) / tw.duration : 1.0;
+        float value = tw.to;
+        if (t >= 1.0) {
+            tw.cancelled = true;
+        } else {
+            float e = Ease(tw.easing, static_cast<float>(std::max(t, 0.0)));
+            value = tw.from + (tw.to - tw.from) * e;
+        }
+        tw.update(value);
+        m_stats.updates++;
+
+        if (tw.owner && std::find(m_touched.begin(), m_touched.end(), tw.owner) == m_touched.end())
+            m_touched.push_back(tw.owner);
+    }
+
+    // One flush per owner, so its invalidations for the frame go out
+    // together.
+    for (size_t i = 0; i < m_touched.size(); i++) {
+        if (!m_touched[i]) continue;
+        m_touched[i]->OnAnimationFrame();
+        m_stats.flushes++;
+    }
+    m_ticking = false;
+
+    std::erase_if(m_tweens, [](const Tween& tw) { return tw.cancelled; });
+    for (auto& tw : m_started)
+        if (!tw.cancelled) m_tweens.push_back(std::move(tw));
+    m_started.clear();
+
+    m_stats.tickUs += std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - t0).count();
+    if (!Active()) m_lastTick = -1;
+    return Active();
+}
+
+} // namespace exo
@@ -0,0 +1,123 @@
+#include <exo/animator.h>
+
+#include <dwmapi.h>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace exo {
+
+// ── Clock state ─────────────────────────────────────────────
+// The timeline and the tick window belong to the UI thread; the worker
+// only touches the event and the atomics.
+namespace {
+
+constexpr UINT WM_EXO_TICK = WM_APP + 0x3E0;
+
+Timeline          s_timeline;
+HWND              s_tickWindow = nullptr;
+HANDLE            s_wake       = nullptr;     // manual-reset: set while animating
+std::thread       s_worker;
+std::atomic<bool> s_posted{ false };
+std::atomic<bool> s_quit{ false };
+
+LRESULT CALLBACK TickProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    if (msg != WM_EXO_TICK) return DefWindowProcW(hwnd, msg, wp, lp);
+    s_posted.store(false, std::memory_order_release);
+    if (!s_timeline.Tick(Animator::Now()))
+        ResetEvent(s_wake);
+    return 0;
+}
+
+// Once per composition frame while animating. A tick still waiting in
+// the queue is not doubled up: a slow frame drops ticks instead of
+// bunching them.
+void WorkerLoop() {
+    while (WaitForSingleObject(s_wake, INFINITE) == WAIT_OBJECT_0 &&
+           !s_quit.load(std::memory_order_acquire))
+    {
+        if (FAILED(DwmFlush())) Sleep(16);      // composition unavailable
+        if (!s_posted.exchange(true, std::memory_order_acq_rel))
+            PostMessageW(s_tickWindow, WM_EXO_TICK, 0, 0);
+    }
+}
+
+double RefreshIntervalMs() {
+    DWM_TIMING_INFO info{};
+    info.cbSize = sizeof(info);
+    if (SUCCEEDED(DwmGetCompositionTimingInfo(nullptr, &info)) &&
+        info.rateRefresh.uiNumerator != 0)
+    {
+        return 1000.0 * info.rateRefresh.uiDenominator / info.rateRefresh.uiNumerator;
+    }
+    return 1000.0 / 60.0;
+}
+
+bool EnsureStarted() {
+    if (s_tickWindow) return true;
+
+    HINSTANCE hInst = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                       GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&TickProc), &hInst);
+
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.lpfnWndProc   = TickProc;
+    wc.hInstance     = hInst;
+    wc.lpszClassName = L"ExoAnimatorTick";
+    RegisterClassExW(&wc);
+
+    s_tickWindow = CreateWindowExW(0, L"ExoAnimatorTick", nullptr, 0, 0, 0, 0, 0,
+                                   HWND_MESSAGE, nullptr, hInst, nullptr);
+    if (!s_tickWindow) return false;
+
+    s_wake = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    s_quit.store(false);
+    s_posted.store(false);
+    s_timeline.SetFrameBudget(RefreshIntervalMs());
+    s_worker = std::thread(WorkerLoop);
+    return true;
+}
+
+} // namespace
+
+AnimationId Animator::Start(Animated* owner, float from, float to,
+                            double durationMs, Easing easing, Timeline::Update update)
+{
+    AnimationId id = s_timeline.Start(owner, Now(), from, to, durationMs, easing, std::move(update));
+    if (EnsureStarted()) SetEvent(s_wake);
+    return id;
+}
+
+bool Animator::Cancel(AnimationId id) { return s_timeline.Cancel(id); }
+void Animator::CancelOwner(const Animated* owner) { s_timeline.CancelOwner(owner); }
+bool Animator::Active() { return s_timeline.Active(); }
+
+double Animator::Now() {
+    static const double msPerCount = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return 1000.0 / static_cast<double>(f.QuadPart);
+    }();
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return static_cast<double>(t.QuadPart) * msPerCount;
+}
+
+FrameStats Animator::Stats() { return s_timeline.Stats(); }
+void Animator::ResetStats() { s_timeline.ResetStats(); }
+
+void Animator::Shutdown() {
+    if (!s_tickWindow) return;
+    s_quit.store(true, std::memory_order_release);
+    SetEvent(s_wake);
+    if (s_worker.joinable()) s_worker.join();
+
+    DestroyWindow(s_tickWindow);
+    CloseHandle(s_wake);
+    s_tickWindow = nullptr;
+    s_wake       = nullptr;
+}
+
+} // namespace exo
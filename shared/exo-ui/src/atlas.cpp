@@ -0,0 +1,139 @@
+#include <exo/atlas.h>
+
+#include <algorithm>
+#include <climits>
+
+namespace exo {
+
+// ── Skyline packer ──────────────────────────────────────────
+
+void SkylinePacker::Reset(int width, int height) {
+    m_width  = width;
+    m_height = height;
+    m_used   = 0;
+    m_skyline.assign(1, Segment{ 0, 0, width });
+}
+
+// With its left edge at segment i, a rectangle rests on the highest
+// segment it spans.
+bool SkylinePacker::Fit(size_t i, int width, int height, int& y) const {
+    if (m_skyline[i].x + width > m_width) return false;
+    y = 0;
+    for (int left = width; left > 0; i++) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) return false;
+        left -= m_skyline[i].width;
+    }
+    return true;
+}
+
+bool SkylinePacker::Insert(int width, int height, int& x, int& y) {
+    if (width <= 0 || height <= 0) return false;
+
+    // Lowest resulting top edge; on a tie, the narrowest segment, which
+    // leaves the wide ones for wide rectangles.
+    size_t best = m_skyline.size();
+    int bestTop = INT_MAX, bestWidth = INT_MAX, bestY = 0;
+    for (size_t i = 0; i < m_skyline.size(); i++) {
+        int fy;
+        if (!Fit(i, width, height, fy)) continue;
+        int top = fy + height;
+        if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth)) {
+            best      = i;
+            bestTop   = top;
+            bestWidth = m_skyline[i].width;
+            bestY     = fy;
+        }
+    }
+    if (best == m_skyline.size()) return false;
+
+    x = m_skyline[best].x;
+    y = bestY;
+    m_skyline.insert(m_skyline.begin() + best, Segment{ x, y + height, width });
+
+    // Cut what the new segment covers out of the ones after it.
+    int end = x + width;
+    for (size_t i = best + 1; i < m_skyline.size();) {
+        Segment& s = m_skyline[i];
+        if (s.x >= end) break;
+        int overlap = end - s.x;
+        if (s.width <= overlap) {
+            m_skyline.erase(m_skyline.begin() + i);
+            continue;
+        }
+        s.x     += overlap;
+        s.width -= overlap;
+        break;
+    }
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+    m_used += static_cast<uint64_t>(width) * height;
+    return true;
+}
+
+// ── Mask atlas ──────────────────────────────────────────────
+
+MaskAtlas::MaskAtlas(int pageSize, int maxPages)
+    : m_pageSize(pageSize), m_maxPages(maxPages) {}
+
+int MaskAtlas::Find(int index, int size) const {
+    auto it = m_lookup.find(Key(index, size));
+    return it != m_lookup.end() ? it->second : -1;
+}
+
+int MaskAtlas::Insert(int index, int size) {
+    int cell = size + 2 * kPadding;
+    if (size <= 0 || cell > m_pageSize) return -1;
+
+    int page = 0, x = 0, y = 0;
+    for (; page < PageCount(); page++)
+        if (m_pages[page].Insert(cell, cell, x, y)) break;
+    if (page == PageCount()) {
+        if (page == m_maxPages) return -1;
+        m_pages.emplace_back().Reset(m_pageSize, m_pageSize);
+        m_pages.back().Insert(cell, cell, x, y);
+    }
+
+    int slot = SlotCount();
+    m_slots.push_back(AtlasSlot{ page, x + kPadding, y + kPadding, size });
+    m_lookup[Key(index, size)] = slot;
+    return slot;
+}
+
+void MaskAtlas::RemoveLast(int index, int size) {
+    auto it = m_lookup.find(Key(index, size));
+    if (it == m_lookup.end() || it->second != SlotCount() - 1) return;
+    m_lookup.erase(it);
+
+    // A page opened for this mask alone goes with it; space on an older
+    // page stays used until Clear().
+    const AtlasSlot& s = m_slots.back();
+    uint64_t cell = static_cast<uint64_t>(s.size + 2 * kPadding);
+    if (s.page == PageCount() - 1 && m_pages.back().UsedArea() == cell * cell) m_pages.pop_back();
+    m_slots.pop_back();
+}
+
+uint64_t MaskAtlas::UsedArea() const {
+    uint64_t used = 0;
+    for (const auto& p : m_pages) used += p.UsedArea();
+    return used;
+}
+
+float MaskAtlas::Fill() const {
+    double capacity = static_cast<double>(m_pageSize) * m_pageSize * m_maxPages;
+    return capacity > 0 ? static_cast<float>(UsedArea() / capacity) : 1.0f;
+}
+
+void MaskAtlas::Clear() {
+    m_pages.clear();
+    m_slots.clear();
+    m_lookup.clear();
+}
+
+} // namespace exo
@@ -0,0 +1,468 @@
+#include <exo/controls/control_paint.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace exo {
+
+namespace {
+
+constexpr int      kWeightRegular  = 400;     // DWRITE_FONT_WEIGHT_REGULAR
+constexpr int      kWeightSemiBold = 600;     // DWRITE_FONT_WEIGHT_SEMI_BOLD
+constexpr uint32_t kWhite          = 0xFFFFFFFF;
+constexpr float    kCornerRadius   = 4.0f;
+
+// Same color at a new alpha.
+uint32_t WithAlpha(uint32_t color, float alpha) {
+    return (color & 0xFFFFFF) | static_cast<uint32_t>(alpha * 255.0f + 0.5f) << 24;
+}
+
+// Cell and icon sizes per ItemViewMode at 96 DPI; Details rows span the
+// columns.
+struct ItemViewMetrics {
+    int cellWidth;
+    int cellHeight;
+    int iconSize;
+};
+
+constexpr ItemViewMetrics kItemViewMetrics[] = {
+    { 100, 92, 32 },    // LargeIcons
+    { 180, 26, 16 },    // SmallIcons
+    { 200, 24, 16 },    // List
+    {   0, 24, 16 },    // Details
+};
+
+constexpr int kItemViewPad    = 8;
+constexpr int kItemViewHeader = 28;
+
+} // namespace
+
+// ── Sidebar ─────────────────────────────────────────────────
+
+DlRect SidebarPaint::ItemRect(int i) const {
+    float top = ItemsTop() + static_cast<float>(i * ItemHeight());
+    return DlRect{ 0, top, width, top + static_cast<float>(ItemHeight()) };
+}
+
+int SidebarPaint::HitTest(float y) const {
+    if (y < ItemsTop()) return -1;
+    int idx = static_cast<int>((y - ItemsTop()) / static_cast<float>(ItemHeight()));
+    return idx < count ? idx : -1;
+}
+
+void SidebarPaint::Record(DisplayList& out) const {
+    out.Clear();
+    out.FillRect(DlRect{ 0, 0, width, height }, colors.surface);
+
+    // Right border
+    out.Line(width - 0.5f, 0, width - 0.5f, height, 1.0f, colors.border);
+
+    // Header
+    float padX = static_cast<float>(PaintScale(BASE_PADDING_X, dpi));
+    int headerFont = out.Font(L"Segoe UI", PaintScaleF(static_cast<float>(BASE_HEADER_FONT), dpi),
+                              kWeightSemiBold, DlAlign::Leading);
+    out.Text(DlRect{ padX, PaintScaleF(14.0f, dpi), width - padX, PaintScaleF(34.0f, dpi) },
+             L"CATEGORIES", headerFont, colors.textSecondary);
+
+    // Items, down to the bottom edge; the rest are never visible.
+    int itemFont = out.Font(L"Segoe UI", PaintScaleF(static_cast<float>(BASE_FONT_SIZE), dpi),
+                            kWeightRegular, DlAlign::Leading);
+    float itemH   = static_cast<float>(ItemHeight());
+    float iconSz  = static_cast<float>(IconSize());
+    float margin  = PaintScaleF(4.0f, dpi);
+    float inflate = PaintScaleF(2.0f, dpi);
+    float gap     = PaintScaleF(8.0f, dpi);
+    uint32_t iconColor = WithAlpha(colors.icon, 0.75f);
+
+    for (int i = 0; i < count; i++) {
+        float top = ItemsTop() + static_cast<float>(i) * itemH;
+        float bot = top + itemH;
+        if (top >= height) break;
+        DlRect itemRc{ margin, top + inflate, width - margin - 2, bot - inflate };
+
+        uint32_t labelColor = colors.text;
+        uint32_t glyphColor = iconColor;
+        if (i == selected) {
+            out.FillRoundedRect(itemRc, kCornerRadius, colors.surfaceActive);
+            labelColor = kWhite;
+            glyphColor = kWhite;
+        } else if (i == hovered && hoverFade > 0) {
+            out.FillRoundedRect(itemRc, kCornerRadius, WithAlpha(colors.surfaceHover, hoverFade));
+        } else if (i == fading && fadeOut > 0) {
+            out.FillRoundedRect(itemRc, kCornerRadius, WithAlpha(colors.surfaceHover, fadeOut));
+        }
+
+        float iconX = itemRc.left + padX;
+        float iconY = (top + bot - iconSz) / 2.0f;
+        out.Mask(DlRect{ iconX, iconY, iconX + iconSz, iconY + iconSz }, i, glyphColor);
+
+        float labelX = iconX + iconSz + gap;
+        out.Text(DlRect{ labelX, top, width, bot }, items[i].label, itemFont, labelColor);
+    }
+}
+
+// ── Toolbar ─────────────────────────────────────────────────
+
+// Right-aligned buttons stack from the right edge, later ones outermost,
+// as far as the chevron's room at the left margin. Left-aligned ones flow
+// from the left margin, with a gap after the toggle group, until they
+// would meet the right group; if anything doesn't fit, room is made for
+// the chevron and the rest go to the overflow menu in button order.
+void ToolbarLayout::Build(const ToolbarButton* buttons, int count, int dpi, float width) {
+    float pad    = static_cast<float>(PaintScale(4, dpi));
+    float margin = static_cast<float>(PaintScale(8, dpi));
+    float h      = static_cast<float>(PaintScale(ToolbarPaint::BASE_HEIGHT, dpi));
+    float chevW  = static_cast<float>(PaintScale(BASE_CHEVRON_WIDTH, dpi));
+    auto btnWidth = [&](int i) { return static_cast<float>(PaintScale(buttons[i].baseWidth, dpi)); };
+
+    m_top    = pad;
+    m_bottom = h - pad;
+    m_rects.assign(count, DlRect{});
+    m_visible.assign(count, 0);
+    m_overflow.clear();
+    m_slots.clear();
+    m_chevron = DlRect{};
+
+    bool overflow = false;
+    float rightX = width - margin;
+    for (int i = count - 1; i >= 0; i--) {
+        if (!buttons[i].rightAlign) continue;
+        if (rightX - btnWidth(i) - pad < margin + chevW + pad) {
+            overflow = true;
+            break;
+        }
+        rightX -= btnWidth(i) + pad;
+        m_rects[i]   = DlRect{ rightX, m_top, rightX + btnWidth(i), m_bottom };
+        m_visible[i] = 1;
+    }
+
+    // Place left buttons up to `limit`; false if one didn't fit. `x` ends
+    // where the next slot would go.
+    auto flow = [&](float limit, float& x) {
+        x = margin;
+        int prev = -1;
+        for (int i = 0; i < count; i++) {
+            if (buttons[i].rightAlign) continue;
+            float bx = x;
+            if (prev >= 0 && !buttons[i].toggle && buttons[prev].toggle) bx += margin;
+            if (bx + btnWidth(i) > limit) return false;
+            m_rects[i]   = DlRect{ bx, m_top, bx + btnWidth(i), m_bottom };
+            m_visible[i] = 1;
+            x = bx + btnWidth(i) + pad;
+            prev = i;
+        }
+        return true;
+    };
+
+    float x = margin;
+    if (overflow || !flow(rightX - pad, x)) {
+        for (int i = 0; i < count; i++) {
+            if (!buttons[i].rightAlign) {
+                m_rects[i]   = DlRect{};
+                m_visible[i] = 0;
+            }
+        }
+        flow(rightX - pad - chevW - pad, x);
+        m_chevron = DlRect{ x, m_top, x + chevW, m_bottom };
+        for (int i = 0; i < count; i++)
+            if (!m_visible[i]) m_overflow.push_back(i);
+    }
+
+    for (int i = 0; i < count; i++)
+        if (m_visible[i]) m_slots.push_back({ m_rects[i].left, m_rects[i].right, i });
+    if (HasOverflow()) m_slots.push_back({ m_chevron.left, m_chevron.right, kChevron });
+    std::sort(m_slots.begin(), m_slots.end(),
+              [](const Slot& a, const Slot& b) { return a.left < b.left; });
+}
+
+int ToolbarLayout::HitTest(float x, float y) const {
+    if (y < m_top || y > m_bottom) return -1;
+    auto it = std::upper_bound(m_slots.begin(), m_slots.end(), x,
+                               [](float v, const Slot& s) { return v < s.left; });
+    if (it == m_slots.begin()) return -1;
+    --it;
+    return x <= it->right ? it->index : -1;
+}
+
+void ToolbarPaint::Record(DisplayList& out) const {
+    out.Clear();
+    out.FillRect(DlRect{ 0, 0, width, height }, colors.toolbar);
+
+    // Bottom border
+    out.Line(0, height - 0.5f, width, height - 0.5f, 1.0f, colors.border);
+
+    int font = out.Font(L"Segoe UI", PaintScaleF(static_cast<float>(BASE_FONT_SIZE), dpi),
+                        kWeightRegular, DlAlign::Center);
+
+    for (int i = 0; i < count; i++) {
+        if (!layout->Visible(i)) continue;
+        const DlRect& rc = layout->Rect(i);
+        bool active = buttons[i].toggle && buttons[i].id == activeId;
+
+        if (active) {
+            out.FillRoundedRect(rc, kCornerRadius, colors.accent);
+        } else if (i == hovered) {
+            out.FillRoundedRect(rc, kCornerRadius, colors.surfaceHover);
+            out.StrokeRoundedRect(rc, kCornerRadius, 1.0f, colors.border);
+        }
+        bool iconOnly = (!buttons[i].label || !buttons[i].label[0]) && buttons[i].iconName;
+        if (iconOnly) {
+            float sz = static_cast<float>(IconSize());
+            float ix = std::floor((rc.left + rc.right - sz) / 2);
+            float iy = std::floor((rc.top + rc.bottom - sz) / 2);
+            out.Mask(DlRect{ ix, iy, ix + sz, iy + sz }, i, active ? kWhite : colors.icon);
+        } else {
+            out.Text(rc, buttons[i].label, font, active ? kWhite : colors.text);
+        }
+    }
+
+    // Chevron: a downward "v" in the middle of its slot.
+    if (layout->HasOverflow()) {
+        const DlRect& rc = layout->ChevronRect();
+        if (hovered == ToolbarLayout::kChevron) {
+            out.FillRoundedRect(rc, kCornerRadius, colors.surfaceHover);
+            out.StrokeRoundedRect(rc, kCornerRadius, 1.0f, colors.border);
+        }
+        float cx = (rc.left + rc.right) / 2, cy = (rc.top + rc.bottom) / 2;
+        float arm = PaintScaleF(4.0f, dpi), stroke = PaintScaleF(1.5f, dpi);
+        out.Line(cx - arm, cy - arm / 2, cx, cy + arm / 2, stroke, colors.text);
+        out.Line(cx, cy + arm / 2, cx + arm, cy - arm / 2, stroke, colors.text);
+    }
+}
+
+// ── Status bar ──────────────────────────────────────────────
+
+void StatusBarPaint::Record(DisplayList& out) const {
+    out.Clear();
+    out.FillRect(DlRect{ 0, 0, width, height }, colors.statusBar);
+
+    // Top border
+    out.Line(0, 0.5f, width, 0.5f, 1.0f, colors.border);
+
+    float padX = PaintScaleF(static_cast<float>(BASE_PADDING_X), dpi);
+    int font = out.Font(L"Segoe UI", PaintScaleF(static_cast<float>(BASE_FONT_SIZE), dpi),
+                        kWeightRegular, DlAlign::Leading);
+    out.Text(DlRect{ padX, 0, width - padX, height }, text, font, colors.statusBarText);
+}
+
+// ── Profiler overlay ────────────────────────────────────────
+
+int ProfilerPaint::HeightFor(int count, int dpi) {
+    return PaintScale(2 * BASE_PADDING + std::max(count, 1) * BASE_LINE_HEIGHT, dpi);
+}
+
+void ProfilerPaint::Record(DisplayList& out) const {
+    out.Clear();
+    out.FillRect(DlRect{ 0, 0, width, height }, colors.border);
+    out.FillRect(DlRect{ 1, 1, width - 1, height - 1 }, colors.surface);
+
+    float pad   = PaintScaleF(static_cast<float>(BASE_PADDING), dpi);
+    float lineH = PaintScaleF(static_cast<float>(BASE_LINE_HEIGHT), dpi);
+    int font = out.Font(L"Consolas", PaintScaleF(static_cast<float>(BASE_FONT_SIZE), dpi),
+                        kWeightRegular, DlAlign::Leading);
+    for (int i = 0; i < count; i++) {
+        float top = pad + lineH * static_cast<float>(i);
+        out.Text(DlRect{ pad, top, width - pad, top + lineH }, lines[i], font, colors.text);
+    }
+}
+
+// ── Item view ───────────────────────────────────────────────
+
+int ItemViewLayout::IconSizeFor(ItemViewMode mode, int dpi) {
+    return PaintScale(kItemViewMetrics[static_cast<int>(mode)].iconSize, dpi);
+}
+
+void ItemViewLayout::Build(ItemViewMode mode, int count, int dpi, float width, float height,
+                           const ItemColumn* columns, int columnCount)
+{
+    const auto& m = kItemViewMetrics[static_cast<int>(mode)];
+    m_mode     = mode;
+    m_count    = std::max(count, 0);
+    m_width    = width;
+    m_height   = height;
+    m_cellH    = static_cast<float>(PaintScale(m.cellHeight, dpi));
+    m_iconSize = IconSizeFor(mode, dpi);
+
+    if (mode == ItemViewMode::Details) {
+        float rowWidth = 0;
+        for (int c = 0; c < columnCount; c++)
+            rowWidth += static_cast<float>(PaintScale(columns[c].baseWidth, dpi));
+        m_pad      = 0;
+        m_header   = static_cast<float>(PaintScale(kItemViewHeader, dpi));
+        m_rowWidth = std::max(rowWidth, width);
+        m_cellW    = m_rowWidth;
+        m_perLine  = 1;
+    } else {
+        m_pad      = static_cast<float>(PaintScale(kItemViewPad, dpi));
+        m_header   = 0;
+        m_rowWidth = 0;
+        m_cellW    = static_cast<float>(PaintScale(m.cellWidth, dpi));
+        float room = (mode == ItemViewMode::List ? height : width) - 2 * m_pad;
+        float cell = mode == ItemViewMode::List ? m_cellH : m_cellW;
+        m_perLine  = std::max(1, static_cast<int>(room / cell));
+    }
+    m_lines = (m_count + m_perLine - 1) / m_perLine;
+}
+
+float ItemViewLayout::Start() const { return m_pad; }
+
+float ItemViewLayout::Extent() const {
+    return Start() + static_cast<float>(m_lines) * LineLength() + m_pad;
+}
+
+float ItemViewLayout::Viewport() const {
+    if (Horizontal()) return m_width;
+    return std::max(0.0f, m_height - m_header);
+}
+
+float ItemViewLayout::ClampScroll(float scroll) const {
+    return std::clamp(scroll, 0.0f, std::max(0.0f, Extent() - Viewport()));
+}
+
+void ItemViewLayout::Visible(float scroll, int& first, int& last) const {
+    float len = LineLength();
+    int firstLine = std::max(0, static_cast<int>(std::floor((scroll - Start()) / len)));
+    int lastLine  = std::min(m_lines, static_cast<int>(std::ceil((scroll + Viewport() - Start()) / len)));
+    first = std::min(m_count, firstLine * m_perLine);
+    last  = std::clamp(lastLine * m_perLine, first, m_count);
+}
+
+DlRect ItemViewLayout::ItemRect(int item, float scroll) const {
+    int line = item / m_perLine, pos = item % m_perLine;
+    float along = Start() + static_cast<float>(line) * LineLength() - scroll;
+    switch (m_mode) {
+    case ItemViewMode::List: {
+        float y = m_pad + static_cast<float>(pos) * m_cellH;
+        return DlRect{ along, y, along + m_cellW, y + m_cellH };
+    }
+    case ItemViewMode::Details: {
+        float y = m_header + along;
+        return DlRect{ 0, y, m_rowWidth, y + m_cellH };
+    }
+    default: {
+        float x = m_pad + static_cast<float>(pos) * m_cellW;
+        return DlRect{ x, along, x + m_cellW, along + m_cellH };
+    }
+    }
+}
+
+int ItemViewLayout::HitTest(float x, float y, float scroll) const {
+    if (y < m_header) return -1;
+    float along  = (Horizontal() ? x : y - m_header) + scroll - Start();
+    float across = (Horizontal() ? y : x) - m_pad;
+    if (along < 0 || across < 0) return -1;
+
+    int line = static_cast<int>(along / LineLength());
+    int pos  = 0;
+    if (m_mode == ItemViewMode::Details) {
+        if (x >= m_rowWidth) return -1;
+    } else {
+        pos = static_cast<int>(across / (Horizontal() ? m_cellH : m_cellW));
+    }
+    if (pos >= m_perLine || line >= m_lines) return -1;
+    int item = line * m_perLine + pos;
+    return item < m_count ? item : -1;
+}
+
+float ItemViewLayout::ScrollToShow(int item, float scroll) const {
+    int line = item / m_perLine;
+    if (line == 0) return 0;
+    float lead  = Start() + static_cast<float>(line) * LineLength();
+    float trail = lead + LineLength();
+    if (lead < scroll) return ClampScroll(lead);
+    if (trail > scroll + Viewport()) return ClampScroll(trail - Viewport() + (line == m_lines - 1 ? m_pad : 0));
+    return scroll;
+}
+
+// The top (or left) edge stays put as {0, 0}; anywhere else the leading
+// item keeps the same fraction of its line hidden.
+ItemViewLayout::Anchor ItemViewLayout::AnchorAt(float scroll) const {
+    float along = scroll - Start();
+    if (m_count == 0 || along <= 0) return Anchor{ 0, 0 };
+    int line = std::min(static_cast<int>(along / LineLength()), m_lines - 1);
+    return Anchor{ line * m_perLine, (along - static_cast<float>(line) * LineLength()) / LineLength() };
+}
+
+float ItemViewLayout::ScrollFor(const Anchor& anchor) const {
+    if (m_count == 0 || (anchor.item <= 0 && anchor.offset <= 0)) return 0;
+    int line = std::min(anchor.item, m_count - 1) / m_perLine;
+    return ClampScroll(Start() + (static_cast<float>(line) + anchor.offset) * LineLength());
+}
+
+void ItemViewPaint::Record(DisplayList& out) const {
+    out.Clear();
+    out.FillRect(DlRect{ 0, 0, width, height }, colors.background);
+    if (!model || !layout) return;
+
+    bool details = layout->Mode() == ItemViewMode::Details;
+    bool large   = layout->Mode() == ItemViewMode::LargeIcons;
+    float fontSize = PaintScaleF(static_cast<float>(BASE_FONT_SIZE), dpi);
+    int font   = out.Font(L"Segoe UI", fontSize, kWeightRegular, DlAlign::Leading);
+    int center = large ? out.Font(L"Segoe UI", fontSize, kWeightRegular, DlAlign::Center) : font;
+
+    float iconSz = static_cast<float>(layout->IconSize());
+    float inset  = PaintScaleF(2.0f, dpi);
+    float gap    = PaintScaleF(6.0f, dpi);
+    uint32_t iconColor = WithAlpha(colors.icon, 0.75f);
+
+    // Details column edges, from the left.
+    int cols = details && columns ? std::max(columnCount, 0) : 0;
+    std::vector<float> colX(static_cast<size_t>(cols) + 1, 0.0f);
+    for (int c = 0; c < cols; c++)
+        colX[c + 1] = colX[c] + static_cast<float>(PaintScale(columns[c].baseWidth, dpi));
+
+    int first = 0, last = 0;
+    layout->Visible(scroll, first, last);
+    for (int i = first; i < last; i++) {
+        DlRect rc = layout->ItemRect(i, scroll);
+        DlRect hi{ rc.left + inset, rc.top + inset / 2, rc.right - inset, rc.bottom - inset / 2 };
+
+        uint32_t labelColor = colors.text;
+        uint32_t glyphColor = iconColor;
+        if (i == selected) {
+            out.FillRoundedRect(hi, kCornerRadius, colors.surfaceActive);
+            labelColor = kWhite;
+            glyphColor = kWhite;
+        } else if (i == hovered) {
+            out.FillRoundedRect(hi, kCornerRadius, colors.surfaceHover);
+        }
+
+        int icon = model->Icon(i);
+        std::wstring_view label = model->Label(i);
+        if (large) {
+            float ix = (rc.left + rc.right - iconSz) / 2;
+            float iy = rc.top + PaintScaleF(10.0f, dpi);
+            if (icon >= 0) out.Mask(DlRect{ ix, iy, ix + iconSz, iy + iconSz }, icon, glyphColor);
+            out.Text(DlRect{ hi.left, iy + iconSz + PaintScaleF(4.0f, dpi), hi.right, hi.bottom },
+                     label, center, labelColor);
+            continue;
+        }
+
+        float ix = rc.left + gap;
+        float iy = (rc.top + rc.bottom - iconSz) / 2;
+        if (icon >= 0) out.Mask(DlRect{ ix, iy, ix + iconSz, iy + iconSz }, icon, glyphColor);
+        float labelRight = cols > 0 ? colX[1] - gap : hi.right - gap;
+        out.Text(DlRect{ ix + iconSz + gap, rc.top, labelRight, rc.bottom }, label, font, labelColor);
+
+        for (int c = 1; c < cols; c++) {
+            out.Text(DlRect{ colX[c] + gap, rc.top, colX[c + 1] - gap, rc.bottom },
+                     model->Detail(i, c), font, i == selected ? kWhite : colors.textSecondary);
+        }
+    }
+
+    // Details header, over any row scrolled beneath it.
+    if (details) {
+        float header = layout->HeaderHeight();
+        int headerFont = out.Font(L"Segoe UI", PaintScaleF(static_cast<float>(BASE_HEADER_FONT), dpi),
+                                  kWeightSemiBold, DlAlign::Leading);
+        out.FillRect(DlRect{ 0, 0, width, header }, colors.toolbar);
+        for (int c = 0; c < cols; c++) {
+            out.Text(DlRect{ colX[c] + gap, 0, colX[c + 1] - gap, header },
+                     columns[c].title ? columns[c].title : L"", headerFont, colors.textSecondary);
+            out.Line(colX[c + 1] - 0.5f, gap, colX[c + 1] - 0.5f, header - gap, 1.0f, colors.border);
+        }
+        out.Line(0, header - 0.5f, width, header - 0.5f, 1.0f, colors.border);
+    }
+}
+
+} // namespace exo
@@ -0,0 +1,438 @@
+#include <exo/controls/item_view.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace exo {
+
+HWND ItemView::Handle() const { return m_hwnd; }
+ItemViewMode ItemView::Mode() const { return m_mode; }
+int  ItemView::Selected() const { return m_selected; }
+const ItemViewLayout& ItemView::Layout() const { return m_layout; }
+PaintSnapshot ItemView::GetPaintStats() const { return m_paintStats.Snapshot(); }
+void ItemView::ResetPaintStats() { m_paintStats.Reset(); }
+const IconAtlasStats& ItemView::GetAtlasStats() const { return m_atlas.Stats(); }
+
+void ItemView::Create(HWND parent, HINSTANCE hInst, int id) {
+    m_parent = parent;
+
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.style         = CS_HREDRAW | CS_VREDRAW | CS_DBLCLKS;
+    wc.lpfnWndProc   = ItemViewProc;
+    wc.hInstance     = hInst;
+    wc.hCursor       = LoadCursorW(nullptr, IDC_ARROW);
+    wc.lpszClassName = L"ExoItemView";
+    RegisterClassExW(&wc);
+
+    m_hwnd = CreateWindowExW(
+        0, L"ExoItemView", nullptr,
+        WS_CHILD | WS_VISIBLE | WS_TABSTOP | WS_CLIPCHILDREN,
+        0, 0, 400, 400,
+        parent, reinterpret_cast<HMENU>(static_cast<INT_PTR>(id)),
+        hInst, this
+    );
+
+    m_dpi = Dpi::Get(m_hwnd);
+    CreateRenderTarget();
+    Relayout(false);
+}
+
+void ItemView::Resize(int x, int y, int w, int h) {
+    MoveWindow(m_hwnd, x, y, w, h, TRUE);
+}
+
+void ItemView::Repaint() {
+    m_frame.Repaint(m_hwnd);
+}
+
+void ItemView::UpdateDpi(int dpi) {
+    if (dpi != m_dpi) RenderContext::Invalidate();
+    m_dpi = dpi;
+    Relayout(true);
+}
+
+void ItemView::CreateRenderTarget() {
+    m_rt = RenderContext::CreateHwndTarget(m_hwnd);
+    m_atlas.Reset();
+    m_maskSlots.clear();
+    m_maskTried.clear();
+}
+
+void ItemView::SetModel(const ItemModel* model) {
+    m_model    = model;
+    m_selected = -1;
+    m_hovered  = -1;
+    m_scroll   = 0;
+    Relayout(false);
+}
+
+void ItemView::ModelChanged() {
+    int count = m_model ? m_model->Count() : 0;
+    if (m_selected >= count) m_selected = -1;
+    m_hovered = -1;
+    Relayout(true);
+}
+
+void ItemView::SetMode(ItemViewMode mode) {
+    if (mode == m_mode) return;
+    m_mode    = mode;
+    m_hovered = -1;
+    Relayout(true);
+}
+
+void ItemView::SetColumns(const ItemColumn* columns, int count) {
+    m_columns     = columns;
+    m_columnCount = columns ? count : 0;
+    Relayout(true);
+}
+
+// Rebuild the cell grid for the current mode, size, DPI and item count.
+// With `keepAnchor` the item at the leading edge stays where it was.
+void ItemView::Relayout(bool keepAnchor) {
+    if (!m_hwnd) return;
+    auto anchor = m_layout.AnchorAt(m_scroll);
+
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    m_layout.Build(m_mode, m_model ? m_model->Count() : 0, m_dpi,
+                   static_cast<float>(rc.right), static_cast<float>(rc.bottom),
+                   m_columns, m_columnCount);
+    m_scroll = keepAnchor ? m_layout.ScrollFor(anchor) : m_layout.ClampScroll(m_scroll);
+
+    // A label per item, one per column in Details, plus the header.
+    int lines = m_layout.LineLength() > 0
+              ? static_cast<int>(std::ceil(m_layout.Viewport() / m_layout.LineLength())) + 1 : 1;
+    int perItem = m_mode == ItemViewMode::Details ? std::max(m_columnCount, 1) : 1;
+    m_labels.SetCapacity(static_cast<size_t>(LABEL_SCREENS) * lines * m_layout.PerLine() * perItem +
+                         m_columnCount);
+
+    if (m_layout.IconSize() != m_maskSize) {
+        if (m_atlas.Fill() > ATLAS_TRIM_FILL) EvictMasks();
+        m_maskTried.assign(m_maskSlots.size(), 0);
+        m_maskSize = m_layout.IconSize();
+    }
+    UpdateScrollBar();
+    Repaint();
+}
+
+void ItemView::UpdateScrollBar() {
+    int bar = m_layout.Horizontal() ? SB_HORZ : SB_VERT;
+    ShowScrollBar(m_hwnd, bar == SB_HORZ ? SB_VERT : SB_HORZ, FALSE);
+
+    SCROLLINFO si{};
+    si.cbSize = sizeof(si);
+    si.fMask  = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin   = 0;
+    si.nMax   = std::max(0, static_cast<int>(std::ceil(m_layout.Extent())) - 1);
+    si.nPage  = static_cast<UINT>(m_layout.Viewport());
+    si.nPos   = static_cast<int>(m_scroll);
+    SetScrollInfo(m_hwnd, bar, &si, TRUE);
+}
+
+// Scrolling moves every item, so it re-records; only the items now in
+// view are touched.
+void ItemView::ScrollTo(float scroll) {
+    scroll = m_layout.ClampScroll(scroll);
+    if (scroll == m_scroll) return;
+    m_scroll  = scroll;
+    m_hovered = -1;
+    SetScrollPos(m_hwnd, m_layout.Horizontal() ? SB_HORZ : SB_VERT, static_cast<int>(scroll), TRUE);
+    Repaint();
+}
+
+void ItemView::OnScroll(int bar, int code) {
+    if ((bar == SB_HORZ) != m_layout.Horizontal()) return;
+    float line = m_layout.LineLength();
+    float page = std::max(line, m_layout.Viewport() - line);
+
+    switch (code) {
+    case SB_LINEUP:   ScrollTo(m_scroll - line); break;
+    case SB_LINEDOWN: ScrollTo(m_scroll + line); break;
+    case SB_PAGEUP:   ScrollTo(m_scroll - page); break;
+    case SB_PAGEDOWN: ScrollTo(m_scroll + page); break;
+    case SB_TOP:      ScrollTo(0); break;
+    case SB_BOTTOM:   ScrollTo(m_layout.Extent()); break;
+    case SB_THUMBTRACK:
+    case SB_THUMBPOSITION: {
+        SCROLLINFO si{};
+        si.cbSize = sizeof(si);
+        si.fMask  = SIF_TRACKPOS;
+        GetScrollInfo(m_hwnd, bar, &si);
+        ScrollTo(static_cast<float>(si.nTrackPos));
+        break;
+    }
+    }
+}
+
+void ItemView::Select(int item) {
+    int count = m_model ? m_model->Count() : 0;
+    if (item < 0 || item >= count || item == m_selected) return;
+    m_selected = item;
+    EnsureVisible(item);
+    m_frame.Apply(m_hwnd, PaintState());
+    Notify(IVN_SELCHANGE);
+}
+
+void ItemView::EnsureVisible(int item) {
+    if (item < 0 || item >= m_layout.Count()) return;
+    ScrollTo(m_layout.ScrollToShow(item, m_scroll));
+}
+
+void ItemView::Notify(WORD code) {
+    SendMessageW(m_parent, WM_COMMAND,
+        MAKEWPARAM(GetDlgCtrlID(m_hwnd), code), reinterpret_cast<LPARAM>(m_hwnd));
+}
+
+ItemViewPaint ItemView::PaintState() const {
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    ItemViewPaint p;
+    p.model       = m_model;
+    p.layout      = &m_layout;
+    p.columns     = m_columns;
+    p.columnCount = m_columnCount;
+    p.scroll      = m_scroll;
+    p.selected    = m_selected;
+    p.hovered     = m_hovered;
+    p.dpi         = m_dpi;
+    p.width       = static_cast<float>(rc.right);
+    p.height      = static_cast<float>(rc.bottom);
+    p.colors      = Theme::PaintColors();
+    return p;
+}
+
+// Ask for the masks the frame uses, each once per icon size. Masks the
+// atlas holds cost nothing; ones in Lucide's cache (the size was shown or
+// prewarmed before) are uploaded before this frame draws; the newly seen
+// icons are prewarmed for the other monitors. When the atlas fills, it is
+// emptied and refilled from the icons in view; any that still don't fit
+// stay untried, so a later paint asks again.
+void ItemView::EnsureMasks() {
+    m_fresh.clear();
+    for (int pass = 0; pass < 2; pass++) {
+        bool full = false;
+        for (const auto& c : m_frame.List().Commands()) {
+            if (c.op != DlOp::Mask) continue;
+            if (c.image >= m_maskSlots.size()) {
+                m_maskSlots.resize(c.image + 1, -1);
+                m_maskTried.resize(c.image + 1);
+            }
+            if (m_maskTried[c.image]) continue;
+            m_maskTried[c.image] = 1;
+            int slot = m_atlas.Find(c.image, m_maskSize);
+            if (slot < 0) {
+                if (pass == 0) m_fresh.push_back(static_cast<int>(c.image));
+                if (const IconRaster* mask = IconService::RequestMask(this, c.image, m_maskSize)) {
+                    slot = m_atlas.Add(m_rt.Get(), c.image, m_maskSize, *mask);
+                    LucideIcons::Release(mask);
+                    if (slot < 0) {
+                        m_maskTried[c.image] = 0;
+                        full = true;
+                    }
+                }
+            }
+            if (slot >= 0) m_maskSlots[c.image] = slot;
+        }
+        if (!full || pass > 0) break;
+        EvictMasks();
+    }
+    Prewarm(m_fresh);
+}
+
+// Forget every mask; the ones in view are asked for again as they paint.
+void ItemView::EvictMasks() {
+    m_atlas.Reset();
+    m_maskSlots.assign(m_maskSlots.size(), -1);
+    m_maskTried.assign(m_maskTried.size(), 0);
+}
+
+// Only icons the view has shown, or is about to show, are worth rendering
+// ahead: with a large model most of the rest may never scroll into view.
+void ItemView::PrewarmDpis(const int* dpis, int count) {
+    m_prewarmDpis.assign(dpis, dpis + std::max(count, 0));
+    m_fresh.clear();
+    for (size_t i = 0; i < m_maskTried.size(); i++)
+        if (m_maskTried[i]) m_fresh.push_back(static_cast<int>(i));
+    // Items in view that haven't painted yet, as right after SetModel.
+    if (m_model) {
+        int first, last;
+        m_layout.Visible(m_scroll, first, last);
+        for (int i = first; i < last; i++) {
+            int icon = m_model->Icon(i);
+            bool tried = icon < static_cast<int>(m_maskTried.size()) && m_maskTried[icon];
+            if (icon >= 0 && !tried) m_fresh.push_back(icon);
+        }
+    }
+    Prewarm(m_fresh);
+}
+
+void ItemView::Prewarm(const std::vector<int>& indices) {
+    if (indices.empty()) return;
+    for (int dpi : m_prewarmDpis) {
+        int sz = ItemViewLayout::IconSizeFor(m_mode, dpi);
+        if (sz != m_maskSize)
+            IconService::Prewarm(indices.data(), static_cast<int>(indices.size()), sz);
+    }
+}
+
+// Upload the mask and repaint only the icons that use it; the recorded
+// frame doesn't change.
+void ItemView::OnIconReady(int index, int size, const IconRaster* mask) {
+    if (!m_rt || !mask || size != m_maskSize || index >= static_cast<int>(m_maskSlots.size())) return;
+    int slot = m_atlas.Add(m_rt.Get(), index, size, *mask);
+    if (slot < 0) {
+        // No room: the next paint refills the atlas from what is in view.
+        EvictMasks();
+        InvalidateRect(m_hwnd, nullptr, FALSE);
+        return;
+    }
+    m_maskSlots[index] = slot;
+    m_frame.InvalidateImage(m_hwnd, index);
+}
+
+void ItemView::OnPaint(DirtyRegion& dirty) {
+    PaintTimer timer(m_paintStats);
+    bool fresh = !m_rt;
+    if (fresh) {
+        CreateRenderTarget();
+        if (!m_rt) return;
+    }
+    m_frame.Update(m_rt.Get(), dirty, fresh, PaintState());
+    EnsureMasks();
+
+    DisplayListTarget target{ m_rt.Get(), &m_brushes, &m_labels, &m_atlas,
+                              m_maskSlots.data(), static_cast<int>(m_maskSlots.size()) };
+    if (!m_frame.Draw(m_hwnd, target, dirty, timer)) {
+        m_rt.Reset();
+        m_brushes.Reset();
+    }
+}
+
+LRESULT CALLBACK ItemView::ItemViewProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    ItemView* self = nullptr;
+    if (msg == WM_NCCREATE) {
+        auto cs = reinterpret_cast<CREATESTRUCTW*>(lp);
+        self = static_cast<ItemView*>(cs->lpCreateParams);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+        self->m_hwnd = hwnd;
+    } else {
+        self = reinterpret_cast<ItemView*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    }
+    if (!self) return DefWindowProcW(hwnd, msg, wp, lp);
+
+    switch (msg) {
+    case WM_PAINT: {
+        DirtyRegion dirty;
+        dirty.Capture(hwnd);
+        PAINTSTRUCT ps;
+        BeginPaint(hwnd, &ps);
+        self->OnPaint(dirty);
+        EndPaint(hwnd, &ps);
+        return 0;
+    }
+
+    case WM_SIZE:
+        if (self->m_rt) {
+            RECT rc;
+            GetClientRect(hwnd, &rc);
+            self->m_rt->Resize(D2D1::SizeU(rc.right, rc.bottom));
+        }
+        self->Relayout(true);
+        return 0;
+
+    case WM_VSCROLL:
+        self->OnScroll(SB_VERT, LOWORD(wp));
+        return 0;
+
+    case WM_HSCROLL:
+        self->OnScroll(SB_HORZ, LOWORD(wp));
+        return 0;
+
+    case WM_MOUSEWHEEL: {
+        float notches = static_cast<float>(GET_WHEEL_DELTA_WPARAM(wp)) / WHEEL_DELTA;
+        float step = self->m_layout.Horizontal() ? self->m_layout.LineLength()
+                                                 : 3 * self->m_layout.LineLength();
+        self->ScrollTo(self->m_scroll - notches * step);
+        return 0;
+    }
+
+    case WM_LBUTTONDOWN: {
+        SetFocus(hwnd);
+        int idx = self->m_layout.HitTest(static_cast<float>(LOWORD(lp)),
+                                         static_cast<float>(HIWORD(lp)), self->m_scroll);
+        if (idx >= 0) self->Select(idx);
+        return 0;
+    }
+
+    case WM_LBUTTONDBLCLK: {
+        int idx = self->m_layout.HitTest(static_cast<float>(LOWORD(lp)),
+                                         static_cast<float>(HIWORD(lp)), self->m_scroll);
+        if (idx >= 0 && idx == self->m_selected) self->Notify(IVN_ACTIVATE);
+        return 0;
+    }
+
+    case WM_MOUSEMOVE: {
+        int idx = self->m_layout.HitTest(static_cast<float>(LOWORD(lp)),
+                                         static_cast<float>(HIWORD(lp)), self->m_scroll);
+        if (idx != self->m_hovered) {
+            self->m_hovered = idx;
+            self->m_frame.Apply(hwnd, self->PaintState());
+            TRACKMOUSEEVENT tme{};
+            tme.cbSize    = sizeof(tme);
+            tme.dwFlags   = TME_LEAVE;
+            tme.hwndTrack = hwnd;
+            TrackMouseEvent(&tme);
+        }
+        return 0;
+    }
+
+    case WM_MOUSELEAVE:
+        if (self->m_hovered >= 0) {
+            self->m_hovered = -1;
+            self->m_frame.Apply(hwnd, self->PaintState());
+        }
+        return 0;
+
+    case WM_GETDLGCODE:
+        return DLGC_WANTARROWS;
+
+    case WM_KEYDOWN: {
+        // Arrows move along and across lines; List runs in columns.
+        const auto& layout = self->m_layout;
+        int across = layout.Mode() == ItemViewMode::Details ? 1 : layout.PerLine();
+        int page   = std::max(1, static_cast<int>(layout.Viewport() / layout.LineLength())) * layout.PerLine();
+        int cur    = self->m_selected;
+        int next   = -1;
+        bool list  = layout.Horizontal();
+        switch (wp) {
+        case VK_HOME:  next = 0; break;
+        case VK_END:   next = layout.Count() - 1; break;
+        case VK_PRIOR: next = cur - page; break;
+        case VK_NEXT:  next = cur + page; break;
+        case VK_UP:    next = cur - (list ? 1 : across); break;
+        case VK_DOWN:  next = cur + (list ? 1 : across); break;
+        case VK_LEFT:  next = cur - (list ? across : 1); break;
+        case VK_RIGHT: next = cur + (list ? across : 1); break;
+        default:       return DefWindowProcW(hwnd, msg, wp, lp);
+        }
+        // With nothing selected yet, the first key lands on item 0, as in
+        // a list view; later presses move from there.
+        if (cur < 0) next = 0;
+        if (layout.Count() > 0)
+            self->Select(std::clamp(next, 0, layout.Count() - 1));
+        return 0;
+    }
+
+    case WM_DESTROY:
+        IconService::Cancel(self);
+        return 0;
+
+    case WM_ERASEBKGND:
+        return 1;
+    }
+
+    return DefWindowProcW(hwnd, msg, wp, lp);
+}
+
+} // namespace exo
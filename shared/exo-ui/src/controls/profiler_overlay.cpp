@@ -0,0 +1,160 @@
+#include <exo/controls/profiler_overlay.h>
+
+namespace exo {
+
+HWND ProfilerOverlay::Handle() const { return m_hwnd; }
+bool ProfilerOverlay::Visible() const { return m_hwnd && IsWindowVisible(m_hwnd); }
+PaintSnapshot ProfilerOverlay::GetPaintStats() const { return m_paintStats.Snapshot(); }
+void ProfilerOverlay::ResetPaintStats() { m_paintStats.Reset(); }
+
+void ProfilerOverlay::Create(HWND owner, HINSTANCE hInst) {
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.style         = CS_HREDRAW | CS_VREDRAW;
+    wc.lpfnWndProc   = OverlayProc;
+    wc.hInstance     = hInst;
+    wc.hCursor       = LoadCursorW(nullptr, IDC_ARROW);
+    wc.lpszClassName = L"ExoProfilerOverlay";
+    RegisterClassExW(&wc);
+
+    // Layered and transparent: clicks fall through to whatever is under it.
+    m_hwnd = CreateWindowExW(
+        WS_EX_LAYERED | WS_EX_TRANSPARENT | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
+        L"ExoProfilerOverlay", nullptr,
+        WS_POPUP,
+        0, 0, ProfilerPaint::BASE_WIDTH, ProfilerPaint::HeightFor(1, 96),
+        owner, nullptr, hInst, this
+    );
+    if (!m_hwnd) return;
+
+    SetLayeredWindowAttributes(m_hwnd, 0, OPACITY, LWA_ALPHA);
+    m_dpi = Dpi::Get(m_hwnd);
+}
+
+void ProfilerOverlay::Show(bool show) {
+    if (!m_hwnd) return;
+    if (show) {
+        Reposition();
+        ShowWindow(m_hwnd, SW_SHOWNOACTIVATE);
+    } else {
+        ShowWindow(m_hwnd, SW_HIDE);
+    }
+}
+
+void ProfilerOverlay::Place(HWND anchor) {
+    m_anchor = anchor;
+    if (Visible()) Reposition();
+}
+
+void ProfilerOverlay::Reposition() {
+    if (!m_hwnd || !m_anchor) return;
+    RECT rc;
+    GetWindowRect(m_anchor, &rc);
+    int gap = Dpi::Scale(BASE_GAP, m_dpi);
+    int w   = Dpi::Scale(ProfilerPaint::BASE_WIDTH, m_dpi);
+    int h   = ProfilerPaint::HeightFor(static_cast<int>(m_lines.size()), m_dpi);
+    SetWindowPos(m_hwnd, nullptr, rc.right - w - gap, rc.top + gap, w, h,
+                 SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+void ProfilerOverlay::SetLines(const std::vector<std::string>& lines) {
+    bool resized = lines.size() != m_lines.size();
+    m_lines.resize(lines.size());
+    // Report lines are plain ASCII.
+    for (size_t i = 0; i < lines.size(); i++) m_lines[i].assign(lines[i].begin(), lines[i].end());
+    // Most lines change every refresh. Room for this refresh and the last
+    // keeps the unchanged ones shaped; older text is evicted, not hoarded.
+    m_labels.SetCapacity(2 * lines.size());
+    if (resized) {
+        Reposition();
+        Repaint();
+        return;
+    }
+    m_frame.Apply(m_hwnd, PaintState());
+}
+
+void ProfilerOverlay::Repaint() {
+    m_frame.Repaint(m_hwnd);
+}
+
+ProfilerPaint ProfilerOverlay::PaintState() const {
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    ProfilerPaint p;
+    p.lines  = m_lines.data();
+    p.count  = static_cast<int>(m_lines.size());
+    p.dpi    = m_dpi;
+    p.width  = static_cast<float>(rc.right);
+    p.height = static_cast<float>(rc.bottom);
+    p.colors = Theme::PaintColors();
+    return p;
+}
+
+void ProfilerOverlay::OnPaint(DirtyRegion& dirty) {
+    PaintTimer timer(m_paintStats);
+    bool fresh = !m_rt;
+    if (fresh) {
+        m_rt = RenderContext::CreateHwndTarget(m_hwnd);
+        if (!m_rt) return;
+    }
+    m_frame.Update(m_rt.Get(), dirty, fresh, PaintState());
+
+    DisplayListTarget target{ m_rt.Get(), &m_brushes, &m_labels, nullptr, nullptr, 0 };
+    if (!m_frame.Draw(m_hwnd, target, dirty, timer)) {
+        m_rt.Reset();
+        m_brushes.Reset();
+    }
+}
+
+LRESULT CALLBACK ProfilerOverlay::OverlayProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    ProfilerOverlay* self = nullptr;
+    if (msg == WM_NCCREATE) {
+        auto cs = reinterpret_cast<CREATESTRUCTW*>(lp);
+        self = static_cast<ProfilerOverlay*>(cs->lpCreateParams);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+        self->m_hwnd = hwnd;
+    } else {
+        self = reinterpret_cast<ProfilerOverlay*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    }
+    if (!self) return DefWindowProcW(hwnd, msg, wp, lp);
+
+    switch (msg) {
+    case WM_PAINT: {
+        DirtyRegion dirty;
+        dirty.Capture(hwnd);
+        PAINTSTRUCT ps;
+        BeginPaint(hwnd, &ps);
+        self->OnPaint(dirty);
+        EndPaint(hwnd, &ps);
+        return 0;
+    }
+
+    case WM_SIZE:
+        if (self->m_rt) {
+            RECT rc;
+            GetClientRect(hwnd, &rc);
+            self->m_rt->Resize(D2D1::SizeU(rc.right, rc.bottom));
+        }
+        self->m_frame.Invalidate();
+        return 0;
+
+    // A popup gets its own DPI change when it lands on another monitor;
+    // keep it pinned to the anchor rather than taking the suggested rect.
+    case WM_DPICHANGED:
+        if (HIWORD(wp) != self->m_dpi) RenderContext::Invalidate();
+        self->m_dpi = HIWORD(wp);
+        self->Reposition();
+        self->Repaint();
+        return 0;
+
+    case WM_MOUSEACTIVATE:
+        return MA_NOACTIVATE;
+
+    case WM_ERASEBKGND:
+        return 1;
+    }
+
+    return DefWindowProcW(hwnd, msg, wp, lp);
+}
+
+} // namespace exo
@@ -1,12 +1,12 @@
 #include <exo/controls/sidebar.h>
 
+#include <algorithm>
+
 namespace exo {
 
 int Sidebar::ScaledWidth() const { return Dpi::Scale(BASE_WIDTH, m_dpi); }
 HWND Sidebar::Handle() const { return m_hwnd; }
 int  Sidebar::Selected() const { return m_selected; }
-int  Sidebar::ItemHeight() const { return Dpi::Scale(BASE_ITEM_HEIGHT, m_dpi); }
-int  Sidebar::PaddingX() const { return Dpi::Scale(BASE_PADDING_X, m_dpi); }
 int  Sidebar::IconSize() const { return Dpi::Scale(BASE_ICON_SIZE, m_dpi); }
 
 void Sidebar::Create(HWND parent, HINSTANCE hInst, int id) {
@@ -38,134 +38,166 @@ void Sidebar::Resize(int x, int y, int w, int h) {
     if (m_rt) m_rt->Resize(D2D1::SizeU(w, h));
 }
 
-void Sidebar::Repaint() { InvalidateRect(m_hwnd, nullptr, FALSE); }
+void Sidebar::Repaint() {
+    m_frame.Repaint(m_hwnd);
+}
 
 void Sidebar::UpdateDpi(int dpi) {
+    if (dpi != m_dpi) RenderContext::Invalidate();
+    // The new icon size differs from m_cachedIconSize; if it was
+    // prewarmed, RebuildIconCache finds every mask in the cache.
     m_dpi = dpi;
-    m_cachedIconSize = 0;  // force rebuild
     Repaint();
 }
 
+// Bitmaps belong to the target that made them.
 void Sidebar::CreateRenderTarget() {
     m_rt = RenderContext::CreateHwndTarget(m_hwnd);
+    m_atlas.Reset();
+    std::fill(m_iconSlots.begin(), m_iconSlots.end(), -1);
     m_cachedIconSize = 0;
 }
 
+void Sidebar::SetItems(const SidebarItem* items, int count) {
+    m_items     = items;
+    m_itemCount = items ? count : 0;
+    m_selected  = 0;
+    m_hovered   = -1;
+    m_fading    = -1;
+    Animator::CancelOwner(this);
+    IconService::Cancel(this);
+    m_iconSlots.clear();
+    m_iconsResolved  = false;
+    m_cachedIconSize = 0;
+    Repaint();
+}
+
+PaintSnapshot Sidebar::GetPaintStats() const { return m_paintStats.Snapshot(); }
+void Sidebar::ResetPaintStats() { m_paintStats.Reset(); }
+const IconAtlasStats& Sidebar::GetAtlasStats() const { return m_atlas.Stats(); }
+
+SidebarPaint Sidebar::PaintState() const {
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    SidebarPaint p;
+    p.items     = m_items;
+    p.count     = m_itemCount;
+    p.selected  = m_selected;
+    p.hovered   = m_hovered;
+    p.hoverFade = m_hoverFade;
+    p.fading    = m_fading;
+    p.fadeOut   = m_fadeOut;
+    p.dpi       = m_dpi;
+    p.width     = static_cast<float>(rc.right);
+    p.height    = static_cast<float>(rc.bottom);
+    p.colors    = Theme::PaintColors();
+    return p;
+}
+
+// The highlight under the mouse fades in; the one it left fades out from
+// wherever it had got to, so quick sweeps never jump.
+void Sidebar::SetHovered(int idx) {
+    if (idx == m_hovered) return;
+    Animator::Cancel(m_fadeInAnim);
+    Animator::Cancel(m_fadeOutAnim);
+    m_fadeInAnim = m_fadeOutAnim = 0;
+
+    float from = idx >= 0 && idx == m_fading ? m_fadeOut : 0.0f;
+    m_fading  = m_hovered;
+    m_fadeOut = m_hovered >= 0 ? m_hoverFade : 0.0f;
+    m_hovered   = idx;
+    m_hoverFade = from;
+
+    if (m_fading >= 0 && m_fadeOut > 0) {
+        m_fadeOutAnim = Animator::Start(this, m_fadeOut, 0.0f, HOVER_FADE_MS * m_fadeOut,
+            Easing::OutQuad, [this](float v) { m_fadeOut = v; });
+    }
+    if (m_hovered >= 0) {
+        m_fadeInAnim = Animator::Start(this, from, 1.0f, HOVER_FADE_MS * (1.0f - from),
+            Easing::OutQuad, [this](float v) { m_hoverFade = v; });
+    }
+    m_frame.Apply(m_hwnd, PaintState());
+}
+
+void Sidebar::OnAnimationFrame() { m_frame.Apply(m_hwnd, PaintState()); }
+
+// Masks depend only on size; theme, hover and selection only change the
+// brush they're painted with. A size the atlas already holds costs
+// nothing; one in Lucide's cache (the current monitor's, or prewarmed for
+// another) is uploaded right here; the rest is rasterized by the icon
+// service, and until each mask arrives the previous size's mask is drawn
+// scaled into the new rectangle, or nothing on the first paint.
 void Sidebar::RebuildIconCache() {
     if (!m_rt) return;
     int sz = IconSize();
-    uint32_t color = Theme::IconColor();
-    if (sz == m_cachedIconSize && color == m_cachedIconColor) return;
-
-    for (int i = 0; i < kCategoryCount; i++) {
-        m_iconBitmaps[i].Reset();
-        auto* rgba = LucideIcons::Render(kCategories[i].iconName, sz, color);
-        if (rgba) {
-            m_iconBitmaps[i] = RenderContext::CreateBitmapFromRGBA(
-                m_rt.Get(), rgba, sz, sz);
-            LucideIcons::Free(rgba);
+    if (sz == m_cachedIconSize) return;
+
+    ResolveIcons();
+    for (int i = 0; i < m_itemCount; i++) {
+        if (m_iconIndex[i] < 0) continue;
+        int slot = m_atlas.Find(m_iconIndex[i], sz);
+        if (slot < 0) {
+            if (const IconRaster* mask = IconService::RequestMask(this, m_iconIndex[i], sz)) {
+                slot = m_atlas.Add(m_rt.Get(), m_iconIndex[i], sz, *mask);
+                LucideIcons::Release(mask);
+            }
         }
+        if (slot >= 0) m_iconSlots[i] = slot;
     }
     m_cachedIconSize = sz;
-    m_cachedIconColor = color;
 }
 
-void Sidebar::OnPaint() {
-    if (!m_rt) { CreateRenderTarget(); if (!m_rt) return; }
-    RebuildIconCache();
-
-    auto& c = Theme::Colors();
-    int itemH   = ItemHeight();
-    int padX    = PaddingX();
-    int iconSz  = IconSize();
-    float fontSize   = Dpi::ScaleF(static_cast<float>(BASE_FONT_SIZE), m_dpi);
-    float headerSize = Dpi::ScaleF(static_cast<float>(BASE_HEADER_FONT), m_dpi);
-
-    m_rt->BeginDraw();
-    m_rt->Clear(ToD2DColor(c.surface));
-
-    auto size = m_rt->GetSize();
-
-    // Right border
-    ComPtr<ID2D1SolidColorBrush> borderBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.border), &borderBrush);
-    m_rt->DrawLine(
-        D2D1::Point2F(size.width - 0.5f, 0),
-        D2D1::Point2F(size.width - 0.5f, size.height),
-        borderBrush.Get(), 1.0f
-    );
+void Sidebar::ResolveIcons() {
+    if (m_iconsResolved) return;
+    m_iconIndex.resize(m_itemCount);
+    m_iconSlots.assign(m_itemCount, -1);
+    for (int i = 0; i < m_itemCount; i++)
+        m_iconIndex[i] = LucideIcons::Find(m_items[i].iconName);
+    m_iconsResolved = true;
+}
 
-    // Header
-    auto headerFmt = RenderContext::CreateTextFormat(L"Segoe UI", headerSize, DWRITE_FONT_WEIGHT_SEMI_BOLD);
-    ComPtr<ID2D1SolidColorBrush> secBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.textSecondary), &secBrush);
-    float headerTop = Dpi::ScaleF(14.0f, m_dpi);
-    float headerBot = Dpi::ScaleF(34.0f, m_dpi);
-    m_rt->DrawText(L"CATEGORIES", 10, headerFmt.Get(),
-        D2D1::RectF(static_cast<float>(padX), headerTop, size.width - static_cast<float>(padX), headerBot),
-        secBrush.Get());
-
-    // Items
-    auto itemFmt = RenderContext::CreateTextFormat(L"Segoe UI", fontSize);
-    ComPtr<ID2D1SolidColorBrush> textBrush, whiteBrush, hoverBrush, activeBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.text), &textBrush);
-    m_rt->CreateSolidColorBrush(D2D1::ColorF(1, 1, 1), &whiteBrush);
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.surfaceHover), &hoverBrush);
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.surfaceActive), &activeBrush);
-
-    float yStart = Dpi::ScaleF(44.0f, m_dpi);
-    float margin = Dpi::ScaleF(4.0f, m_dpi);
-    float inflate = Dpi::ScaleF(2.0f, m_dpi);
-    float gap = Dpi::ScaleF(8.0f, m_dpi);
-
-    for (int i = 0; i < kCategoryCount; i++) {
-        float top = yStart + i * static_cast<float>(itemH);
-        float bot = top + static_cast<float>(itemH);
-        D2D1_RECT_F itemRc = D2D1::RectF(margin, top + inflate, size.width - margin - 2, bot - inflate);
-
-        ID2D1SolidColorBrush* labelBrush = textBrush.Get();
-
-        if (i == m_selected) {
-            m_rt->FillRoundedRectangle(
-                D2D1::RoundedRect(itemRc, 4.0f, 4.0f), activeBrush.Get());
-            labelBrush = whiteBrush.Get();
-        } else if (i == m_hovered) {
-            m_rt->FillRoundedRectangle(
-                D2D1::RoundedRect(itemRc, 4.0f, 4.0f), hoverBrush.Get());
-        }
+void Sidebar::PrewarmDpis(const int* dpis, int count) {
+    ResolveIcons();
+    for (int d = 0; d < count; d++) {
+        int sz = Dpi::Scale(BASE_ICON_SIZE, dpis[d]);
+        if (sz != IconSize())
+            IconService::Prewarm(m_iconIndex.data(), m_itemCount, sz);
+    }
+}
 
-        // Icon
-        float iconX = itemRc.left + static_cast<float>(padX);
-        float iconY = (top + bot - static_cast<float>(iconSz)) / 2.0f;
-
-        if (m_iconBitmaps[i]) {
-            D2D1_RECT_F iconRc = D2D1::RectF(
-                iconX, iconY,
-                iconX + static_cast<float>(iconSz),
-                iconY + static_cast<float>(iconSz)
-            );
-            m_rt->DrawBitmap(m_iconBitmaps[i].Get(), iconRc,
-                (i == m_selected) ? 1.0f : 0.75f);
-        }
+// Upload the mask once for every item showing the icon and repaint just
+// those icons; the recorded frame doesn't change.
+void Sidebar::OnIconReady(int index, int size, const IconRaster* mask) {
+    if (!m_rt || !mask || size != m_cachedIconSize) return;
+    int slot = m_atlas.Add(m_rt.Get(), index, size, *mask);
+    if (slot < 0) return;
+    for (int i = 0; i < m_itemCount; i++) {
+        if (m_iconIndex[i] != index) continue;
+        m_iconSlots[i] = slot;
+        m_frame.InvalidateImage(m_hwnd, static_cast<uint32_t>(i));
+    }
+}
 
-        // Label
-        float labelX = iconX + static_cast<float>(iconSz) + gap;
-        D2D1_RECT_F labelRc = D2D1::RectF(labelX, top, size.width, bot);
-        m_rt->DrawText(kCategories[i].label,
-            static_cast<UINT32>(wcslen(kCategories[i].label)),
-            itemFmt.Get(), labelRc, labelBrush);
+void Sidebar::OnPaint(DirtyRegion& dirty) {
+    PaintTimer timer(m_paintStats);
+    bool fresh = !m_rt;
+    if (fresh) {
+        CreateRenderTarget();
+        if (!m_rt) return;
     }
+    RebuildIconCache();
+    m_frame.Update(m_rt.Get(), dirty, fresh, PaintState());
 
-    HRESULT hr = m_rt->EndDraw();
-    if (hr == D2DERR_RECREATE_TARGET) m_rt.Reset();
+    DisplayListTarget target{ m_rt.Get(), &m_brushes, &m_labels, &m_atlas,
+                              m_iconSlots.data(), static_cast<int>(m_iconSlots.size()) };
+    if (!m_frame.Draw(m_hwnd, target, dirty, timer)) {
+        m_rt.Reset();
+        m_brushes.Reset();
+    }
 }
 
-int Sidebar::HitTest(int y) {
-    int yStart = Dpi::Scale(44, m_dpi);
-    int itemH  = ItemHeight();
-    int idx = (y - yStart) / itemH;
-    if (idx >= 0 && idx < kCategoryCount) return idx;
-    return -1;
+int Sidebar::HitTest(int y) const {
+    return PaintState().HitTest(static_cast<float>(y));
 }
 
 LRESULT CALLBACK Sidebar::SidebarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
@@ -182,9 +214,11 @@ LRESULT CALLBACK Sidebar::SidebarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
 
     switch (msg) {
     case WM_PAINT: {
+        DirtyRegion dirty;
+        dirty.Capture(hwnd);
         PAINTSTRUCT ps;
         BeginPaint(hwnd, &ps);
-        self->OnPaint();
+        self->OnPaint(dirty);
         EndPaint(hwnd, &ps);
         return 0;
     }
@@ -195,13 +229,14 @@ LRESULT CALLBACK Sidebar::SidebarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
             GetClientRect(hwnd, &rc);
             self->m_rt->Resize(D2D1::SizeU(rc.right, rc.bottom));
         }
+        self->m_frame.Invalidate();
         return 0;
 
     case WM_LBUTTONDOWN: {
         int idx = self->HitTest(HIWORD(lp));
         if (idx >= 0 && idx != self->m_selected) {
             self->m_selected = idx;
-            InvalidateRect(hwnd, nullptr, FALSE);
+            self->m_frame.Apply(hwnd, self->PaintState());
             SendMessageW(self->m_parent, WM_COMMAND,
                 MAKEWPARAM(GetDlgCtrlID(hwnd), idx),
                 reinterpret_cast<LPARAM>(hwnd));
@@ -212,8 +247,7 @@ LRESULT CALLBACK Sidebar::SidebarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
     case WM_MOUSEMOVE: {
         int idx = self->HitTest(HIWORD(lp));
         if (idx != self->m_hovered) {
-            self->m_hovered = idx;
-            InvalidateRect(hwnd, nullptr, FALSE);
+            self->SetHovered(idx);
             TRACKMOUSEEVENT tme{};
             tme.cbSize    = sizeof(tme);
             tme.dwFlags   = TME_LEAVE;
@@ -224,10 +258,12 @@ LRESULT CALLBACK Sidebar::SidebarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
     }
 
     case WM_MOUSELEAVE:
-        if (self->m_hovered >= 0) {
-            self->m_hovered = -1;
-            InvalidateRect(hwnd, nullptr, FALSE);
-        }
+        self->SetHovered(-1);
+        return 0;
+
+    case WM_DESTROY:
+        Animator::CancelOwner(self);
+        IconService::Cancel(self);
         return 0;
 
     case WM_ERASEBKGND:
@@ -4,6 +4,8 @@ namespace exo {
 
 int StatusBar::ScaledHeight() const { return Dpi::Scale(BASE_HEIGHT, m_dpi); }
 HWND StatusBar::Handle() const { return m_hwnd; }
+PaintSnapshot StatusBar::GetPaintStats() const { return m_paintStats.Snapshot(); }
+void StatusBar::ResetPaintStats() { m_paintStats.Reset(); }
 
 void StatusBar::Create(HWND parent, HINSTANCE hInst, int id) {
     m_parent = parent;
@@ -32,7 +34,7 @@ void StatusBar::Create(HWND parent, HINSTANCE hInst, int id) {
 
 void StatusBar::SetText(const wchar_t* text) {
     m_text = text ? text : L"";
-    InvalidateRect(m_hwnd, nullptr, FALSE);
+    m_frame.Apply(m_hwnd, PaintState());
 }
 
 void StatusBar::Resize(int x, int y, int w, int h) {
@@ -40,48 +42,42 @@ void StatusBar::Resize(int x, int y, int w, int h) {
     if (m_rt) m_rt->Resize(D2D1::SizeU(w, h));
 }
 
-void StatusBar::Repaint() { InvalidateRect(m_hwnd, nullptr, FALSE); }
+void StatusBar::Repaint() {
+    m_frame.Repaint(m_hwnd);
+}
 
 void StatusBar::UpdateDpi(int dpi) {
+    if (dpi != m_dpi) RenderContext::Invalidate();
     m_dpi = dpi;
     Repaint();
 }
 
-void StatusBar::OnPaint() {
-    if (!m_rt) {
+StatusBarPaint StatusBar::PaintState() const {
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    StatusBarPaint p;
+    p.text   = m_text;
+    p.dpi    = m_dpi;
+    p.width  = static_cast<float>(rc.right);
+    p.height = static_cast<float>(rc.bottom);
+    p.colors = Theme::PaintColors();
+    return p;
+}
+
+void StatusBar::OnPaint(DirtyRegion& dirty) {
+    PaintTimer timer(m_paintStats);
+    bool fresh = !m_rt;
+    if (fresh) {
         m_rt = RenderContext::CreateHwndTarget(m_hwnd);
         if (!m_rt) return;
     }
+    m_frame.Update(m_rt.Get(), dirty, fresh, PaintState());
 
-    auto& c = Theme::Colors();
-    float fontSize = Dpi::ScaleF(static_cast<float>(BASE_FONT_SIZE), m_dpi);
-    float padX = Dpi::ScaleF(static_cast<float>(BASE_PADDING_X), m_dpi);
-
-    m_rt->BeginDraw();
-    m_rt->Clear(ToD2DColor(c.statusBar));
-
-    auto size = m_rt->GetSize();
-
-    // Top border
-    ComPtr<ID2D1SolidColorBrush> borderBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.border), &borderBrush);
-    m_rt->DrawLine(
-        D2D1::Point2F(0, 0.5f),
-        D2D1::Point2F(size.width, 0.5f),
-        borderBrush.Get(), 1.0f
-    );
-
-    // Text
-    auto textFmt = RenderContext::CreateTextFormat(L"Segoe UI", fontSize);
-    ComPtr<ID2D1SolidColorBrush> textBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.statusBarText), &textBrush);
-
-    D2D1_RECT_F textRc = D2D1::RectF(padX, 0, size.width - padX, size.height);
-    m_rt->DrawText(m_text.c_str(), static_cast<UINT32>(m_text.length()),
-        textFmt.Get(), textRc, textBrush.Get());
-
-    HRESULT hr = m_rt->EndDraw();
-    if (hr == D2DERR_RECREATE_TARGET) m_rt.Reset();
+    DisplayListTarget target{ m_rt.Get(), &m_brushes, &m_labels, nullptr, nullptr, 0 };
+    if (!m_frame.Draw(m_hwnd, target, dirty, timer)) {
+        m_rt.Reset();
+        m_brushes.Reset();
+    }
 }
 
 LRESULT CALLBACK StatusBar::StatusProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
@@ -98,9 +94,11 @@ LRESULT CALLBACK StatusBar::StatusProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp
 
     switch (msg) {
     case WM_PAINT: {
+        DirtyRegion dirty;
+        dirty.Capture(hwnd);
         PAINTSTRUCT ps;
         BeginPaint(hwnd, &ps);
-        self->OnPaint();
+        self->OnPaint(dirty);
         EndPaint(hwnd, &ps);
         return 0;
     }
@@ -111,6 +109,7 @@ LRESULT CALLBACK StatusBar::StatusProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp
             GetClientRect(hwnd, &rc);
             self->m_rt->Resize(D2D1::SizeU(rc.right, rc.bottom));
         }
+        self->m_frame.Invalidate();
         return 0;
 
     case WM_ERASEBKGND:
@@ -1,13 +1,13 @@
 #include <exo/controls/toolbar.h>
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 namespace exo {
 
 int Toolbar::ScaledHeight() const { return Dpi::Scale(BASE_HEIGHT, m_dpi); }
 HWND Toolbar::Handle() const { return m_hwnd; }
-int Toolbar::BtnWidth(int idx) const { return Dpi::Scale(kButtons[idx].baseWidth, m_dpi); }
-int Toolbar::Pad() const { return Dpi::Scale(4, m_dpi); }
-int Toolbar::Margin() const { return Dpi::Scale(8, m_dpi); }
-int Toolbar::Height() const { return Dpi::Scale(BASE_HEIGHT, m_dpi); }
 
 void Toolbar::Create(HWND parent, HINSTANCE hInst, int id) {
     m_parent = parent;
@@ -30,6 +30,7 @@ void Toolbar::Create(HWND parent, HINSTANCE hInst, int id) {
     );
 
     m_dpi = Dpi::Get(m_hwnd);
+    UpdateLayout();
     CreateRenderTarget();
 }
 
@@ -38,116 +39,187 @@ void Toolbar::Resize(int x, int y, int w, int h) {
     if (m_rt) m_rt->Resize(D2D1::SizeU(w, h));
 }
 
-void Toolbar::Repaint() { InvalidateRect(m_hwnd, nullptr, FALSE); }
+void Toolbar::Repaint() {
+    m_frame.Repaint(m_hwnd);
+}
 
 void Toolbar::UpdateDpi(int dpi) {
+    if (dpi != m_dpi) RenderContext::Invalidate();
     m_dpi = dpi;
+    UpdateLayout();
+    Repaint();
+}
+
+void Toolbar::AddButton(const ToolbarButton& button) {
+    m_buttons.push_back(button);
+    m_iconsResolved  = false;
+    m_cachedIconSize = 0;
+    UpdateLayout();
     Repaint();
 }
 
+bool Toolbar::RemoveButton(uint16_t id) {
+    auto it = std::find_if(m_buttons.begin(), m_buttons.end(),
+                           [id](const Button& b) { return b.id == id; });
+    if (it == m_buttons.end()) return false;
+    m_buttons.erase(it);
+    m_hovered = -1;
+    m_iconsResolved  = false;
+    m_cachedIconSize = 0;
+    UpdateLayout();
+    Repaint();
+    return true;
+}
+
+const ToolbarLayout& Toolbar::Layout() const { return m_layout; }
+
+// Button rectangles only move with the client width, the DPI or the button
+// set; everything else reads the table.
+void Toolbar::UpdateLayout() {
+    RECT rc{};
+    if (m_hwnd) GetClientRect(m_hwnd, &rc);
+    m_layout.Build(m_buttons.data(), static_cast<int>(m_buttons.size()), m_dpi,
+                   static_cast<float>(rc.right));
+}
+
+// The atlas's bitmaps belong to the target that made them.
 void Toolbar::CreateRenderTarget() {
     m_rt = RenderContext::CreateHwndTarget(m_hwnd);
+    m_atlas.Reset();
+    std::fill(m_iconSlots.begin(), m_iconSlots.end(), -1);
+    m_cachedIconSize = 0;
 }
 
-D2D1_RECT_F Toolbar::ButtonRect(int idx, float totalWidth) const {
-    float pad    = static_cast<float>(Pad());
-    float margin = static_cast<float>(Margin());
-    float h      = static_cast<float>(Height());
-    float x      = margin;
-    float rightX = totalWidth - margin;
-
-    float rightBtns[kButtonCount];
-    for (int i = kButtonCount - 1; i >= 0; i--) {
-        if (kButtons[i].rightAlign) {
-            rightX -= static_cast<float>(BtnWidth(i)) + pad;
-            rightBtns[i] = rightX;
-        } else {
-            rightBtns[i] = -1;
-        }
+void Toolbar::ResolveIcons() {
+    if (m_iconsResolved) return;
+    int count = static_cast<int>(m_buttons.size());
+    m_iconIndex.assign(count, -1);
+    m_iconSlots.assign(count, -1);
+    for (int i = 0; i < count; i++) {
+        const auto& btn = m_buttons[i];
+        if ((!btn.label || !btn.label[0]) && btn.iconName)
+            m_iconIndex[i] = LucideIcons::Find(btn.iconName);
     }
+    m_iconsResolved = true;
+}
 
-    if (kButtons[idx].rightAlign) {
-        float bx = rightBtns[idx];
-        return D2D1::RectF(bx, pad, bx + static_cast<float>(BtnWidth(idx)), h - pad);
+void Toolbar::PrewarmDpis(const int* dpis, int count) {
+    ResolveIcons();
+    int current = Dpi::Scale(BASE_ICON_SIZE, m_dpi);
+    for (int d = 0; d < count; d++) {
+        int sz = Dpi::Scale(BASE_ICON_SIZE, dpis[d]);
+        if (sz != current)
+            IconService::Prewarm(m_iconIndex.data(), static_cast<int>(m_iconIndex.size()), sz);
     }
+}
 
-    for (int i = 0; i < idx; i++) {
-        if (!kButtons[i].rightAlign)
-            x += static_cast<float>(BtnWidth(i)) + pad;
+// As Sidebar::RebuildIconCache: the atlas, then Lucide's cache, then the
+// icon service, with the previous size drawn scaled meanwhile.
+void Toolbar::RebuildIconCache() {
+    if (!m_rt) return;
+    int sz = Dpi::Scale(BASE_ICON_SIZE, m_dpi);
+    if (sz == m_cachedIconSize) return;
+
+    ResolveIcons();
+    for (size_t i = 0; i < m_iconIndex.size(); i++) {
+        if (m_iconIndex[i] < 0) continue;
+        int slot = m_atlas.Find(m_iconIndex[i], sz);
+        if (slot < 0) {
+            if (const IconRaster* mask = IconService::RequestMask(this, m_iconIndex[i], sz)) {
+                slot = m_atlas.Add(m_rt.Get(), m_iconIndex[i], sz, *mask);
+                LucideIcons::Release(mask);
+            }
+        }
+        if (slot >= 0) m_iconSlots[i] = slot;
     }
-
-    if (idx > 0 && !kButtons[idx].toggle && kButtons[idx - 1].toggle)
-        x += margin;
-
-    return D2D1::RectF(x, pad, x + static_cast<float>(BtnWidth(idx)), h - pad);
+    m_cachedIconSize = sz;
 }
 
-int Toolbar::HitTest(int mx, int my, float totalWidth) {
-    for (int i = 0; i < kButtonCount; i++) {
-        auto r = ButtonRect(i, totalWidth);
-        if (mx >= r.left && mx <= r.right && my >= r.top && my <= r.bottom)
-            return i;
+void Toolbar::OnIconReady(int index, int size, const IconRaster* mask) {
+    if (!m_rt || !mask || size != m_cachedIconSize) return;
+    int slot = m_atlas.Add(m_rt.Get(), index, size, *mask);
+    if (slot < 0) return;
+    for (size_t i = 0; i < m_iconIndex.size(); i++) {
+        if (m_iconIndex[i] != index) continue;
+        m_iconSlots[i] = slot;
+        m_frame.InvalidateImage(m_hwnd, static_cast<uint32_t>(i));
     }
-    return -1;
 }
 
-void Toolbar::OnPaint() {
-    if (!m_rt) { CreateRenderTarget(); if (!m_rt) return; }
-
-    auto& c = Theme::Colors();
-    float fontSize = Dpi::ScaleF(static_cast<float>(BASE_FONT_SIZE), m_dpi);
-
-    m_rt->BeginDraw();
-    m_rt->Clear(ToD2DColor(c.toolbar));
+ToolbarPaint Toolbar::PaintState() const {
+    RECT rc;
+    GetClientRect(m_hwnd, &rc);
+    ToolbarPaint p;
+    p.buttons  = m_buttons.data();
+    p.count    = static_cast<int>(m_buttons.size());
+    p.layout   = &m_layout;
+    p.activeId = m_activeView;
+    p.hovered  = m_hovered;
+    p.dpi      = m_dpi;
+    p.width    = static_cast<float>(rc.right);
+    p.height   = static_cast<float>(rc.bottom);
+    p.colors   = Theme::PaintColors();
+    return p;
+}
 
-    auto size = m_rt->GetSize();
+int Toolbar::HitTest(int mx, int my) const {
+    return m_layout.HitTest(static_cast<float>(mx), static_cast<float>(my));
+}
 
-    // Bottom border
-    ComPtr<ID2D1SolidColorBrush> borderBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.border), &borderBrush);
-    m_rt->DrawLine(
-        D2D1::Point2F(0, size.height - 0.5f),
-        D2D1::Point2F(size.width, size.height - 0.5f),
-        borderBrush.Get(), 1.0f
-    );
+void Toolbar::Click(int idx) {
+    const auto& btn = m_buttons[idx];
+    if (btn.toggle && btn.id != m_activeView) {
+        m_activeView = btn.id;
+        m_frame.Apply(m_hwnd, PaintState());
+    }
+    SendMessageW(m_parent, WM_COMMAND,
+        MAKEWPARAM(btn.id, 0), reinterpret_cast<LPARAM>(m_hwnd));
+}
 
-    auto textFmt = RenderContext::CreateTextFormat(L"Segoe UI", fontSize);
-    if (textFmt) {
-        textFmt->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_CENTER);
-        textFmt->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_CENTER);
+// Overflowed buttons as a popup menu under the chevron; icon-only buttons
+// are listed by icon name.
+void Toolbar::ShowOverflowMenu() {
+    HMENU menu = CreatePopupMenu();
+    if (!menu) return;
+    for (int idx : m_layout.Overflow()) {
+        const auto& btn = m_buttons[idx];
+        std::wstring text = btn.label ? btn.label : L"";
+        if (text.empty() && btn.iconName)
+            text.assign(btn.iconName, btn.iconName + strlen(btn.iconName));
+        UINT flags = MF_STRING;
+        if (btn.toggle && btn.id == m_activeView) flags |= MF_CHECKED;
+        AppendMenuW(menu, flags, static_cast<UINT_PTR>(idx) + 1, text.c_str());
     }
 
-    ComPtr<ID2D1SolidColorBrush> textBrush, whiteBrush, hoverBrush, accentBrush;
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.text), &textBrush);
-    m_rt->CreateSolidColorBrush(D2D1::ColorF(1, 1, 1), &whiteBrush);
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.surfaceHover), &hoverBrush);
-    m_rt->CreateSolidColorBrush(ToD2DColor(c.accent), &accentBrush);
-
-    for (int i = 0; i < kButtonCount; i++) {
-        auto btnRc = ButtonRect(i, size.width);
-        bool active = (kButtons[i].toggle && kButtons[i].id == m_activeView);
-        bool hovered = (i == m_hovered);
-
-        if (active) {
-            m_rt->FillRoundedRectangle(
-                D2D1::RoundedRect(btnRc, 4.0f, 4.0f), accentBrush.Get());
-        } else if (hovered) {
-            m_rt->FillRoundedRectangle(
-                D2D1::RoundedRect(btnRc, 4.0f, 4.0f), hoverBrush.Get());
-            m_rt->DrawRoundedRectangle(
-                D2D1::RoundedRect(btnRc, 4.0f, 4.0f), borderBrush.Get(), 1.0f);
-        }
+    const DlRect& chevron = m_layout.ChevronRect();
+    POINT pt{ static_cast<LONG>(chevron.left), static_cast<LONG>(chevron.bottom) };
+    ClientToScreen(m_hwnd, &pt);
+    int cmd = TrackPopupMenu(menu, TPM_RETURNCMD | TPM_LEFTALIGN | TPM_TOPALIGN,
+                             pt.x, pt.y, 0, m_hwnd, nullptr);
+    DestroyMenu(menu);
+    if (cmd > 0) Click(cmd - 1);
+}
 
-        auto* brush = active ? whiteBrush.Get() : textBrush.Get();
-        const wchar_t* label = kButtons[i].label;
-        if (label && label[0] && textFmt) {
-            m_rt->DrawText(label, static_cast<UINT32>(wcslen(label)),
-                textFmt.Get(), btnRc, brush);
-        }
-    }
+PaintSnapshot Toolbar::GetPaintStats() const { return m_paintStats.Snapshot(); }
+void Toolbar::ResetPaintStats() { m_paintStats.Reset(); }
+const IconAtlasStats& Toolbar::GetAtlasStats() const { return m_atlas.Stats(); }
 
-    HRESULT hr = m_rt->EndDraw();
-    if (hr == D2DERR_RECREATE_TARGET) m_rt.Reset();
+void Toolbar::OnPaint(DirtyRegion& dirty) {
+    PaintTimer timer(m_paintStats);
+    bool fresh = !m_rt;
+    if (fresh) {
+        CreateRenderTarget();
+        if (!m_rt) return;
+    }
+    RebuildIconCache();
+    m_frame.Update(m_rt.Get(), dirty, fresh, PaintState());
+
+    DisplayListTarget target{ m_rt.Get(), &m_brushes, &m_labels, &m_atlas,
+                              m_iconSlots.data(), static_cast<int>(m_iconSlots.size()) };
+    if (!m_frame.Draw(m_hwnd, target, dirty, timer)) {
+        m_rt.Reset();
+        m_brushes.Reset();
+    }
 }
 
 LRESULT CALLBACK Toolbar::ToolbarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
@@ -164,9 +236,11 @@ LRESULT CALLBACK Toolbar::ToolbarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
 
     switch (msg) {
     case WM_PAINT: {
+        DirtyRegion dirty;
+        dirty.Capture(hwnd);
         PAINTSTRUCT ps;
         BeginPaint(hwnd, &ps);
-        self->OnPaint();
+        self->OnPaint(dirty);
         EndPaint(hwnd, &ps);
         return 0;
     }
@@ -177,29 +251,24 @@ LRESULT CALLBACK Toolbar::ToolbarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
             GetClientRect(hwnd, &rc);
             self->m_rt->Resize(D2D1::SizeU(rc.right, rc.bottom));
         }
+        self->UpdateLayout();
+        self->m_frame.Invalidate();
         return 0;
 
     case WM_LBUTTONDOWN: {
-        RECT rc;
-        GetClientRect(hwnd, &rc);
-        int idx = self->HitTest(LOWORD(lp), HIWORD(lp), static_cast<float>(rc.right));
-        if (idx >= 0) {
-            const auto& btn = kButtons[idx];
-            if (btn.toggle) self->m_activeView = btn.id;
-            InvalidateRect(hwnd, nullptr, FALSE);
-            SendMessageW(self->m_parent, WM_COMMAND,
-                MAKEWPARAM(btn.id, 0), reinterpret_cast<LPARAM>(hwnd));
-        }
+        int idx = self->HitTest(LOWORD(lp), HIWORD(lp));
+        if (idx >= 0)
+            self->Click(idx);
+        else if (idx == ToolbarLayout::kChevron)
+            self->ShowOverflowMenu();
         return 0;
     }
 
     case WM_MOUSEMOVE: {
-        RECT rc;
-        GetClientRect(hwnd, &rc);
-        int idx = self->HitTest(LOWORD(lp), HIWORD(lp), static_cast<float>(rc.right));
+        int idx = self->HitTest(LOWORD(lp), HIWORD(lp));
         if (idx != self->m_hovered) {
             self->m_hovered = idx;
-            InvalidateRect(hwnd, nullptr, FALSE);
+            self->m_frame.Apply(hwnd, self->PaintState());
             TRACKMOUSEEVENT tme{};
             tme.cbSize    = sizeof(tme);
             tme.dwFlags   = TME_LEAVE;
@@ -210,14 +279,18 @@ LRESULT CALLBACK Toolbar::ToolbarProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp)
     }
 
     case WM_MOUSELEAVE:
-        if (self->m_hovered >= 0) {
+        if (self->m_hovered != -1) {
             self->m_hovered = -1;
-            InvalidateRect(hwnd, nullptr, FALSE);
+            self->m_frame.Apply(hwnd, self->PaintState());
         }
         return 0;
 
     case WM_ERASEBKGND:
         return 1;
+
+    case WM_DESTROY:
+        IconService::Cancel(self);
+        return 0;
     }
 
     return DefWindowProcW(hwnd, msg, wp, lp);
@@ -0,0 +1,140 @@
+#include <exo/display_list.h>
+
+#include <algorithm>
+
+namespace exo {
+
+void DisplayList::Clear() {
+    m_commands.clear();
+    m_fonts.clear();
+    m_text.clear();
+}
+
+DlCommand& DisplayList::Push(DlOp op, const DlRect& r, uint32_t color) {
+    DlCommand c{};
+    c.op    = op;
+    c.color = color;
+    c.rect  = r;
+    m_commands.push_back(c);
+    return m_commands.back();
+}
+
+void DisplayList::FillRect(const DlRect& r, uint32_t color) {
+    Push(DlOp::FillRect, r, color);
+}
+
+void DisplayList::FillRoundedRect(const DlRect& r, float radius, uint32_t color) {
+    Push(DlOp::FillRoundedRect, r, color).radius = radius;
+}
+
+void DisplayList::StrokeRoundedRect(const DlRect& r, float radius, float width, uint32_t color) {
+    auto& c = Push(DlOp::StrokeRoundedRect, r, color);
+    c.radius = radius;
+    c.width  = width;
+}
+
+void DisplayList::Line(float x0, float y0, float x1, float y1, float width, uint32_t color) {
+    Push(DlOp::Line, DlRect{ x0, y0, x1, y1 }, color).width = width;
+}
+
+void DisplayList::Mask(const DlRect& r, int image, uint32_t color) {
+    Push(DlOp::Mask, r, color).image = static_cast<uint16_t>(image);
+}
+
+void DisplayList::Text(const DlRect& r, std::wstring_view text, int font, uint32_t color) {
+    if (text.empty()) return;
+    auto& c  = Push(DlOp::Text, r, color);
+    c.font   = static_cast<uint8_t>(font);
+    c.text   = static_cast<uint32_t>(m_text.size());
+    c.length = static_cast<uint32_t>(text.size());
+    m_text.append(text);
+}
+
+int DisplayList::Font(std::wstring_view family, float size, int weight, DlAlign align) {
+    for (size_t i = 0; i < m_fonts.size(); i++) {
+        const auto& f = m_fonts[i];
+        if (f.size == size && f.weight == weight && f.align == align && f.family == family)
+            return static_cast<int>(i);
+    }
+    m_fonts.push_back({ std::wstring(family), size, weight, align });
+    return static_cast<int>(m_fonts.size() - 1);
+}
+
+DlRect DisplayList::Bounds(const DlCommand& c) {
+    DlRect r = c.rect;
+    float grow = 1.0f;      // antialiased edge
+    switch (c.op) {
+    case DlOp::Line:
+        r = DlRect{ std::min(r.left, r.right), std::min(r.top, r.bottom),
+                    std::max(r.left, r.right), std::max(r.top, r.bottom) };
+        grow += c.width / 2;
+        break;
+    case DlOp::StrokeRoundedRect:
+        grow += c.width / 2;
+        break;
+    default:
+        break;
+    }
+    return DlRect{ r.left - grow, r.top - grow, r.right + grow, r.bottom + grow };
+}
+
+bool DisplayList::SameAt(const DisplayList& la, size_t i, const DisplayList& lb, size_t j) {
+    const auto& a = la.m_commands[i];
+    const auto& b = lb.m_commands[j];
+    if (a.op != b.op || a.color != b.color || a.radius != b.radius || a.width != b.width ||
+        a.rect.left != b.rect.left || a.rect.top != b.rect.top ||
+        a.rect.right != b.rect.right || a.rect.bottom != b.rect.bottom)
+        return false;
+    if (a.op == DlOp::Mask) return a.image == b.image;
+    if (a.op == DlOp::Text)
+        return la.TextOf(a) == lb.TextOf(b) && la.m_fonts[a.font] == lb.m_fonts[b.font];
+    return true;
+}
+
+bool DisplayList::operator==(const DisplayList& other) const {
+    if (m_commands.size() != other.m_commands.size()) return false;
+    for (size_t i = 0; i < m_commands.size(); i++)
+        if (!SameAt(*this, i, other, i)) return false;
+    return true;
+}
+
+void DisplayList::Diff(const DisplayList& before, const DisplayList& after,
+                       std::vector<DlRect>& out)
+{
+    if (before.m_commands.size() == after.m_commands.size()) {
+        for (size_t i = 0; i < after.m_commands.size(); i++) {
+            if (SameAt(before, i, after, i)) continue;
+            DlRect was = Bounds(before.m_commands[i]), now = Bounds(after.m_commands[i]);
+            out.push_back(now);
+            if (was.left != now.left || was.top != now.top ||
+                was.right != now.right || was.bottom != now.bottom)
+                out.push_back(was);
+        }
+        return;
+    }
+
+    // Commands were inserted or removed (a hover highlight, say): skip the
+    // common prefix and suffix and repaint the union of what lies between.
+    size_t nb = before.m_commands.size(), na = after.m_commands.size();
+    size_t head = 0;
+    while (head < nb && head < na && SameAt(before, head, after, head)) head++;
+    size_t tail = 0;
+    while (tail < nb - head && tail < na - head &&
+           SameAt(before, nb - 1 - tail, after, na - 1 - tail))
+        tail++;
+
+    bool any = false;
+    DlRect all{};
+    auto grow = [&](const DlCommand& c) {
+        DlRect b = Bounds(c);
+        all = any ? DlRect{ std::min(all.left, b.left), std::min(all.top, b.top),
+                            std::max(all.right, b.right), std::max(all.bottom, b.bottom) }
+                  : b;
+        any = true;
+    };
+    for (size_t i = head; i < nb - tail; i++) grow(before.m_commands[i]);
+    for (size_t i = head; i < na - tail; i++) grow(after.m_commands[i]);
+    if (any) out.push_back(all);
+}
+
+} // namespace exo
@@ -0,0 +1,37 @@
+#include <exo/dpi.h>
+
+#include <shellscalingapi.h>
+#include <algorithm>
+
+namespace exo {
+
+namespace {
+
+struct MonitorList {
+    int* out;
+    int  max;
+    int  count;
+};
+
+BOOL CALLBACK AddMonitor(HMONITOR monitor, HDC, LPRECT, LPARAM lp) {
+    auto& list = *reinterpret_cast<MonitorList*>(lp);
+    UINT dx = 0, dy = 0;
+    if (FAILED(GetDpiForMonitor(monitor, MDT_EFFECTIVE_DPI, &dx, &dy))) return TRUE;
+    int dpi = static_cast<int>(dx);
+    int* end = list.out + list.count;
+    if (std::find(list.out, end, dpi) == end && list.count < list.max)
+        list.out[list.count++] = dpi;
+    return TRUE;
+}
+
+} // namespace
+
+int Dpi::MonitorDpis(int* out, int max) {
+    MonitorList list{ out, max, 0 };
+    if (max > 0)
+        EnumDisplayMonitors(nullptr, nullptr, AddMonitor, reinterpret_cast<LPARAM>(&list));
+    std::sort(out, out + list.count);
+    return list.count;
+}
+
+} // namespace exo
@@ -0,0 +1,65 @@
+#include <exo/icon_atlas.h>
+
+#include <cstring>
+
+namespace exo {
+
+IconAtlas::IconAtlas(int pageSize, int maxPages) : m_layout(pageSize, maxPages) {}
+
+// Pages are created without contents; each upload writes its mask's
+// border too, so nothing a draw samples is left undefined.
+int IconAtlas::Add(ID2D1RenderTarget* rt, int index, int size, const IconRaster& mask) {
+    int slot = m_layout.Find(index, size);
+    if (slot >= 0) {
+        m_stats.reused++;
+        return slot;
+    }
+    if (!rt || !mask.pixels || mask.size != size) return -1;
+
+    slot = m_layout.Insert(index, size);
+    if (slot < 0) {
+        m_stats.full++;
+        return -1;
+    }
+    const AtlasSlot& s = m_layout.Slot(slot);
+    if (s.page == static_cast<int>(m_pages.size())) {
+        ComPtr<ID2D1Bitmap> page;
+        D2D1_BITMAP_PROPERTIES props = D2D1::BitmapProperties(
+            D2D1::PixelFormat(DXGI_FORMAT_A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED), 96.0f, 96.0f);
+        UINT32 side = static_cast<UINT32>(m_layout.PageSize());
+        if (FAILED(rt->CreateBitmap(D2D1::SizeU(side, side), nullptr, 0, props, &page))) {
+            // Give the slot back rather than leave a page without a bitmap
+            // behind it; the slots handed out so far stay valid.
+            m_layout.RemoveLast(index, size);
+            return -1;
+        }
+        m_pages.push_back(page);
+        m_stats.pages++;
+    }
+
+    constexpr int pad = MaskAtlas::kPadding;
+    int cell = size + 2 * pad;
+    m_scratch.assign(static_cast<size_t>(cell) * cell, 0);
+    for (int y = 0; y < size; y++) {
+        memcpy(&m_scratch[static_cast<size_t>(y + pad) * cell + pad],
+               mask.pixels + static_cast<size_t>(y) * mask.stride, size);
+    }
+    D2D1_RECT_U dest = D2D1::RectU(s.x - pad, s.y - pad, s.x - pad + cell, s.y - pad + cell);
+    m_pages[s.page]->CopyFromMemory(&dest, m_scratch.data(), cell);
+    m_stats.uploads++;
+    m_stats.uploadBytes += m_scratch.size();
+    return slot;
+}
+
+D2D1_RECT_F IconAtlas::Source(int slot) const {
+    const AtlasSlot& s = m_layout.Slot(slot);
+    return D2D1::RectF(static_cast<float>(s.x), static_cast<float>(s.y),
+                       static_cast<float>(s.x + s.size), static_cast<float>(s.y + s.size));
+}
+
+void IconAtlas::Reset() {
+    m_layout.Clear();
+    m_pages.clear();
+}
+
+} // namespace exo
@@ -0,0 +1,250 @@
+#include <exo/icon_service.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exo {
+
+// ── Queue state ─────────────────────────────────────────────
+// s_lock guards what the workers share; s_delivering and the message
+// window belong to the UI thread.
+namespace {
+
+constexpr UINT WM_EXO_ICONS = WM_APP + 0x3E2;
+constexpr int  kMaxWorkers  = 2;
+
+struct Job {
+    IconClient*       client;
+    int               index;
+    int               size;
+    bool              cancelled;
+    const IconRaster* raster;
+};
+
+struct Worker {
+    std::thread thread;
+    Job         job;
+    bool        busy;
+};
+
+std::mutex              s_lock;
+std::condition_variable s_wake;
+std::deque<Job>         s_queue;
+std::deque<Job>         s_prewarm;      // client == nullptr; after s_queue
+std::vector<Job>        s_done;
+Worker                  s_workers[kMaxWorkers];
+int                     s_workerCount = 0;
+bool                    s_posted = false;
+bool                    s_quit   = false;
+IconServiceStats        s_stats{};
+
+HWND             s_window = nullptr;
+std::vector<Job> s_delivering;
+
+bool Same(const Job& j, const IconClient* client, int index, int size) {
+    return j.client == client && j.index == index && j.size == size && !j.cancelled;
+}
+
+void WorkerLoop(Worker& self) {
+    std::unique_lock<std::mutex> lk(s_lock);
+    for (;;) {
+        s_wake.wait(lk, [] { return s_quit || !s_queue.empty() || !s_prewarm.empty(); });
+        if (s_quit) return;
+        std::deque<Job>& from = s_queue.empty() ? s_prewarm : s_queue;
+        self.job  = from.front();
+        self.busy = true;
+        from.pop_front();
+        lk.unlock();
+
+        auto t0 = std::chrono::steady_clock::now();
+        const IconRaster* raster = LucideIcons::AcquireMask(self.job.index, self.job.size);
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+
+        lk.lock();
+        self.busy = false;
+        s_stats.rasterUs += static_cast<uint64_t>(us);
+        if (!self.job.client) {
+            // Prewarm: the cache keeps it.
+            if (raster) s_stats.prewarmed++;
+            LucideIcons::Release(raster);
+            continue;
+        }
+        if (self.job.cancelled) {
+            LucideIcons::Release(raster);
+            continue;
+        }
+        self.job.raster = raster;
+        s_done.push_back(self.job);
+        // One message per batch: whatever finishes before the UI thread
+        // gets to it rides along.
+        if (!s_posted) {
+            s_posted = true;
+            PostMessageW(s_window, WM_EXO_ICONS, 0, 0);
+        }
+    }
+}
+
+// Hand finished masks to their clients. A client may cancel itself (or
+// another) from OnIconReady; its remaining entries are skipped.
+void Deliver() {
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        s_posted = false;
+        s_delivering.swap(s_done);
+    }
+    uint64_t delivered = 0;
+    for (size_t i = 0; i < s_delivering.size(); i++) {
+        Job& job = s_delivering[i];
+        if (job.client) {
+            job.client->OnIconReady(job.index, job.size, job.raster);
+            delivered++;
+        }
+        LucideIcons::Release(job.raster);
+    }
+    s_delivering.clear();
+
+    std::lock_guard<std::mutex> guard(s_lock);
+    s_stats.delivered += delivered;
+}
+
+LRESULT CALLBACK IconProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    if (msg != WM_EXO_ICONS) return DefWindowProcW(hwnd, msg, wp, lp);
+    Deliver();
+    return 0;
+}
+
+bool EnsureStarted() {
+    if (s_window) return true;
+
+    HINSTANCE hInst = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                       GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&IconProc), &hInst);
+
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.lpfnWndProc   = IconProc;
+    wc.hInstance     = hInst;
+    wc.lpszClassName = L"ExoIconService";
+    RegisterClassExW(&wc);
+
+    s_window = CreateWindowExW(0, L"ExoIconService", nullptr, 0, 0, 0, 0, 0,
+                               HWND_MESSAGE, nullptr, hInst, nullptr);
+    if (!s_window) return false;
+
+    // Leave a core for the UI thread.
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    s_workerCount = std::clamp(hw - 1, 1, kMaxWorkers);
+    s_quit = false;
+    for (int i = 0; i < s_workerCount; i++) {
+        s_workers[i].busy   = false;
+        s_workers[i].thread = std::thread(WorkerLoop, std::ref(s_workers[i]));
+    }
+    return true;
+}
+
+} // namespace
+
+const IconRaster* IconService::RequestMask(IconClient* client, int index, int size) {
+    if (const IconRaster* cached = LucideIcons::PeekMask(index, size)) {
+        std::lock_guard<std::mutex> guard(s_lock);
+        s_stats.cacheHits++;
+        return cached;
+    }
+    if (!EnsureStarted()) return nullptr;
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        auto pending = [&](const Job& j) { return Same(j, client, index, size); };
+        if (std::any_of(s_queue.begin(), s_queue.end(), pending) ||
+            std::any_of(s_done.begin(), s_done.end(), pending))
+            return nullptr;
+        for (int i = 0; i < s_workerCount; i++)
+            if (s_workers[i].busy && pending(s_workers[i].job)) return nullptr;
+
+        s_queue.push_back(Job{ client, index, size, false, nullptr });
+        s_stats.requests++;
+        s_stats.maxQueued = std::max<uint64_t>(s_stats.maxQueued, s_queue.size());
+    }
+    s_wake.notify_one();
+    return nullptr;
+}
+
+void IconService::Prewarm(const int* indices, int count, int size) {
+    if (count <= 0 || size <= 0 || !EnsureStarted()) return;
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        for (int i = 0; i < count; i++) {
+            if (indices[i] < 0) continue;
+            auto pending = [&](const Job& j) { return Same(j, nullptr, indices[i], size); };
+            if (std::any_of(s_prewarm.begin(), s_prewarm.end(), pending)) continue;
+            s_prewarm.push_back(Job{ nullptr, indices[i], size, false, nullptr });
+            queued++;
+        }
+    }
+    if (queued) s_wake.notify_all();
+}
+
+void IconService::Cancel(const IconClient* client) {
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        auto mine = [client](const Job& j) { return j.client == client; };
+        s_stats.cancelled += std::erase_if(s_queue, mine);
+        for (int i = 0; i < s_workerCount; i++) {
+            if (s_workers[i].busy && mine(s_workers[i].job) && !s_workers[i].job.cancelled) {
+                s_workers[i].job.cancelled = true;
+                s_stats.cancelled++;
+            }
+        }
+        for (auto& j : s_done) {
+            if (!mine(j)) continue;
+            LucideIcons::Release(j.raster);
+            s_stats.cancelled++;
+        }
+        std::erase_if(s_done, mine);
+    }
+    // Mid-delivery: skip what is left for it.
+    uint64_t skipped = 0;
+    for (auto& j : s_delivering) {
+        if (j.client != client) continue;
+        j.client = nullptr;
+        skipped++;
+    }
+    if (skipped) {
+        std::lock_guard<std::mutex> guard(s_lock);
+        s_stats.cancelled += skipped;
+    }
+}
+
+IconServiceStats IconService::Stats() {
+    std::lock_guard<std::mutex> guard(s_lock);
+    return s_stats;
+}
+
+void IconService::Shutdown() {
+    if (!s_window) return;
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        s_quit = true;
+    }
+    s_wake.notify_all();
+    for (int i = 0; i < s_workerCount; i++)
+        if (s_workers[i].thread.joinable()) s_workers[i].thread.join();
+
+    for (auto& j : s_done) LucideIcons::Release(j.raster);
+    s_done.clear();
+    s_queue.clear();
+    s_prewarm.clear();
+    s_workerCount = 0;
+    s_posted      = false;
+    DestroyWindow(s_window);
+    s_window = nullptr;
+}
+
+} // namespace exo
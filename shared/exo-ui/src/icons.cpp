@@ -5,9 +5,18 @@ namespace exo {
 HMODULE LucideIcons::s_dll       = nullptr;
 LucideIcons::FnGetCount  LucideIcons::s_getCount  = nullptr;
 LucideIcons::FnGetName   LucideIcons::s_getName   = nullptr;
+LucideIcons::FnFind      LucideIcons::s_find      = nullptr;
+LucideIcons::FnLoadPack  LucideIcons::s_loadPack  = nullptr;
 LucideIcons::FnRender    LucideIcons::s_render    = nullptr;
 LucideIcons::FnFree      LucideIcons::s_free      = nullptr;
 LucideIcons::FnCreateBmp LucideIcons::s_createBmp = nullptr;
+LucideIcons::FnAcquire   LucideIcons::s_acquire   = nullptr;
+LucideIcons::FnAcquireIx LucideIcons::s_acquireIx = nullptr;
+LucideIcons::FnAcqMask   LucideIcons::s_acquireMask = nullptr;
+LucideIcons::FnPeekMask  LucideIcons::s_peekMask  = nullptr;
+LucideIcons::FnRelease   LucideIcons::s_release   = nullptr;
+LucideIcons::FnSetBudget LucideIcons::s_setBudget = nullptr;
+LucideIcons::FnGetStats  LucideIcons::s_getStats  = nullptr;
 
 bool LucideIcons::Load() {
     if (s_dll) return true;
@@ -17,15 +26,28 @@ bool LucideIcons::Load() {
 
     s_getCount  = reinterpret_cast<FnGetCount>(GetProcAddress(s_dll, "LucideGetIconCount"));
     s_getName   = reinterpret_cast<FnGetName>(GetProcAddress(s_dll, "LucideGetIconName"));
+    s_find      = reinterpret_cast<FnFind>(GetProcAddress(s_dll, "LucideFindIcon"));
+    s_loadPack  = reinterpret_cast<FnLoadPack>(GetProcAddress(s_dll, "LucideLoadIconPack"));
     s_render    = reinterpret_cast<FnRender>(GetProcAddress(s_dll, "LucideRenderIcon"));
     s_free      = reinterpret_cast<FnFree>(GetProcAddress(s_dll, "LucideFree"));
     s_createBmp = reinterpret_cast<FnCreateBmp>(GetProcAddress(s_dll, "LucideCreateHBitmap"));
+    s_acquire   = reinterpret_cast<FnAcquire>(GetProcAddress(s_dll, "LucideAcquireIcon"));
+    s_acquireIx = reinterpret_cast<FnAcquireIx>(GetProcAddress(s_dll, "LucideAcquireIconIndex"));
+    s_acquireMask = reinterpret_cast<FnAcqMask>(GetProcAddress(s_dll, "LucideAcquireIconMaskIndex"));
+    s_peekMask  = reinterpret_cast<FnPeekMask>(GetProcAddress(s_dll, "LucidePeekIconMaskIndex"));
+    s_release   = reinterpret_cast<FnRelease>(GetProcAddress(s_dll, "LucideReleaseIcon"));
+    s_setBudget = reinterpret_cast<FnSetBudget>(GetProcAddress(s_dll, "LucideSetCacheBudget"));
+    s_getStats  = reinterpret_cast<FnGetStats>(GetProcAddress(s_dll, "LucideGetCacheStats"));
 
-    return s_getCount && s_getName && s_render && s_free && s_createBmp;
+    // s_peekMask is optional: without it every mask goes through the workers.
+    return s_getCount && s_getName && s_find && s_loadPack && s_render && s_free && s_createBmp
+        && s_acquire && s_acquireIx && s_acquireMask && s_release && s_setBudget && s_getStats;
 }
 
 int LucideIcons::GetCount() { return s_getCount ? s_getCount() : 0; }
 const char* LucideIcons::GetName(int idx) { return s_getName ? s_getName(idx) : nullptr; }
+int LucideIcons::Find(const char* name) { return s_find ? s_find(name) : -1; }
+int LucideIcons::LoadPack(const wchar_t* path) { return s_loadPack ? s_loadPack(path) : -1; }
 
 uint8_t* LucideIcons::Render(const char* name, int size, uint32_t color) {
     return s_render ? s_render(name, size, color) : nullptr;
@@ -37,4 +59,29 @@ HBITMAP LucideIcons::CreateBitmap(const char* name, int size, uint32_t color) {
     return s_createBmp ? static_cast<HBITMAP>(s_createBmp(name, size, color)) : nullptr;
 }
 
+const IconRaster* LucideIcons::Acquire(const char* name, int size, uint32_t color) {
+    return s_acquire ? s_acquire(name, size, color) : nullptr;
+}
+
+const IconRaster* LucideIcons::Acquire(int index, int size, uint32_t color) {
+    return s_acquireIx ? s_acquireIx(index, size, color) : nullptr;
+}
+
+const IconRaster* LucideIcons::AcquireMask(int index, int size) {
+    return s_acquireMask ? s_acquireMask(index, size) : nullptr;
+}
+
+const IconRaster* LucideIcons::PeekMask(int index, int size) {
+    return s_peekMask ? s_peekMask(index, size) : nullptr;
+}
+
+void LucideIcons::Release(const IconRaster* raster) { if (s_release) s_release(raster); }
+void LucideIcons::SetCacheBudget(size_t bytes) { if (s_setBudget) s_setBudget(bytes); }
+
+IconCacheStats LucideIcons::CacheStats() {
+    IconCacheStats stats{};
+    if (s_getStats) s_getStats(&stats);
+    return stats;
+}
+
 } // namespace exo
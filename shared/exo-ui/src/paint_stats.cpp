@@ -0,0 +1,195 @@
+#include <exo/paint_stats.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+namespace exo {
+
+namespace {
+
+constexpr auto kRelaxed = std::memory_order_relaxed;
+
+// "850us", "12.4ms", "1.20s".
+const char* FormatUs(char (&buf)[24], double us) {
+    if (us < 1000.0)         snprintf(buf, sizeof(buf), "%.0fus", us);
+    else if (us < 1000000.0) snprintf(buf, sizeof(buf), "%.1fms", us / 1000.0);
+    else                     snprintf(buf, sizeof(buf), "%.2fs", us / 1000000.0);
+    return buf;
+}
+
+const char* FormatRate(char (&buf)[24], double perSecond) {
+    if (perSecond < 0) snprintf(buf, sizeof(buf), "-/s");
+    else               snprintf(buf, sizeof(buf), "%.1f/s", perSecond);
+    return buf;
+}
+
+unsigned long long Ull(uint64_t v) { return static_cast<unsigned long long>(v); }
+
+} // namespace
+
+// ── PaintSnapshot ───────────────────────────────────────────
+
+int PaintSnapshot::BucketFor(uint64_t microseconds) {
+    int bucket = 0;
+    uint64_t limit = kFirstBucketUs;
+    while (bucket < kBuckets - 1 && microseconds >= limit) {
+        bucket++;
+        limit <<= 1;
+    }
+    return bucket;
+}
+
+uint64_t PaintSnapshot::BucketLimitUs(int bucket) {
+    if (bucket >= kBuckets - 1) return UINT64_MAX;
+    return kFirstBucketUs << bucket;
+}
+
+double PaintSnapshot::MeanUs() const {
+    return paints ? static_cast<double>(microseconds) / static_cast<double>(paints) : 0.0;
+}
+
+uint64_t PaintSnapshot::PercentileUs(double p) const {
+    uint64_t total = 0;
+    for (uint64_t n : buckets) total += n;
+    if (total == 0) return 0;
+
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        seen += buckets[b];
+        if (seen >= rank) return std::min(BucketLimitUs(b), maxMicroseconds);
+    }
+    return maxMicroseconds;
+}
+
+// ── PaintRecorder ───────────────────────────────────────────
+
+void PaintRecorder::Record(uint64_t microseconds, uint64_t pixels, uint64_t items) {
+    m_paints.fetch_add(1, kRelaxed);
+    m_pixels.fetch_add(pixels, kRelaxed);
+    m_items.fetch_add(items, kRelaxed);
+    m_microseconds.fetch_add(microseconds, kRelaxed);
+    m_buckets[PaintSnapshot::BucketFor(microseconds)].fetch_add(1, kRelaxed);
+
+    uint64_t max = m_maxMicroseconds.load(kRelaxed);
+    while (microseconds > max && !m_maxMicroseconds.compare_exchange_weak(max, microseconds, kRelaxed)) {}
+}
+
+void PaintRecorder::RecordRecreate() {
+    m_recreates.fetch_add(1, kRelaxed);
+}
+
+PaintSnapshot PaintRecorder::Snapshot() const {
+    PaintSnapshot s{};
+    s.paints          = m_paints.load(kRelaxed);
+    s.pixels          = m_pixels.load(kRelaxed);
+    s.items           = m_items.load(kRelaxed);
+    s.microseconds    = m_microseconds.load(kRelaxed);
+    s.maxMicroseconds = m_maxMicroseconds.load(kRelaxed);
+    s.recreates       = m_recreates.load(kRelaxed);
+    for (int b = 0; b < PaintSnapshot::kBuckets; b++) s.buckets[b] = m_buckets[b].load(kRelaxed);
+    return s;
+}
+
+void PaintRecorder::Reset() {
+    m_paints.store(0, kRelaxed);
+    m_pixels.store(0, kRelaxed);
+    m_items.store(0, kRelaxed);
+    m_microseconds.store(0, kRelaxed);
+    m_maxMicroseconds.store(0, kRelaxed);
+    m_recreates.store(0, kRelaxed);
+    for (auto& b : m_buckets) b.store(0, kRelaxed);
+}
+
+// ── ProfileReport ───────────────────────────────────────────
+
+void ProfileReport::Begin(double nowMs) {
+    m_elapsedMs = m_started ? std::max(nowMs - m_now, 0.0) : 0.0;
+    m_now       = nowMs;
+    m_started   = true;
+    m_lines.clear();
+}
+
+double ProfileReport::PerSecond(const std::string& key, uint64_t total) {
+    double rate = -1.0;
+    auto it = m_previous.find(key);
+    // A total below the last one was reset in between: no rate this time.
+    if (it != m_previous.end() && m_elapsedMs > 0 && total >= it->second)
+        rate = static_cast<double>(total - it->second) * 1000.0 / m_elapsedMs;
+    m_previous[key] = total;
+    return rate;
+}
+
+void ProfileReport::Line(const char* format, ...) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    m_lines.emplace_back(buf);
+}
+
+void ProfileReport::Paint(const char* name, const PaintSnapshot& s) {
+    char rate[24], mean[24], p50[24], p95[24], max[24];
+    FormatRate(rate, PerSecond(std::string("paint:") + name, s.paints));
+    double pixels = s.paints ? static_cast<double>(s.pixels) / static_cast<double>(s.paints) : 0.0;
+    Line("%-10s %7llu paints %8s  mean %7s  p50 %7s  p95 %7s  max %7s  %8.0f px  %llu recreated",
+         name, Ull(s.paints), rate,
+         FormatUs(mean, s.MeanUs()),
+         FormatUs(p50, static_cast<double>(s.PercentileUs(0.5))),
+         FormatUs(p95, static_cast<double>(s.PercentileUs(0.95))),
+         FormatUs(max, static_cast<double>(s.maxMicroseconds)),
+         pixels, Ull(s.recreates));
+}
+
+void ProfileReport::Histogram(const char* name, const PaintSnapshot& s) {
+    constexpr int kBarWidth = 40;
+    uint64_t peak = 0;
+    for (uint64_t n : s.buckets) peak = std::max(peak, n);
+    if (peak == 0) return;
+
+    Line("%s paint times:", name);
+    for (int b = 0; b < PaintSnapshot::kBuckets; b++) {
+        if (s.buckets[b] == 0) continue;
+        char limit[24], bar[kBarWidth + 1];
+        if (b == PaintSnapshot::kBuckets - 1) snprintf(limit, sizeof(limit), "longer");
+        else FormatUs(limit, static_cast<double>(PaintSnapshot::BucketLimitUs(b)));
+        int len = std::max(1, static_cast<int>(s.buckets[b] * kBarWidth / peak));
+        std::fill_n(bar, len, '#');
+        bar[len] = '\0';
+        Line("  < %-7s %8llu %5.1f%%  %s", limit, Ull(s.buckets[b]),
+             100.0 * static_cast<double>(s.buckets[b]) / static_cast<double>(s.paints ? s.paints : 1), bar);
+    }
+}
+
+void ProfileReport::Hits(const char* name, uint64_t hits, uint64_t misses) {
+    char rate[24];
+    FormatRate(rate, PerSecond(std::string("miss:") + name, misses));
+    uint64_t total = hits + misses;
+    double percent = total ? 100.0 * static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    Line("%-10s %5.1f%% hit  %9llu hits %7llu misses %8s", name, percent, Ull(hits), Ull(misses), rate);
+}
+
+void ProfileReport::Rate(const char* name, uint64_t total) {
+    char rate[24];
+    FormatRate(rate, PerSecond(std::string("rate:") + name, total));
+    Line("%-10s %9llu %8s", name, Ull(total), rate);
+}
+
+void ProfileReport::Note(const char* text) {
+    m_lines.emplace_back(text);
+}
+
+std::string ProfileReport::Text() const {
+    std::string text;
+    for (const auto& line : m_lines) {
+        text += line;
+        text += '\n';
+    }
+    return text;
+}
+
+} // namespace exo
@@ -1,7 +1,51 @@
 #include <exo/render.h>
+#include <exo/icon_atlas.h>
+#include <exo/theme.h>
+
+#include <cmath>
+#include <utility>
 
 namespace exo {
 
+// ── Shared resource caches ──────────────────────────────────
+// Touched only from the UI thread, like the single-threaded D2D factory.
+namespace {
+
+struct TextFormatEntry {
+    std::wstring              family;
+    float                     size;
+    DWRITE_FONT_WEIGHT        weight;
+    DWRITE_TEXT_ALIGNMENT     alignment;
+    ComPtr<IDWriteTextFormat> format;
+};
+
+std::vector<TextFormatEntry> s_textFormats;
+uint32_t                     s_generation = 1;
+RenderCacheStats             s_stats{};
+
+uint32_t PackColor(const D2D1_COLOR_F& c) {
+    auto channel = [](float v) {
+        return static_cast<uint32_t>(v <= 0.0f ? 0 : v >= 1.0f ? 255 : v * 255.0f + 0.5f);
+    };
+    return channel(c.r) << 24 | channel(c.g) << 16 | channel(c.b) << 8 | channel(c.a);
+}
+
+D2D1_COLOR_F FromArgb(uint32_t argb) {
+    return D2D1::ColorF(argb & 0xFFFFFF, static_cast<float>(argb >> 24) / 255.0f);
+}
+
+D2D1_RECT_F FromDl(const DlRect& r) { return D2D1::RectF(r.left, r.top, r.right, r.bottom); }
+
+DWRITE_TEXT_ALIGNMENT FromDl(DlAlign align) {
+    switch (align) {
+    case DlAlign::Center:   return DWRITE_TEXT_ALIGNMENT_CENTER;
+    case DlAlign::Trailing: return DWRITE_TEXT_ALIGNMENT_TRAILING;
+    default:                return DWRITE_TEXT_ALIGNMENT_LEADING;
+    }
+}
+
+} // namespace
+
 ComPtr<ID2D1Factory> RenderContext::s_d2dFactory;
 ComPtr<IDWriteFactory> RenderContext::s_dwriteFactory;
 
@@ -32,12 +76,23 @@ ComPtr<ID2D1HwndRenderTarget> RenderContext::CreateHwndTarget(HWND hwnd) {
     auto props = D2D1::RenderTargetProperties();
     props.dpiX = 96.0f;
     props.dpiY = 96.0f;
-    auto hwndProps = D2D1::HwndRenderTargetProperties(hwnd, size);
+    auto hwndProps = D2D1::HwndRenderTargetProperties(
+        hwnd, size, D2D1_PRESENT_OPTIONS_RETAIN_CONTENTS);
 
     s_d2dFactory->CreateHwndRenderTarget(props, hwndProps, &target);
     return target;
 }
 
+void RenderContext::InvalidateArea(HWND hwnd, const D2D1_RECT_F& area) {
+    RECT rc{
+        static_cast<LONG>(floorf(area.left)) - 1,
+        static_cast<LONG>(floorf(area.top)) - 1,
+        static_cast<LONG>(ceilf(area.right)) + 1,
+        static_cast<LONG>(ceilf(area.bottom)) + 1,
+    };
+    InvalidateRect(hwnd, &rc, FALSE);
+}
+
 ComPtr<ID2D1Bitmap> RenderContext::CreateBitmapFromRGBA(
     ID2D1RenderTarget* rt, const uint8_t* rgba, int width, int height)
 {
@@ -58,6 +113,38 @@ ComPtr<ID2D1Bitmap> RenderContext::CreateBitmapFromRGBA(
     return bitmap;
 }
 
+ComPtr<ID2D1Bitmap> RenderContext::CreateAlphaMask(
+    ID2D1RenderTarget* rt, const uint8_t* mask, int width, int height, int stride)
+{
+    if (!rt || !mask || width <= 0 || height <= 0) return nullptr;
+
+    ComPtr<ID2D1Bitmap> bitmap;
+    D2D1_BITMAP_PROPERTIES bmpProps = D2D1::BitmapProperties(
+        D2D1::PixelFormat(DXGI_FORMAT_A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED)
+    );
+    bmpProps.dpiX = 96.0f;
+    bmpProps.dpiY = 96.0f;
+
+    rt->CreateBitmap(
+        D2D1::SizeU(width, height),
+        mask, stride,
+        bmpProps, &bitmap
+    );
+    return bitmap;
+}
+
+void RenderContext::FillIconMask(
+    ID2D1RenderTarget* rt, ID2D1Bitmap* mask, ID2D1Brush* brush, const D2D1_RECT_F& dest)
+{
+    if (!rt || !mask || !brush) return;
+
+    // FillOpacityMask requires aliased mode; the mask carries the AA.
+    D2D1_ANTIALIAS_MODE mode = rt->GetAntialiasMode();
+    rt->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+    rt->FillOpacityMask(mask, brush, D2D1_OPACITY_MASK_CONTENT_GRAPHICS, &dest, nullptr);
+    rt->SetAntialiasMode(mode);
+}
+
 ComPtr<IDWriteTextFormat> RenderContext::CreateTextFormat(
     const wchar_t* fontFamily, float size, DWRITE_FONT_WEIGHT weight)
 {
@@ -74,4 +161,335 @@ ComPtr<IDWriteTextFormat> RenderContext::CreateTextFormat(
     return fmt;
 }
 
+IDWriteTextFormat* RenderContext::TextFormat(
+    const wchar_t* fontFamily, float size, DWRITE_FONT_WEIGHT weight,
+    DWRITE_TEXT_ALIGNMENT alignment)
+{
+    for (auto& e : s_textFormats) {
+        if (e.size == size && e.weight == weight && e.alignment == alignment &&
+            e.family == fontFamily) {
+            s_stats.textFormatHits++;
+            return e.format.Get();
+        }
+    }
+
+    s_stats.textFormatMisses++;
+    auto fmt = CreateTextFormat(fontFamily, size, weight);
+    if (!fmt) return nullptr;
+    fmt->SetTextAlignment(alignment);
+    s_textFormats.push_back({ fontFamily, size, weight, alignment, fmt });
+    return fmt.Get();
+}
+
+// ── Display list replay ─────────────────────────────────────
+
+uint64_t RenderContext::Replay(const DisplayListTarget& target, const DisplayList& list,
+                               const D2D1_RECT_F& clip)
+{
+    ID2D1RenderTarget* rt = target.rt;
+    DlRect area{ clip.left, clip.top, clip.right, clip.bottom };
+    uint64_t drawn = 0;
+    D2D1_ANTIALIAS_MODE mode = D2D1_ANTIALIAS_MODE_PER_PRIMITIVE;
+    bool aliased = false;
+
+    for (const auto& c : list.Commands()) {
+        if (!DisplayList::Bounds(c).Intersects(area)) continue;
+        auto* brush = target.brushes->Get(rt, FromArgb(c.color));
+        D2D1_RECT_F r = FromDl(c.rect);
+        if (aliased && c.op != DlOp::Mask) {
+            rt->SetAntialiasMode(mode);
+            aliased = false;
+        }
+
+        switch (c.op) {
+        case DlOp::FillRect:
+            rt->FillRectangle(r, brush);
+            break;
+        case DlOp::FillRoundedRect:
+            rt->FillRoundedRectangle(D2D1::RoundedRect(r, c.radius, c.radius), brush);
+            break;
+        case DlOp::StrokeRoundedRect:
+            rt->DrawRoundedRectangle(D2D1::RoundedRect(r, c.radius, c.radius), brush, c.width);
+            break;
+        case DlOp::Line:
+            rt->DrawLine(D2D1::Point2F(r.left, r.top), D2D1::Point2F(r.right, r.bottom),
+                         brush, c.width);
+            break;
+        case DlOp::Mask: {
+            int slot = c.image < target.maskCount ? target.maskSlots[c.image] : -1;
+            if (slot < 0) break;
+            // FillOpacityMask requires aliased mode; it stays set across a
+            // run of icons, which all sample the same atlas page.
+            if (!aliased) {
+                mode    = rt->GetAntialiasMode();
+                aliased = true;
+                rt->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+            }
+            D2D1_RECT_F source = target.atlas->Source(slot);
+            rt->FillOpacityMask(target.atlas->Page(target.atlas->Slot(slot).page), brush,
+                                D2D1_OPACITY_MASK_CONTENT_GRAPHICS, &r, &source);
+            break;
+        }
+        case DlOp::Text: {
+            const DlFont& font = list.FontAt(c.font);
+            auto* format = TextFormat(font.family.c_str(), font.size,
+                                      static_cast<DWRITE_FONT_WEIGHT>(font.weight),
+                                      FromDl(font.align));
+            if (format) target.labels->Draw(rt, list.TextOf(c), format, r, brush);
+            break;
+        }
+        }
+        drawn++;
+    }
+    if (aliased) rt->SetAntialiasMode(mode);
+    return drawn;
+}
+
+void RenderContext::Invalidate() {
+    s_textFormats.clear();
+    s_generation++;
+    s_stats.invalidations++;
+}
+
+uint32_t RenderContext::Generation() { return s_generation; }
+RenderCacheStats RenderContext::CacheStats() { return s_stats; }
+
+// ── BrushCache ──────────────────────────────────────────────
+
+ID2D1SolidColorBrush* BrushCache::Get(ID2D1RenderTarget* rt, const D2D1_COLOR_F& color) {
+    if (!rt) return nullptr;
+    if (m_target.Get() != rt || m_generation != s_generation) {
+        m_entries.clear();
+        m_target     = rt;
+        m_generation = s_generation;
+    }
+
+    uint32_t key = PackColor(color);
+    for (auto& e : m_entries) {
+        if (e.key == key) {
+            s_stats.brushHits++;
+            return e.brush.Get();
+        }
+    }
+
+    s_stats.brushMisses++;
+    ComPtr<ID2D1SolidColorBrush> brush;
+    if (FAILED(rt->CreateSolidColorBrush(color, &brush))) return nullptr;
+    m_entries.push_back({ key, brush });
+    return brush.Get();
+}
+
+void BrushCache::Reset() {
+    m_entries.clear();
+    m_target.Reset();
+}
+
+// ── LabelCache ──────────────────────────────────────────────
+
+size_t LabelCache::KeyHash::operator()(const KeyView& k) const {
+    return std::hash<std::wstring_view>{}(k.text) * 31 + std::hash<const void*>{}(k.format);
+}
+
+IDWriteTextLayout* LabelCache::Get(std::wstring_view text, IDWriteTextFormat* format,
+                                   float maxWidth, float maxHeight)
+{
+    if (!format) return nullptr;
+    if (m_generation != s_generation) {
+        Reset();
+        m_generation = s_generation;
+    }
+
+    auto it = m_index.find(KeyView{ text, format });
+    if (it != m_index.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        Entry& e = *it->second;
+        if (e.maxWidth != maxWidth || e.maxHeight != maxHeight) {
+            // Shaping is kept; only line breaking and alignment rerun.
+            e.layout->SetMaxWidth(maxWidth);
+            e.layout->SetMaxHeight(maxHeight);
+            e.maxWidth  = maxWidth;
+            e.maxHeight = maxHeight;
+            s_stats.layoutResizes++;
+        } else {
+            s_stats.layoutHits++;
+        }
+        return e.layout.Get();
+    }
+
+    s_stats.layoutMisses++;
+    ComPtr<IDWriteTextLayout> layout;
+    if (FAILED(RenderContext::DWrite()->CreateTextLayout(
+            text.data(), static_cast<UINT32>(text.size()), format,
+            maxWidth, maxHeight, &layout)))
+        return nullptr;
+
+    m_entries.push_front(Entry{ std::wstring(text), format, layout, maxWidth, maxHeight });
+    m_index.emplace(KeyView{ m_entries.front().text, format }, m_entries.begin());
+    Trim();
+    return layout.Get();
+}
+
+void LabelCache::Draw(ID2D1RenderTarget* rt, std::wstring_view text, IDWriteTextFormat* format,
+                      const D2D1_RECT_F& rect, ID2D1Brush* brush)
+{
+    if (!rt || !brush || text.empty()) return;
+    auto* layout = Get(text, format, rect.right - rect.left, rect.bottom - rect.top);
+    if (layout) rt->DrawTextLayout(D2D1::Point2F(rect.left, rect.top), layout, brush);
+}
+
+void LabelCache::SetCapacity(size_t capacity) {
+    m_capacity = capacity ? capacity : 1;
+    Trim();
+}
+
+// The layout just returned is at the front, so it survives until the
+// next Get even at capacity one.
+void LabelCache::Trim() {
+    while (m_entries.size() > m_capacity) {
+        const Entry& e = m_entries.back();
+        m_index.erase(KeyView{ e.text, e.format.Get() });
+        m_entries.pop_back();
+        s_stats.layoutEvictions++;
+    }
+}
+
+void LabelCache::Reset() {
+    m_index.clear();
+    m_entries.clear();
+}
+
+// ── PaintTimer ──────────────────────────────────────────────
+
+namespace {
+
+int64_t Ticks() {
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return t.QuadPart;
+}
+
+int64_t TicksPerSecond() {
+    static const int64_t frequency = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return f.QuadPart;
+    }();
+    return frequency;
+}
+
+} // namespace
+
+PaintTimer::PaintTimer(PaintRecorder& recorder) : m_recorder(recorder), m_start(Ticks()) {}
+
+PaintTimer::~PaintTimer() {
+    m_recorder.Record(static_cast<uint64_t>((Ticks() - m_start) * 1000000 / TicksPerSecond()), pixels, items);
+    if (recreated) m_recorder.RecordRecreate();
+}
+
+// ── RetainedFrame ───────────────────────────────────────────
+
+void RetainedFrame::Repaint(HWND hwnd) {
+    m_valid = false;
+    InvalidateRect(hwnd, nullptr, FALSE);
+}
+
+bool RetainedFrame::NeedsFullPaint(bool freshTarget) {
+    if (m_themeVersion != Theme::Version()) {
+        m_themeVersion = Theme::Version();
+        m_valid        = false;
+        return true;
+    }
+    return freshTarget;
+}
+
+void RetainedFrame::InvalidateChanges(HWND hwnd) {
+    m_changed.clear();
+    DisplayList::Diff(m_list, m_next, m_changed);
+    for (const auto& r : m_changed)
+        RenderContext::InvalidateArea(hwnd, D2D1::RectF(r.left, r.top, r.right, r.bottom));
+    std::swap(m_list, m_next);
+}
+
+bool RetainedFrame::Draw(HWND hwnd, const DisplayListTarget& target, const DirtyRegion& dirty,
+                         PaintTimer& timer)
+{
+    ID2D1RenderTarget* rt = target.rt;
+    rt->BeginDraw();
+    for (int r = 0; r < dirty.Count(); r++) {
+        rt->PushAxisAlignedClip(dirty.Rect(r), D2D1_ANTIALIAS_MODE_ALIASED);
+        timer.items += RenderContext::Replay(target, m_list, dirty.Rect(r));
+        rt->PopAxisAlignedClip();
+    }
+    timer.pixels += dirty.Area();
+
+    if (rt->EndDraw() != D2DERR_RECREATE_TARGET) return true;
+    timer.recreated = true;
+    Repaint(hwnd);
+    return false;
+}
+
+void RetainedFrame::InvalidateImage(HWND hwnd, uint32_t image) const {
+    if (!m_valid) return;
+    for (const auto& c : m_list.Commands()) {
+        if (c.op == DlOp::Mask && c.image == image)
+            RenderContext::InvalidateArea(hwnd,
+                D2D1::RectF(c.rect.left, c.rect.top, c.rect.right, c.rect.bottom));
+    }
+}
+
+// ── DirtyRegion ─────────────────────────────────────────────
+
+void DirtyRegion::Capture(HWND hwnd) {
+    m_count = 0;
+    HRGN rgn = CreateRectRgn(0, 0, 0, 0);
+    if (!rgn) return;
+
+    int kind = GetUpdateRgn(hwnd, rgn, FALSE);
+    if (kind == SIMPLEREGION || kind == COMPLEXREGION) {
+        // Small regions fit the stack buffer; anything bigger is painted
+        // as its bounding box.
+        alignas(RGNDATA) uint8_t buffer[sizeof(RGNDATAHEADER) + kMaxRects * sizeof(RECT)];
+        auto* data = reinterpret_cast<RGNDATA*>(buffer);
+        DWORD bytes = GetRegionData(rgn, 0, nullptr);
+        if (bytes && bytes <= sizeof(buffer) && GetRegionData(rgn, bytes, data) == bytes) {
+            auto* rects = reinterpret_cast<const RECT*>(data->Buffer);
+            for (DWORD i = 0; i < data->rdh.nCount && m_count < kMaxRects; i++) {
+                m_rects[m_count++] = D2D1::RectF(
+                    static_cast<float>(rects[i].left),  static_cast<float>(rects[i].top),
+                    static_cast<float>(rects[i].right), static_cast<float>(rects[i].bottom));
+            }
+        } else {
+            RECT box;
+            GetRgnBox(rgn, &box);
+            SetAll(D2D1::RectF(
+                static_cast<float>(box.left),  static_cast<float>(box.top),
+                static_cast<float>(box.right), static_cast<float>(box.bottom)));
+        }
+    }
+    DeleteObject(rgn);
+}
+
+void DirtyRegion::SetAll(const D2D1_RECT_F& area) {
+    m_rects[0] = area;
+    m_count    = 1;
+}
+
+bool DirtyRegion::Intersects(const D2D1_RECT_F& r) const {
+    for (int i = 0; i < m_count; i++) {
+        const auto& d = m_rects[i];
+        if (r.left < d.right && d.left < r.right && r.top < d.bottom && d.top < r.bottom)
+            return true;
+    }
+    return false;
+}
+
+uint64_t DirtyRegion::Area() const {
+    uint64_t area = 0;
+    for (int i = 0; i < m_count; i++) {
+        const auto& d = m_rects[i];
+        area += static_cast<uint64_t>(d.right - d.left) * static_cast<uint64_t>(d.bottom - d.top);
+    }
+    return area;
+}
+
 } // namespace exo
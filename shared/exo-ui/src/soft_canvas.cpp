@@ -0,0 +1,203 @@
+#include <exo/soft_canvas.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace exo {
+
+namespace {
+
+float Clamp01(float v) { return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v; }
+
+// Signed distance from (px, py) to a rounded box; negative inside.
+float RoundedBoxDistance(float px, float py, const DlRect& r, float radius) {
+    float cx = (r.left + r.right) / 2, cy = (r.top + r.bottom) / 2;
+    float hx = (r.right - r.left) / 2, hy = (r.bottom - r.top) / 2;
+    radius = std::min(radius, std::min(hx, hy));
+    float qx = std::fabs(px - cx) - hx + radius;
+    float qy = std::fabs(py - cy) - hy + radius;
+    float outside = std::hypot(std::max(qx, 0.0f), std::max(qy, 0.0f));
+    return outside + std::min(std::max(qx, qy), 0.0f) - radius;
+}
+
+// Fraction of the pixel span [p, p + 1) inside [lo, hi).
+float Overlap(float p, float lo, float hi) {
+    return Clamp01(std::min(p + 1.0f, hi) - std::max(p, lo));
+}
+
+// Placeholder glyph metrics, in ems.
+constexpr float kAdvance   = 0.55f;
+constexpr float kBoxInset  = 0.08f;
+constexpr float kBoxHeight = 0.7f;
+
+} // namespace
+
+SoftwareCanvas::SoftwareCanvas(int width, int height)
+    : m_width(std::max(width, 0)), m_height(std::max(height, 0)),
+      m_pixels(static_cast<size_t>(m_width) * m_height * 4) {}
+
+uint32_t SoftwareCanvas::Pixel(int x, int y) const {
+    const uint8_t* p = &m_pixels[(static_cast<size_t>(y) * m_width + x) * 4];
+    return uint32_t(p[3]) << 24 | uint32_t(p[0]) << 16 | uint32_t(p[1]) << 8 | p[2];
+}
+
+void SoftwareCanvas::Clear(uint32_t color) {
+    float a = (color >> 24) / 255.0f;
+    uint8_t px[4] = {
+        static_cast<uint8_t>(((color >> 16) & 0xFF) * a + 0.5f),
+        static_cast<uint8_t>(((color >>  8) & 0xFF) * a + 0.5f),
+        static_cast<uint8_t>(( color        & 0xFF) * a + 0.5f),
+        static_cast<uint8_t>(color >> 24),
+    };
+    for (size_t i = 0; i < m_pixels.size(); i += 4)
+        std::copy(px, px + 4, &m_pixels[i]);
+}
+
+SoftwareCanvas::Span SoftwareCanvas::Clip(const DlRect& r, const Span& clip) const {
+    return Span{
+        std::max(clip.x0, static_cast<int>(std::floor(r.left))),
+        std::max(clip.y0, static_cast<int>(std::floor(r.top))),
+        std::min(clip.x1, static_cast<int>(std::ceil(r.right))),
+        std::min(clip.y1, static_cast<int>(std::ceil(r.bottom))),
+    };
+}
+
+// Source-over of `color` at `coverage` onto premultiplied RGBA.
+void SoftwareCanvas::Blend(int x, int y, uint32_t color, float coverage) {
+    float a = (color >> 24) / 255.0f * coverage;
+    if (a <= 0.0f) return;
+
+    uint8_t* p = &m_pixels[(static_cast<size_t>(y) * m_width + x) * 4];
+    float src[4] = {
+        ((color >> 16) & 0xFF) * a,
+        ((color >>  8) & 0xFF) * a,
+        ( color        & 0xFF) * a,
+        255.0f * a,
+    };
+    for (int i = 0; i < 4; i++)
+        p[i] = static_cast<uint8_t>(std::min(255.0f, src[i] + p[i] * (1.0f - a) + 0.5f));
+}
+
+void SoftwareCanvas::FillRect(const DlRect& r, uint32_t color, const Span& clip) {
+    Span s = Clip(r, clip);
+    for (int y = s.y0; y < s.y1; y++) {
+        float cy = Overlap(static_cast<float>(y), r.top, r.bottom);
+        for (int x = s.x0; x < s.x1; x++)
+            Blend(x, y, color, cy * Overlap(static_cast<float>(x), r.left, r.right));
+    }
+}
+
+void SoftwareCanvas::RoundedRect(const DlCommand& c, bool stroke, const Span& clip) {
+    Span s = Clip(DisplayList::Bounds(c), clip);
+    float half = c.width / 2;
+    for (int y = s.y0; y < s.y1; y++) {
+        for (int x = s.x0; x < s.x1; x++) {
+            float d = RoundedBoxDistance(x + 0.5f, y + 0.5f, c.rect, c.radius);
+            float coverage = stroke ? Clamp01(half + 0.5f - std::fabs(d)) : Clamp01(0.5f - d);
+            Blend(x, y, c.color, coverage);
+        }
+    }
+}
+
+// Flat-capped segment, like D2D's default stroke style.
+void SoftwareCanvas::Line(const DlCommand& c, const Span& clip) {
+    float x0 = c.rect.left, y0 = c.rect.top, x1 = c.rect.right, y1 = c.rect.bottom;
+    float dx = x1 - x0, dy = y1 - y0;
+    float len = std::hypot(dx, dy);
+    if (len <= 0.0f) return;
+    float ux = dx / len, uy = dy / len;
+    float half = c.width / 2;
+
+    Span s = Clip(DisplayList::Bounds(c), clip);
+    for (int y = s.y0; y < s.y1; y++) {
+        for (int x = s.x0; x < s.x1; x++) {
+            float px = x + 0.5f - x0, py = y + 0.5f - y0;
+            float along  = px * ux + py * uy;
+            float across = std::fabs(px * -uy + py * ux);
+            float coverage = Clamp01(half + 0.5f - across) *
+                             Clamp01(std::min(along + 0.5f, len - along + 0.5f));
+            Blend(x, y, c.color, coverage);
+        }
+    }
+}
+
+// Bilinear resample of the image into the destination rectangle.
+void SoftwareCanvas::Mask(const DlCommand& c, const DlImage& image, const Span& clip) {
+    const DlRect& r = c.rect;
+    float w = r.right - r.left, h = r.bottom - r.top;
+    if (!image.pixels || image.width <= 0 || image.height <= 0 || w <= 0 || h <= 0) return;
+
+    auto at = [&image](int x, int y) {
+        x = std::clamp(x, 0, image.width - 1);
+        y = std::clamp(y, 0, image.height - 1);
+        return image.pixels[static_cast<size_t>(y) * image.stride + x] / 255.0f;
+    };
+
+    Span s = Clip(r, clip);
+    for (int y = s.y0; y < s.y1; y++) {
+        float v = (y + 0.5f - r.top) * image.height / h - 0.5f;
+        int   iy = static_cast<int>(std::floor(v));
+        float fy = v - iy;
+        for (int x = s.x0; x < s.x1; x++) {
+            float u = (x + 0.5f - r.left) * image.width / w - 0.5f;
+            int   ix = static_cast<int>(std::floor(u));
+            float fx = u - ix;
+            float coverage =
+                (at(ix, iy)     * (1 - fx) + at(ix + 1, iy)     * fx) * (1 - fy) +
+                (at(ix, iy + 1) * (1 - fx) + at(ix + 1, iy + 1) * fx) * fy;
+            Blend(x, y, c.color, coverage);
+        }
+    }
+}
+
+void SoftwareCanvas::Text(const DlCommand& c, const DisplayList& list, const Span& clip) {
+    const DlFont& font = list.FontAt(c.font);
+    std::wstring_view text = list.TextOf(c);
+    float em      = font.size;
+    float advance = kAdvance * em;
+    float width   = advance * static_cast<float>(text.size());
+
+    float x = c.rect.left;
+    if (font.align == DlAlign::Center)   x = (c.rect.left + c.rect.right - width) / 2;
+    if (font.align == DlAlign::Trailing) x = c.rect.right - width;
+    float top = (c.rect.top + c.rect.bottom - kBoxHeight * em) / 2;
+
+    // Runs that overflow are cut at the box, keeping inside Bounds().
+    Span inside = Clip(c.rect, clip);
+    for (wchar_t ch : text) {
+        if (ch != L' ') {
+            FillRect(DlRect{ x + kBoxInset * em, top, x + advance - kBoxInset * em, top + kBoxHeight * em },
+                     c.color, inside);
+        }
+        x += advance;
+    }
+}
+
+void SoftwareCanvas::Replay(const DisplayList& list, const DlImage* images, int imageCount,
+                            const DlRect* clip)
+{
+    Span bounds{ 0, 0, m_width, m_height };
+    if (clip) bounds = Clip(*clip, bounds);
+    if (bounds.x0 >= bounds.x1 || bounds.y0 >= bounds.y1) return;
+
+    DlRect area{
+        static_cast<float>(bounds.x0), static_cast<float>(bounds.y0),
+        static_cast<float>(bounds.x1), static_cast<float>(bounds.y1),
+    };
+
+    for (const auto& c : list.Commands()) {
+        if (!DisplayList::Bounds(c).Intersects(area)) continue;
+        switch (c.op) {
+        case DlOp::FillRect:          FillRect(c.rect, c.color, bounds); break;
+        case DlOp::FillRoundedRect:   RoundedRect(c, false, bounds); break;
+        case DlOp::StrokeRoundedRect: RoundedRect(c, true, bounds); break;
+        case DlOp::Line:              Line(c, bounds); break;
+        case DlOp::Text:              Text(c, list, bounds); break;
+        case DlOp::Mask:
+            if (c.image < imageCount) Mask(c, images[c.image], bounds);
+            break;
+        }
+    }
+}
+
+} // namespace exo
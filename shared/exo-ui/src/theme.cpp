@@ -1,4 +1,10 @@
 #include <exo/theme.h>
+#include <exo/render.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace exo {
 
@@ -32,37 +38,189 @@ const ColorPalette LightPalette {
 
 bool Theme::s_dark = true;
 
-bool Theme::IsDarkMode() {
+// ── Resolved tokens and listeners ───────────────────────────
+// UI thread only; the system-setting watcher talks to it by message.
+namespace {
+
+constexpr int  kTokenCount = static_cast<int>(ThemeToken::Count);
+constexpr UINT WM_EXO_SYSTEM_THEME = WM_APP + 0x3E1;
+constexpr wchar_t kPersonalizeKey[] =
+    L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize";
+
+struct ResolvedTheme {
+    COLORREF      rgb[kTokenCount];
+    D2D1_COLOR_F  d2d[kTokenCount];
+    uint32_t      argb[kTokenCount];
+    ControlColors paint;
+};
+
+ResolvedTheme Resolve(const ColorPalette& p) {
+    const COLORREF rgb[kTokenCount] = {
+        p.background, p.surface, p.surfaceHover, p.surfaceActive, p.toolbar,
+        p.text, p.textSecondary, p.border, p.accent, p.statusBar, p.statusBarText,
+        p.text,             // icon
+        p.textSecondary,    // icon, secondary
+    };
+    ResolvedTheme r{};
+    for (int i = 0; i < kTokenCount; i++) {
+        r.rgb[i]  = rgb[i];
+        r.d2d[i]  = ToD2DColor(rgb[i]);
+        r.argb[i] = 0xFF000000u | GetRValue(rgb[i]) << 16 | GetGValue(rgb[i]) << 8 | GetBValue(rgb[i]);
+    }
+    auto a = [&](ThemeToken t) { return r.argb[static_cast<int>(t)]; };
+    r.paint = ControlColors{
+        a(ThemeToken::Background),
+        a(ThemeToken::Surface),   a(ThemeToken::SurfaceHover), a(ThemeToken::SurfaceActive),
+        a(ThemeToken::Toolbar),   a(ThemeToken::Text),         a(ThemeToken::TextSecondary),
+        a(ThemeToken::Border),    a(ThemeToken::Accent),       a(ThemeToken::StatusBar),
+        a(ThemeToken::StatusBarText),
+        a(ThemeToken::Icon),
+    };
+    return r;
+}
+
+struct Subscriber {
+    uint32_t        id;
+    Theme::Listener listener;
+};
+
+ResolvedTheme           s_resolved = Resolve(DarkPalette);
+uint32_t                s_version  = 1;
+std::vector<Subscriber> s_subscribers;
+uint32_t                s_nextSubscriber = 1;
+bool                    s_notifying = false;
+
+HWND              s_notifyWindow = nullptr;
+HANDLE            s_stopWatch    = nullptr;
+std::thread       s_watcher;
+
+bool ReadAppsDark(HKEY key, const wchar_t* subKey) {
     DWORD value = 1;
     DWORD size  = sizeof(value);
-    RegGetValueW(
-        HKEY_CURRENT_USER,
-        L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize",
-        L"AppsUseLightTheme",
-        RRF_RT_DWORD, nullptr, &value, &size
-    );
+    RegGetValueW(key, subKey, L"AppsUseLightTheme", RRF_RT_DWORD, nullptr, &value, &size);
     return value == 0;
 }
 
+// Waits on the Personalize key instead of reading it in WM_SETTINGCHANGE,
+// and posts the new setting only when it actually flipped.
+void WatchSystemTheme(bool dark) {
+    HKEY key = nullptr;
+    if (RegOpenKeyExW(HKEY_CURRENT_USER, kPersonalizeKey, 0,
+                      KEY_NOTIFY | KEY_QUERY_VALUE, &key) != ERROR_SUCCESS)
+        return;
+    HANDLE changed = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+
+    while (RegNotifyChangeKeyValue(key, FALSE, REG_NOTIFY_CHANGE_LAST_SET, changed, TRUE) == ERROR_SUCCESS) {
+        HANDLE waits[] = { s_stopWatch, changed };
+        if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) break;
+        bool now = ReadAppsDark(key, nullptr);
+        if (now == dark) continue;
+        dark = now;
+        PostMessageW(s_notifyWindow, WM_EXO_SYSTEM_THEME, now ? 1 : 0, 0);
+    }
+
+    CloseHandle(changed);
+    RegCloseKey(key);
+}
+
+LRESULT CALLBACK NotifyProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    if (msg != WM_EXO_SYSTEM_THEME) return DefWindowProcW(hwnd, msg, wp, lp);
+    Theme::SetDark(wp != 0);
+    return 0;
+}
+
+void StartWatcher(bool dark) {
+    HINSTANCE hInst = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                       GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&NotifyProc), &hInst);
+
+    WNDCLASSEXW wc{};
+    wc.cbSize        = sizeof(wc);
+    wc.lpfnWndProc   = NotifyProc;
+    wc.hInstance     = hInst;
+    wc.lpszClassName = L"ExoThemeNotify";
+    RegisterClassExW(&wc);
+
+    s_notifyWindow = CreateWindowExW(0, L"ExoThemeNotify", nullptr, 0, 0, 0, 0, 0,
+                                     HWND_MESSAGE, nullptr, hInst, nullptr);
+    if (!s_notifyWindow) return;
+    s_stopWatch = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    s_watcher   = std::thread(WatchSystemTheme, dark);
+}
+
+void Notify() {
+    s_notifying = true;
+    for (size_t i = 0; i < s_subscribers.size(); i++) {
+        // Copied: the listener may unsubscribe itself.
+        auto listener = s_subscribers[i].listener;
+        if (listener) listener();
+    }
+    s_notifying = false;
+    std::erase_if(s_subscribers, [](const Subscriber& s) { return !s.listener; });
+}
+
+} // namespace
+
+bool Theme::IsDarkMode() { return ReadAppsDark(HKEY_CURRENT_USER, kPersonalizeKey); }
+
 const ColorPalette& Theme::Colors() { return s_dark ? DarkPalette : LightPalette; }
 bool Theme::IsDark() { return s_dark; }
-void Theme::Init() { s_dark = IsDarkMode(); }
-void Theme::Toggle() { s_dark = !s_dark; }
-void Theme::SetDark(bool dark) { s_dark = dark; }
+void Theme::Toggle() { SetDark(!s_dark); }
+
+void Theme::Init() {
+    bool dark = IsDarkMode();
+    SetDark(dark);
+    if (!s_notifyWindow) StartWatcher(dark);
+}
+
+// Cached brushes are keyed by color, so a palette switch would strand the
+// old ones; drop them along with everything else derived from the theme.
+void Theme::SetDark(bool dark) {
+    if (dark == s_dark) return;
+    s_dark     = dark;
+    s_resolved = Resolve(Colors());
+    s_version++;
+    RenderContext::Invalidate();
+    Notify();
+}
 
 void Theme::ApplyToWindow(HWND hwnd) {
     BOOL dark = s_dark ? TRUE : FALSE;
     DwmSetWindowAttribute(hwnd, DWMWA_USE_IMMERSIVE_DARK_MODE, &dark, sizeof(dark));
 }
 
-uint32_t Theme::IconColor() {
-    auto& c = Colors();
-    return (GetRValue(c.text) << 16) | (GetGValue(c.text) << 8) | GetBValue(c.text);
+uint32_t Theme::IconColor() { return Argb(ThemeToken::Icon) & 0xFFFFFF; }
+uint32_t Theme::SecondaryIconColor() { return Argb(ThemeToken::IconSecondary) & 0xFFFFFF; }
+
+uint32_t Theme::Version() { return s_version; }
+COLORREF Theme::Rgb(ThemeToken token) { return s_resolved.rgb[static_cast<int>(token)]; }
+const D2D1_COLOR_F& Theme::Color(ThemeToken token) { return s_resolved.d2d[static_cast<int>(token)]; }
+uint32_t Theme::Argb(ThemeToken token) { return s_resolved.argb[static_cast<int>(token)]; }
+const ControlColors& Theme::PaintColors() { return s_resolved.paint; }
+
+uint32_t Theme::Subscribe(Listener listener) {
+    uint32_t id = s_nextSubscriber++;
+    s_subscribers.push_back({ id, std::move(listener) });
+    return id;
+}
+
+void Theme::Unsubscribe(uint32_t id) {
+    auto it = std::find_if(s_subscribers.begin(), s_subscribers.end(),
+        [id](const Subscriber& s) { return s.id == id; });
+    if (it == s_subscribers.end()) return;
+    if (s_notifying) it->listener = nullptr;
+    else             s_subscribers.erase(it);
 }
 
-uint32_t Theme::SecondaryIconColor() {
-    auto& c = Colors();
-    return (GetRValue(c.textSecondary) << 16) | (GetGValue(c.textSecondary) << 8) | GetBValue(c.textSecondary);
+void Theme::Shutdown() {
+    if (!s_notifyWindow) return;
+    SetEvent(s_stopWatch);
+    if (s_watcher.joinable()) s_watcher.join();
+    DestroyWindow(s_notifyWindow);
+    CloseHandle(s_stopWatch);
+    s_notifyWindow = nullptr;
+    s_stopWatch    = nullptr;
 }
 
 } // namespace exo
@@ -0,0 +1,67 @@
+// ── Lucide Batch Benchmark ──────────────────────────────────
+// Renders every embedded icon at four sizes into one atlas with
+// LucideRenderIconBatch on 1..N threads and reports the scaling.
+
+#include "lucide.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kSizes[]    = { 16, 24, 32, 48 };
+constexpr int kAtlasWidth = 1024;
+constexpr int kRounds     = 10;
+
+} // namespace
+
+int main() {
+    int iconCount = LucideGetIconCount();
+
+    // Size-major order so neighbouring work items hit different icons.
+    std::vector<LucideBatchItem> items;
+    for (int size : kSizes) {
+        for (int i = 0; i < iconCount; i++)
+            items.push_back({ nullptr, i, size, 0xE6E6E6, 0, 0, 0 });
+    }
+    int count = static_cast<int>(items.size());
+
+    int atlasHeight = LucideLayoutIconBatch(items.data(), count, kAtlasWidth);
+    if (atlasHeight <= 0) {
+        fprintf(stderr, "layout failed\n");
+        return 1;
+    }
+    std::vector<uint8_t> atlas(static_cast<size_t>(kAtlasWidth) * atlasHeight * 4);
+
+    // Parse every document once so the first run isn't charged for it.
+    LucideRenderIconBatch(items.data(), count, atlas.data(),
+                          kAtlasWidth, atlasHeight, kAtlasWidth * 4, 0);
+
+    int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) maxThreads = 1;
+
+    printf("Lucide batch benchmark: %d icons x %d sizes = %d renders, atlas %dx%d\n\n",
+        iconCount, static_cast<int>(std::size(kSizes)), count, kAtlasWidth, atlasHeight);
+    printf("%7s  %12s  %8s  %10s\n", "threads", "ms/batch", "speedup", "efficiency");
+
+    double baseline = 0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        int rendered = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < kRounds; r++) {
+            rendered = LucideRenderIconBatch(items.data(), count, atlas.data(),
+                                             kAtlasWidth, atlasHeight, kAtlasWidth * 4,
+                                             threads);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count() / kRounds;
+        if (threads == 1) baseline = ms;
+
+        double speedup = baseline / ms;
+        printf("%7d  %12.3f  %7.2fx  %9.0f%%%s\n", threads, ms, speedup,
+            100.0 * speedup / threads, rendered == count ? "" : "  (incomplete)");
+    }
+    return 0;
+}
@@ -0,0 +1,114 @@
+// ── Lucide Disk Cache Benchmark ─────────────────────────────
+// Cold launch (render everything, append it to a fresh cache file) against
+// warm launch (map the file, hand out stored pixels) for every icon at the
+// sidebar and toolbar sizes, colored and as masks. The warm run must hit
+// the file for every raster and return identical pixels.
+
+#include "lucide.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+namespace {
+
+constexpr int      kSizes[]  = { 16, 20, 24, 32, 48 };
+constexpr uint32_t kColors[] = { 0xE6E6E6, 0x191919 };
+
+struct Request {
+    int      index;
+    int      size;
+    uint32_t color;
+    bool     mask;
+};
+
+// Acquire every request once; returns milliseconds and keeps a copy of
+// each raster's pixels.
+double AcquireAll(const std::vector<Request>& requests,
+                  std::vector<std::vector<uint8_t>>& pixels)
+{
+    pixels.assign(requests.size(), {});
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < requests.size(); i++) {
+        auto& r = requests[i];
+        const LucideRaster* raster = r.mask
+            ? LucideAcquireIconMaskIndex(r.index, r.size)
+            : LucideAcquireIconIndex(r.index, r.size, r.color);
+        if (!raster) continue;
+        const uint8_t* p = raster->pixels;
+        pixels[i].assign(p, p + static_cast<size_t>(raster->stride) * raster->size);
+        LucideReleaseIcon(raster);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Stand-in for a relaunch: drop the in-memory cache and reopen the file.
+void Relaunch(const wchar_t* path) {
+    LucideSetCacheBudget(0);
+    LucideSetCacheBudget(16u * 1024u * 1024u);
+    LucideSetDiskCachePath(path);
+}
+
+} // namespace
+
+int main() {
+    wchar_t dir[MAX_PATH];
+    DWORD len = GetTempPathW(MAX_PATH, dir);
+    if (len == 0 || len >= MAX_PATH) return 1;
+    std::wstring path = std::wstring(dir, len) + L"lucide_disk_bench.cache";
+    DeleteFileW(path.c_str());
+
+    std::vector<Request> requests;
+    for (int size : kSizes) {
+        for (int i = 0; i < LucideGetIconCount(); i++) {
+            for (uint32_t color : kColors) requests.push_back({ i, size, color, false });
+            requests.push_back({ i, size, 0, true });
+        }
+    }
+
+    // Parse every document first so the cold run measures rendering, not
+    // one-time setup; then start over with an empty file.
+    std::vector<std::vector<uint8_t>> cold, warm;
+    LucideSetDiskCachePath(nullptr);
+    AcquireAll(requests, cold);
+    DeleteFileW(path.c_str());
+    Relaunch(path.c_str());
+
+    double coldMs = AcquireAll(requests, cold);
+    LucideFlushDiskCache();
+
+    LucideCacheStats before{};
+    LucideGetCacheStats(&before);
+
+    Relaunch(path.c_str());
+    double warmMs = AcquireAll(requests, warm);
+
+    LucideCacheStats after{};
+    LucideGetCacheStats(&after);
+    uint64_t hits = after.diskHits - before.diskHits;
+
+    printf("Lucide disk cache benchmark: %zu rasters\n\n", requests.size());
+    printf("cold (render + queue append)  %8.2f ms\n", coldMs);
+    printf("warm (mapped file)            %8.2f ms  (%.1fx)\n", warmMs, coldMs / warmMs);
+    printf("records written %llu, warm disk hits %llu\n",
+        static_cast<unsigned long long>(before.diskWrites),
+        static_cast<unsigned long long>(hits));
+
+    bool ok = hits == requests.size() && before.diskWrites == requests.size();
+    for (size_t i = 0; i < requests.size() && ok; i++) {
+        if (cold[i].empty() || cold[i] != warm[i]) {
+            fprintf(stderr, "FAIL: raster %zu differs after reload\n", i);
+            ok = false;
+        }
+    }
+
+    LucideSetDiskCachePath(nullptr);
+    DeleteFileW(path.c_str());
+    printf("\n%s\n", ok ? "disk cache round-trips" : "MISMATCH");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,442 @@
+// ── Lucide Benchmark and Pixel-Regression Suite ─────────────
+// Links the portable core (lucide_core), so it builds and runs on Linux.
+//
+//   lucide_bench                    per-stage timings for every icon
+//   lucide_bench --check            pixel-regression checks; exit 1 on failure
+//   lucide_bench --record <file>    write reference masks for every icon/size
+//   lucide_bench --compare <file>   diff against a recorded file; exit 1 if any
+//                                   icon's mean error exceeds --tolerance
+//
+// Timings split the lunasvg pipeline into its stages: name lookup, SVG
+// decode, color injection, parse, rasterize and pixel conversion, next to
+// the production render (compiled path where the icon has one). Record a
+// reference before a render-path change and compare after it to see
+// exactly which icons and sizes moved.
+
+#include "lucide.h"
+#include "batch.h"
+#include "icon_render.h"
+#include "icon_source.h"
+#include "icon_svg.h"
+#include "icons_data.h"
+#include "pixel_convert.h"
+#include "raster_cache.h"
+
+#include <lunasvg.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace lucide;
+
+namespace {
+
+constexpr int      kSizes[]  = { 16, 24, 32, 48, 64, 128 };
+constexpr uint32_t kColors[] = { 0xE6E6E6, 0x191919, 0x3366CC };
+constexpr int      kModes[]  = { LUCIDE_RENDER_DIRECT, LUCIDE_RENDER_SDF };
+constexpr int      kRounds   = 20;
+
+template <typename Fn>
+double MicrosPer(int rounds, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / rounds;
+}
+
+// ── Stage timings ───────────────────────────────────────────
+
+// Color injection as the original pipeline did it: rewrite the text and
+// parse the result.
+std::string InjectColor(const std::string& svg, uint32_t color) {
+    char hex[8];
+    snprintf(hex, sizeof(hex), "#%02X%02X%02X",
+        (color >> 16) & 0xFF,
+        (color >>  8) & 0xFF,
+        (color      ) & 0xFF
+    );
+
+    std::string result(svg);
+    const std::string target = "currentColor";
+    size_t pos = 0;
+    while ((pos = result.find(target, pos)) != std::string::npos) {
+        result.replace(pos, target.length(), hex);
+        pos += 7;
+    }
+    return result;
+}
+
+enum Stage { Lookup, Decode, Inject, Parse, Raster, Convert, Render, kStageCount };
+
+constexpr const char* kStageNames[kStageCount] = {
+    "lookup", "decode", "inject", "parse", "raster", "convert", "render",
+};
+
+bool TimeIcon(int index, int size, double (&us)[kStageCount]) {
+    IconData icon;
+    if (!GetIcon(index, icon)) return false;
+
+    size_t bytes = static_cast<size_t>(size) * size * 4;
+    std::vector<uint8_t> bgra(bytes), rgba(bytes);
+    std::string svg, colored;
+    std::unique_ptr<lunasvg::Document> doc;
+    int found = 0;
+
+    // Name lookups are far below timer resolution one at a time.
+    us[Lookup] = MicrosPer(kRounds * 100, [&] { found += FindIcon(icon.name) == index; });
+    us[Decode] = MicrosPer(kRounds, [&] { DecodeIconSvg(icon, svg); });
+    us[Inject] = MicrosPer(kRounds, [&] { colored = InjectColor(svg, kColors[0]); });
+    us[Parse]  = MicrosPer(kRounds, [&] { doc = lunasvg::Document::loadFromData(colored); });
+    if (!doc || found != kRounds * 100) return false;
+
+    lunasvg::Matrix scale(
+        static_cast<float>(size) / doc->width(), 0,
+        0, static_cast<float>(size) / doc->height(),
+        0, 0);
+    us[Raster] = MicrosPer(kRounds, [&] {
+        std::fill(bgra.begin(), bgra.end(), 0);
+        lunasvg::Bitmap bitmap(bgra.data(), size, size, size * 4);
+        doc->render(bitmap, scale);
+    });
+    us[Convert] = MicrosPer(kRounds, [&] {
+        ConvertPixels(bgra.data(), LUCIDE_FORMAT_BGRA_PREMUL,
+                      rgba.data(), LUCIDE_FORMAT_RGBA_PREMUL, static_cast<size_t>(size) * size);
+    });
+    us[Render] = MicrosPer(kRounds, [&] { RenderIconRGBA(index, size, kColors[0], rgba.data()); });
+    return true;
+}
+
+bool RunTimings() {
+    printf("Lucide stage timings: %d icons, %d rounds, microseconds per call\n", IconCount(), kRounds);
+    printf("render: production path (compiled path marked *, else parsed document)\n");
+
+    bool ok = true;
+    for (int size : kSizes) {
+        printf("\n%-22s %5s", "icon", "size");
+        for (auto* name : kStageNames) printf("  %8s", name);
+        printf("\n");
+
+        double total[kStageCount] = {};
+        for (int i = 0; i < IconCount(); i++) {
+            double us[kStageCount];
+            IconData icon;
+            GetIcon(i, icon);
+            if (!TimeIcon(i, size, us)) {
+                fprintf(stderr, "%s: lunasvg pipeline failed\n", icon.name);
+                ok = false;
+                continue;
+            }
+            printf("%-21s%c %5d", icon.name, HasCompiledPath(i) ? '*' : ' ', size);
+            for (int s = 0; s < kStageCount; s++) {
+                printf("  %8.3f", us[s]);
+                total[s] += us[s];
+            }
+            printf("\n");
+        }
+
+        printf("%-22s %5d", "mean", size);
+        for (double t : total) printf("  %8.3f", t / IconCount());
+        printf("\n");
+    }
+    return ok;
+}
+
+// ── Regression checks ───────────────────────────────────────
+// Invariants between render paths that must hold bit for bit. Each
+// failure names the icon, size and color so it can be reproduced.
+
+int s_failures = 0;
+
+void Fail(const char* what, int index, int size, uint32_t color) {
+    IconData icon;
+    GetIcon(index, icon);
+    if (s_failures++ < 20)
+        fprintf(stderr, "FAIL: %s: %s @ %d, #%06X\n", what, icon.name, size, color);
+}
+
+bool RenderFormat(int index, int size, uint32_t color, int format, std::vector<uint8_t>& out) {
+    int bpp = format == LUCIDE_FORMAT_A8 ? 1 : 4;
+    out.assign(static_cast<size_t>(size) * size * bpp, 0);
+    return RenderIconInto(index, size, color, out.data(), size * bpp, format);
+}
+
+bool SwizzleEquals(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+    for (size_t i = 0; i < a.size(); i += 4) {
+        if (a[i] != b[i + 2] || a[i + 1] != b[i + 1] || a[i + 2] != b[i] || a[i + 3] != b[i + 3])
+            return false;
+    }
+    return true;
+}
+
+void CheckFormats(int index, int size, uint32_t color) {
+    std::vector<uint8_t> rgba, bgra, rgbaStraight, bgraStraight, mask;
+    if (!RenderFormat(index, size, color, LUCIDE_FORMAT_RGBA_PREMUL, rgba) ||
+        !RenderFormat(index, size, color, LUCIDE_FORMAT_BGRA_PREMUL, bgra) ||
+        !RenderFormat(index, size, color, LUCIDE_FORMAT_RGBA_STRAIGHT, rgbaStraight) ||
+        !RenderFormat(index, size, color, LUCIDE_FORMAT_BGRA_STRAIGHT, bgraStraight) ||
+        !RenderFormat(index, size, color, LUCIDE_FORMAT_A8, mask)) {
+        Fail("render failed", index, size, color);
+        return;
+    }
+
+    if (!SwizzleEquals(rgba, bgra))                 Fail("BGRA premul is not swizzled RGBA", index, size, color);
+    if (!SwizzleEquals(rgbaStraight, bgraStraight)) Fail("BGRA straight is not swizzled RGBA", index, size, color);
+
+    // Coverage doesn't depend on color: the A8 mask is every format's alpha.
+    for (size_t i = 0; i < mask.size(); i++) {
+        if (rgba[i * 4 + 3] != mask[i] || rgbaStraight[i * 4 + 3] != mask[i]) {
+            Fail("alpha differs from A8 mask", index, size, color);
+            break;
+        }
+    }
+}
+
+// A wider stride must give the same rows and leave the padding alone.
+void CheckStride(int index, int size, uint32_t color) {
+    constexpr int kPad = 12;
+    int stride = size * 4 + kPad;
+    std::vector<uint8_t> packed, padded(static_cast<size_t>(stride) * size, 0xCD);
+    RenderFormat(index, size, color, LUCIDE_FORMAT_RGBA_PREMUL, packed);
+    if (!RenderIconInto(index, size, color, padded.data(), stride, LUCIDE_FORMAT_RGBA_PREMUL)) {
+        Fail("strided render failed", index, size, color);
+        return;
+    }
+
+    for (int y = 0; y < size; y++) {
+        const uint8_t* row = padded.data() + static_cast<size_t>(y) * stride;
+        bool padIntact = std::all_of(row + size * 4, row + stride, [](uint8_t b) { return b == 0xCD; });
+        if (memcmp(row, packed.data() + static_cast<size_t>(y) * size * 4, size * 4) != 0 || !padIntact) {
+            Fail("strided render differs", index, size, color);
+            return;
+        }
+    }
+}
+
+// Cached rasters are the rendered pixels, and a second lookup is a hit.
+void CheckCache(int index, int size, uint32_t color) {
+    std::vector<uint8_t> direct;
+    RenderFormat(index, size, color, LUCIDE_FORMAT_RGBA_PREMUL, direct);
+
+    const LucideRaster* first  = AcquireRaster(index, size, color);
+    const LucideRaster* second = AcquireRaster(index, size, color);
+    bool same = first && second == first;
+    for (int y = 0; same && y < size; y++) {
+        same = memcmp(first->pixels + static_cast<size_t>(y) * first->stride,
+                      direct.data() + static_cast<size_t>(y) * size * 4, size * 4) == 0;
+    }
+    if (!same) Fail("cached raster differs", index, size, color);
+    if (first)  ReleaseRaster(first);
+    if (second) ReleaseRaster(second);
+}
+
+// Every icon in one atlas matches its single render.
+void CheckBatch(int size, uint32_t color) {
+    int count = IconCount();
+    std::vector<LucideBatchItem> items(count);
+    std::vector<int> indices(count);
+    for (int i = 0; i < count; i++) {
+        items[i] = LucideBatchItem{ nullptr, i, size, color, 0, 0, 0 };
+        indices[i] = i;
+    }
+
+    constexpr int kAtlasWidth = 512;
+    int height = LayoutBatch(items.data(), count, kAtlasWidth);
+    std::vector<uint8_t> atlas(static_cast<size_t>(kAtlasWidth) * std::max(height, 1) * 4);
+    RenderBatch(items.data(), indices.data(), count, atlas.data(), kAtlasWidth, height,
+                kAtlasWidth * 4, 4);
+
+    std::vector<uint8_t> single;
+    for (auto& item : items) {
+        RenderFormat(item.index, size, color, LUCIDE_FORMAT_RGBA_PREMUL, single);
+        bool same = item.status == 1;
+        for (int y = 0; same && y < size; y++) {
+            const uint8_t* row = atlas.data() + (static_cast<size_t>(item.y) + y) * kAtlasWidth * 4 + item.x * 4;
+            same = memcmp(row, single.data() + static_cast<size_t>(y) * size * 4, size * 4) == 0;
+        }
+        if (!same) Fail("batch tile differs", item.index, size, color);
+    }
+}
+
+bool RunChecks() {
+    int checks = 0;
+    for (int mode : kModes) {
+        SetRenderMode(mode);
+        PurgeRasters();
+        for (int size : kSizes) {
+            for (uint32_t color : kColors) {
+                for (int i = 0; i < IconCount(); i++) {
+                    CheckFormats(i, size, color);
+                    CheckStride(i, size, color);
+                    CheckCache(i, size, color);
+                    checks += 3;
+                }
+                CheckBatch(size, color);
+                checks++;
+            }
+        }
+    }
+    SetRenderMode(LUCIDE_RENDER_DIRECT);
+    PurgeRasters();
+
+    printf("\nregression checks: %d run, %d failed\n", checks, s_failures);
+    return s_failures == 0;
+}
+
+// ── Reference masks ─────────────────────────────────────────
+// "LUCIDEGR", u32 version, u32 record count, then per record: u32 mode,
+// u32 size, u32 name length, the name, size*size coverage bytes. Masks
+// capture the geometry; the checks above tie every colored format to it.
+
+constexpr char     kRefMagic[8]  = { 'L', 'U', 'C', 'I', 'D', 'E', 'G', 'R' };
+constexpr uint32_t kRefVersion   = 1;
+
+bool WriteU32(FILE* f, uint32_t v) { return fwrite(&v, sizeof(v), 1, f) == 1; }
+bool ReadU32(FILE* f, uint32_t& v) { return fread(&v, sizeof(v), 1, f) == 1; }
+
+bool Record(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "cannot create %s\n", path);
+        return false;
+    }
+
+    uint32_t records = static_cast<uint32_t>(std::size(kModes) * std::size(kSizes) * IconCount());
+    bool ok = fwrite(kRefMagic, sizeof(kRefMagic), 1, f) == 1 &&
+              WriteU32(f, kRefVersion) && WriteU32(f, records);
+
+    std::vector<uint8_t> mask;
+    for (int mode : kModes) {
+        SetRenderMode(mode);
+        for (int size : kSizes) {
+            for (int i = 0; ok && i < IconCount(); i++) {
+                IconData icon;
+                GetIcon(i, icon);
+                uint32_t length = static_cast<uint32_t>(strlen(icon.name));
+                ok = RenderFormat(i, size, 0, LUCIDE_FORMAT_A8, mask) &&
+                     WriteU32(f, static_cast<uint32_t>(mode)) && WriteU32(f, static_cast<uint32_t>(size)) &&
+                     WriteU32(f, length) && fwrite(icon.name, 1, length, f) == length &&
+                     fwrite(mask.data(), 1, mask.size(), f) == mask.size();
+            }
+        }
+    }
+    SetRenderMode(LUCIDE_RENDER_DIRECT);
+
+    ok = fclose(f) == 0 && ok;
+    printf("\n%s %u reference masks to %s\n", ok ? "wrote" : "FAILED writing", records, path);
+    return ok;
+}
+
+bool Compare(const char* path, double tolerance) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    char magic[8];
+    uint32_t version = 0, records = 0;
+    if (fread(magic, sizeof(magic), 1, f) != 1 || memcmp(magic, kRefMagic, sizeof(magic)) != 0 ||
+        !ReadU32(f, version) || version != kRefVersion || !ReadU32(f, records)) {
+        fprintf(stderr, "%s is not a reference file\n", path);
+        fclose(f);
+        return false;
+    }
+
+    printf("\n%-22s %4s %5s  %8s  %8s  %9s\n", "changed icon", "mode", "size", "pixels", "max err", "mean err");
+
+    int identical = 0, changed = 0, missing = 0, worst = 0;
+    bool ok = true;
+    std::vector<uint8_t> want, got;
+    for (uint32_t r = 0; r < records; r++) {
+        uint32_t mode, size, length;
+        if (!ReadU32(f, mode) || !ReadU32(f, size) || !ReadU32(f, length) ||
+            size == 0 || size > 4096 || length > 256) {
+            fprintf(stderr, "%s is truncated\n", path);
+            ok = false;
+            break;
+        }
+        std::string name(length, '\0');
+        want.resize(static_cast<size_t>(size) * size);
+        if (fread(name.data(), 1, length, f) != length || fread(want.data(), 1, want.size(), f) != want.size()) {
+            fprintf(stderr, "%s is truncated\n", path);
+            ok = false;
+            break;
+        }
+
+        int index = FindIcon(name);
+        if (index < 0 || !SetRenderMode(static_cast<int>(mode)) ||
+            !RenderFormat(index, static_cast<int>(size), 0, LUCIDE_FORMAT_A8, got)) {
+            missing++;
+            continue;
+        }
+
+        // Error over pixels either side covers; background would dilute it.
+        int maxErr = 0, diffs = 0;
+        uint64_t sum = 0, covered = 0;
+        for (size_t i = 0; i < want.size(); i++) {
+            if (!want[i] && !got[i]) continue;
+            int e = std::abs(want[i] - got[i]);
+            maxErr = std::max(maxErr, e);
+            diffs += e != 0;
+            sum += e;
+            covered++;
+        }
+        if (diffs == 0) {
+            identical++;
+            continue;
+        }
+
+        double mean = covered ? static_cast<double>(sum) / covered : 0.0;
+        bool over = mean > tolerance;
+        printf("%-21s%c %4u %5u  %8d  %8d  %9.3f\n", name.c_str(), over ? '!' : ' ',
+            mode, size, diffs, maxErr, mean);
+        changed++;
+        worst = std::max(worst, maxErr);
+        ok &= !over;
+    }
+    fclose(f);
+    SetRenderMode(LUCIDE_RENDER_DIRECT);
+
+    printf("\n%d identical, %d changed (max err %d), %d not rendered; tolerance %.3f mean\n",
+        identical, changed, worst, missing, tolerance);
+    return ok && missing == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool check = false, timings = true;
+    const char* recordPath  = nullptr;
+    const char* comparePath = nullptr;
+    double tolerance = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--check") {
+            check = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else {
+            fprintf(stderr,
+                "usage: lucide_bench [--check] [--record <file>] [--compare <file> [--tolerance <mean>]]\n");
+            return 2;
+        }
+        timings = false;
+    }
+
+    bool ok = true;
+    if (timings)     ok &= RunTimings();
+    if (check)       ok &= RunChecks();
+    if (recordPath)  ok &= Record(recordPath);
+    if (comparePath) ok &= Compare(comparePath, tolerance);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// ── Lucide Icon Pack Benchmark ──────────────────────────────
+// Builds icon packs of growing size from copies of the embedded icons and
+// measures what LucideLoadIconPack costs beyond mapping the file (one
+// validation pass over the index) and what a name lookup costs against
+// the embedded perfect hash. Every pack icon must read back the embedded
+// payload byte for byte, and malformed packs must be rejected. Portable:
+// builds and runs on Linux.
+
+#include "icon_pack.h"
+#include "icon_registry.h"
+#include "icon_source.h"
+#include "icon_svg.h"
+#include "../tools/pack_writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace lucide;
+
+namespace {
+
+constexpr int kCopies[]      = { 1, 35, 345, 1000 };
+constexpr int kOpenRounds    = 20;
+constexpr int kLookupRounds  = 5;
+
+// Packs are mapped page-aligned in the DLL; match that in memory.
+struct AlignedBytes {
+    std::vector<uint64_t> words;
+    size_t                size = 0;
+
+    explicit AlignedBytes(const std::vector<uint8_t>& bytes)
+        : words((bytes.size() + 7) / 8), size(bytes.size())
+    {
+        memcpy(words.data(), bytes.data(), bytes.size());
+    }
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(words.data()); }
+};
+
+std::string CopyName(int icon, int copy) {
+    return std::string(kIcons[icon].name) + "~" + std::to_string(copy);
+}
+
+std::vector<uint8_t> BuildPack(int copies) {
+    std::vector<lucide_gen::PackIcon> icons;
+    for (int c = 0; c < copies; c++) {
+        for (int i = 0; i < kIconCount; i++) {
+            auto& e = kIcons[i];
+            icons.push_back({
+                CopyName(i, c),
+                { kIconSvgData + e.svgOffset, kIconSvgData + e.svgOffset + e.svgSize },
+                e.svgLength,
+                { kIconPathData + e.pathOffset, kIconPathData + e.pathOffset + e.pathSize },
+            });
+        }
+    }
+    std::string dict(reinterpret_cast<const char*>(kIconSvgDict), sizeof(kIconSvgDict));
+    return lucide_gen::BuildIconPack(std::move(icons), dict);
+}
+
+// Every pack icon decodes to its embedded original.
+bool VerifyPack(const IconPack& pack, int copies) {
+    std::string want, got;
+    for (int c = 0; c < copies; c++) {
+        for (int i = 0; i < kIconCount; i++) {
+            std::string name = CopyName(i, c);
+            int local = pack.Find(name);
+            if (local < 0) {
+                fprintf(stderr, "FAIL: %s not found\n", name.c_str());
+                return false;
+            }
+
+            IconData icon;
+            pack.Get(local, icon);
+            auto& e = kIcons[i];
+            if (name != icon.name || icon.pathSize != e.pathSize ||
+                memcmp(icon.path, kIconPathData + e.pathOffset, e.pathSize) != 0) {
+                fprintf(stderr, "FAIL: %s payload differs\n", name.c_str());
+                return false;
+            }
+            if (c == 0 && (!DecodeIconSvg(i, want) || !DecodeIconSvg(icon, got) || want != got)) {
+                fprintf(stderr, "FAIL: %s SVG differs\n", name.c_str());
+                return false;
+            }
+        }
+    }
+    return pack.Find("no-such-icon") < 0;
+}
+
+bool RejectsMalformed(const std::vector<uint8_t>& good) {
+    IconPack pack;
+    auto truncated = good;
+    truncated.resize(truncated.size() - 1);
+    if (pack.Open(AlignedBytes(truncated).data(), truncated.size())) return false;
+
+    // Point the first name past the end of the file.
+    auto broken = good;
+    uint32_t bad = static_cast<uint32_t>(broken.size());
+    memcpy(broken.data() + sizeof(pack::Header), &bad, sizeof(bad));
+    return !pack.Open(AlignedBytes(broken).data(), broken.size());
+}
+
+template <typename Fn>
+double NanosPer(int count, int rounds, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (double(count) * rounds);
+}
+
+} // namespace
+
+int main() {
+    printf("Lucide icon pack benchmark (embedded set: %d icons)\n\n", kIconCount);
+    printf("%7s  %10s  %10s  %12s  %14s\n", "icons", "pack KiB", "open us", "open ns/icon", "find ns/lookup");
+
+    std::mt19937 rng(42);
+    bool ok = true;
+    std::vector<uint8_t> registryPack;
+
+    for (int copies : kCopies) {
+        std::vector<uint8_t> bytes = BuildPack(copies);
+        AlignedBytes mapped(bytes);
+        int count = copies * kIconCount;
+
+        IconPack pack;
+        double openNs = NanosPer(1, kOpenRounds, [&]() {
+            pack = IconPack();
+            ok &= pack.Open(mapped.data(), mapped.size);
+        });
+        if (!ok || pack.Count() != count) {
+            fprintf(stderr, "FAIL: pack of %d icons did not open\n", count);
+            return 1;
+        }
+
+        std::vector<std::string> names;
+        for (int c = 0; c < copies; c++)
+            for (int i = 0; i < kIconCount; i++) names.push_back(CopyName(i, c));
+        std::shuffle(names.begin(), names.end(), rng);
+
+        int found = 0;
+        double findNs = NanosPer(count, kLookupRounds, [&]() {
+            for (auto& name : names) found += pack.Find(name) >= 0;
+        });
+
+        printf("%7d  %10.1f  %10.1f  %12.1f  %14.1f\n",
+            count, bytes.size() / 1024.0, openNs / 1000.0, openNs / count, findNs);
+
+        ok &= found == count * kLookupRounds && VerifyPack(pack, copies);
+        if (copies == kCopies[1]) registryPack = std::move(bytes);
+    }
+
+    std::vector<std::string> embedded;
+    for (int i = 0; i < kIconCount; i++) embedded.push_back(kIcons[i].name);
+    int found = 0;
+    double hashNs = NanosPer(kIconCount, 20000, [&]() {
+        for (auto& name : embedded) found += FindEmbeddedIcon(name) >= 0;
+    });
+    printf("\nembedded perfect hash: %.1f ns/lookup\n", hashNs);
+
+    ok &= found == kIconCount * 20000 && RejectsMalformed(registryPack);
+
+    // Through the icon table: pack icons follow the embedded set, and
+    // embedded names still resolve to the embedded icons.
+    AlignedBytes mapped(registryPack);
+    int first = AddIconPack(mapped.data(), mapped.size);
+    int packCount = kCopies[1] * kIconCount;
+    IconData icon;
+    std::string name = CopyName(3, 7);
+    int index = FindIcon(name);
+    ok &= first == kIconCount && IconCount() == kIconCount + packCount;
+    ok &= index >= first && GetIcon(index, icon) && name == icon.name;
+    ok &= FindIcon(kIcons[3].name) == 3 && !GetIcon(IconCount(), icon);
+
+    printf("\n%s\n", ok ? "packs round-trip" : "MISMATCH");
+    return ok ? 0 : 1;
+}
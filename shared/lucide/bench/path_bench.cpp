@@ -0,0 +1,126 @@
+// ── Lucide Path Benchmark ───────────────────────────────────
+// Compares the compiled-path rasterizer against the lunasvg document for
+// every icon that has a compiled path: per-size alpha difference and
+// render time. Exits non-zero if the mean alpha error of any icon/size
+// exceeds kMaxMeanError, so a generator or rasterizer regression fails
+// loudly.
+
+#include "lucide.h"
+#include "icons_data.h"
+#include "document_cache.h"
+#include "path_raster.h"
+#include "pixel_convert.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr int      kSizes[]      = { 16, 24, 32, 48, 64, 128, 256 };
+constexpr uint32_t kColor        = 0xFFFFFF;
+constexpr int      kRounds       = 20;
+constexpr double   kMaxMeanError = 8.0;    // alpha units, over covered pixels
+
+struct Diff {
+    int    max  = 0;
+    double mean = 0;
+};
+
+// Alpha difference over pixels either renderer touched; empty background
+// would otherwise dilute the mean.
+Diff CompareAlpha(const uint8_t* a, const uint8_t* b, size_t pixels) {
+    Diff d;
+    size_t covered = 0;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < pixels; i++) {
+        int aa = a[i * 4 + 3], ab = b[i * 4 + 3];
+        if (!aa && !ab) continue;
+        int e = std::abs(aa - ab);
+        d.max = std::max(d.max, e);
+        sum += e;
+        covered++;
+    }
+    d.mean = covered ? static_cast<double>(sum) / covered : 0.0;
+    return d;
+}
+
+template <typename Fn>
+double TimeUs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kRounds; r++) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / kRounds;
+}
+
+} // namespace
+
+int main() {
+    int compiled = 0;
+    for (int i = 0; i < kIconCount; i++)
+        if (kIcons[i].pathSize) compiled++;
+
+    printf("Lucide path benchmark: %d of %d icons compiled\n\n", compiled, kIconCount);
+    printf("%5s  %10s  %10s  %8s  %8s  %9s\n",
+        "size", "lunasvg us", "path us", "speedup", "max err", "mean err");
+
+    bool failed = false;
+    for (int size : kSizes) {
+        size_t pixels = static_cast<size_t>(size) * size;
+        std::vector<uint8_t> reference(pixels * 4), fast(pixels * 4), mask(pixels);
+
+        double docUs = 0, pathUs = 0, meanSum = 0;
+        int maxErr = 0;
+
+        for (int i = 0; i < kIconCount; i++) {
+            auto& icon = kIcons[i];
+            if (!icon.pathSize) continue;
+
+            // Warm the parsed document so the timing is render-only.
+            if (!lucide::RenderDocumentInto(i, size, kColor, reference.data(), size * 4,
+                                           LUCIDE_FORMAT_RGBA_PREMUL)) {
+                fprintf(stderr, "%s: lunasvg render failed\n", icon.name);
+                failed = true;
+                continue;
+            }
+            const uint8_t* data = kIconPathData + icon.pathOffset;
+            if (!lucide::RasterizePathMask(data, icon.pathSize, size, mask.data(), size)) {
+                fprintf(stderr, "%s: malformed compiled path\n", icon.name);
+                failed = true;
+                continue;
+            }
+            lucide::TintPixels(mask.data(), fast.data(), LUCIDE_FORMAT_RGBA_PREMUL, pixels, kColor);
+
+            Diff d = CompareAlpha(reference.data(), fast.data(), pixels);
+            if (d.mean > kMaxMeanError) {
+                fprintf(stderr, "%s @ %d: mean alpha error %.2f exceeds %.2f\n",
+                    icon.name, size, d.mean, kMaxMeanError);
+                failed = true;
+            }
+            maxErr = std::max(maxErr, d.max);
+            meanSum += d.mean;
+
+            docUs += TimeUs([&] {
+                lucide::RenderDocumentInto(i, size, kColor, reference.data(), size * 4,
+                                           LUCIDE_FORMAT_RGBA_PREMUL);
+            });
+            pathUs += TimeUs([&] {
+                lucide::RasterizePathMask(data, icon.pathSize, size, mask.data(), size);
+                lucide::TintPixels(mask.data(), fast.data(), LUCIDE_FORMAT_RGBA_PREMUL, pixels, kColor);
+            });
+        }
+
+        int n = std::max(compiled, 1);
+        printf("%5d  %10.2f  %10.2f  %7.2fx  %8d  %9.2f\n", size,
+            docUs / n, pathUs / n, pathUs > 0 ? docUs / pathUs : 0.0, maxErr, meanSum / n);
+    }
+
+    if (failed) {
+        printf("\nFAILED: compiled paths diverge from lunasvg\n");
+        return 1;
+    }
+    printf("\nAll compiled paths within %.1f mean alpha of lunasvg\n", kMaxMeanError);
+    return 0;
+}
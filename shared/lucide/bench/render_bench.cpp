@@ -0,0 +1,110 @@
+// ── Lucide Render Benchmark ─────────────────────────────────
+// Per-icon render cost of the legacy pipeline (copy SVG, inject color,
+// re-parse, render) against LucideRenderIcon with parse-once documents.
+// Colors alternate every call so the cached path pays for a recolor each
+// time, as it would on a theme toggle.
+
+#include "lucide.h"
+#include "icon_svg.h"
+
+#include <lunasvg.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+constexpr int      kSizes[]   = { 16, 24, 32, 48, 64, 128, 256 };
+constexpr uint32_t kColors[]  = { 0xE6E6E6, 0x191919 };
+constexpr int      kRounds    = 20;
+
+// The pre-cache implementation of LucideRenderIcon, kept verbatim as the
+// baseline.
+std::string InjectColor(const char* svg, uint32_t color) {
+    char hex[8];
+    snprintf(hex, sizeof(hex), "#%02X%02X%02X",
+        (color >> 16) & 0xFF,
+        (color >>  8) & 0xFF,
+        (color      ) & 0xFF
+    );
+
+    std::string result(svg);
+    const std::string target = "currentColor";
+    size_t pos = 0;
+    while ((pos = result.find(target, pos)) != std::string::npos) {
+        result.replace(pos, target.length(), hex);
+        pos += 7;
+    }
+    return result;
+}
+
+// The legacy pipeline had every icon's text resident; decode it up front
+// so decompression isn't billed to it.
+std::string s_svg[kIconCount];
+
+uint8_t* LegacyRender(int index, int size, uint32_t color) {
+    std::string colored = InjectColor(s_svg[index].c_str(), color);
+
+    auto doc = lunasvg::Document::loadFromData(colored);
+    if (!doc) return nullptr;
+
+    auto bitmap = doc->renderToBitmap(size, size);
+    if (!bitmap.valid()) return nullptr;
+
+    size_t bytes = static_cast<size_t>(size) * size * 4;
+    auto* out = static_cast<uint8_t*>(malloc(bytes));
+    if (!out) return nullptr;
+
+    const auto* src = bitmap.data();
+    for (size_t i = 0; i < bytes; i += 4) {
+        out[i + 0] = src[i + 2];
+        out[i + 1] = src[i + 1];
+        out[i + 2] = src[i + 0];
+        out[i + 3] = src[i + 3];
+    }
+    return out;
+}
+
+template <typename Fn>
+double MicrosPerIcon(int size, Fn&& render) {
+    auto start = std::chrono::steady_clock::now();
+    int calls = 0;
+    for (int r = 0; r < kRounds; r++) {
+        for (int i = 0; i < kIconCount; i++) {
+            render(i, size, kColors[calls++ & 1]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / calls;
+}
+
+} // namespace
+
+int main() {
+    printf("Lucide render benchmark: %d icons x %d rounds\n\n", kIconCount, kRounds);
+    printf("%6s  %14s  %14s  %8s\n", "size", "legacy us/icon", "cached us/icon", "speedup");
+
+    for (int i = 0; i < kIconCount; i++) {
+        if (!lucide::DecodeIconSvg(i, s_svg[i])) {
+            fprintf(stderr, "cannot decode %s\n", kIcons[i].name);
+            return 1;
+        }
+    }
+
+    // Warm the document cache so the first size isn't charged for parsing.
+    for (int i = 0; i < kIconCount; i++)
+        LucideFree(LucideRenderIcon(kIcons[i].name, 16, kColors[0]));
+
+    for (int size : kSizes) {
+        double legacy = MicrosPerIcon(size, [](int i, int sz, uint32_t color) {
+            free(LegacyRender(i, sz, color));
+        });
+        double cached = MicrosPerIcon(size, [](int i, int sz, uint32_t color) {
+            LucideFree(LucideRenderIcon(kIcons[i].name, sz, color));
+        });
+        printf("%6d  %14.2f  %14.2f  %7.2fx\n", size, legacy, cached, legacy / cached);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// ── Lucide SDF Benchmark ────────────────────────────────────
+// Quality and speed of SDF reconstruction against direct rasterization of
+// the compiled path, per size, over every compiled icon. Exits non-zero
+// if the mean coverage error at any size exceeds kMaxMeanError.
+// Portable: builds and runs on Linux.
+
+#include "icons_data.h"
+#include "path_raster.h"
+#include "sdf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace lucide;
+
+namespace {
+
+constexpr int    kSizes[]      = { 16, 20, 24, 32, 36, 48, 64, 96, 128, 256 };
+constexpr int    kRounds       = 20;
+constexpr double kMaxMeanError = 4.0;    // coverage units, over covered pixels
+
+using Clock = std::chrono::steady_clock;
+
+double Us(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double, std::micro>(b - a).count();
+}
+
+} // namespace
+
+int main() {
+    std::vector<int> icons;
+    for (int i = 0; i < kIconCount; i++)
+        if (kIcons[i].pathSize) icons.push_back(i);
+    if (icons.empty()) {
+        fprintf(stderr, "no compiled icons\n");
+        return 1;
+    }
+
+    std::vector<std::vector<uint8_t>> fields(icons.size(),
+        std::vector<uint8_t>(static_cast<size_t>(kSdfSize) * kSdfSize));
+    auto buildStart = Clock::now();
+    for (size_t k = 0; k < icons.size(); k++) {
+        auto& icon = kIcons[icons[k]];
+        if (!BuildSdf(kIconPathData + icon.pathOffset, icon.pathSize, fields[k].data())) {
+            fprintf(stderr, "%s: field build failed\n", icon.name);
+            return 1;
+        }
+    }
+    auto buildEnd = Clock::now();
+
+    printf("Lucide SDF benchmark: %zu icons, %dx%d fields (%zu bytes each), "
+           "built in %.1f us/icon\n\n",
+        icons.size(), kSdfSize, kSdfSize, fields[0].size(),
+        Us(buildStart, buildEnd) / icons.size());
+    printf("%5s  %10s  %10s  %8s  %8s  %9s\n",
+        "size", "direct us", "sdf us", "speedup", "max err", "mean err");
+
+    bool failed = false;
+    for (int size : kSizes) {
+        size_t pixels = static_cast<size_t>(size) * size;
+        std::vector<uint8_t> direct(pixels), sdf(pixels);
+        double directUs = 0, sdfUs = 0, meanSum = 0;
+        int maxErr = 0;
+
+        for (size_t k = 0; k < icons.size(); k++) {
+            auto& icon = kIcons[icons[k]];
+            const uint8_t* path = kIconPathData + icon.pathOffset;
+
+            auto t0 = Clock::now();
+            for (int r = 0; r < kRounds; r++)
+                RasterizePathMask(path, icon.pathSize, size, direct.data(), size);
+            auto t1 = Clock::now();
+            for (int r = 0; r < kRounds; r++)
+                RenderSdfMask(fields[k].data(), size, sdf.data(), size);
+            auto t2 = Clock::now();
+            directUs += Us(t0, t1) / kRounds;
+            sdfUs    += Us(t1, t2) / kRounds;
+
+            uint64_t sum = 0;
+            size_t covered = 0;
+            for (size_t i = 0; i < pixels; i++) {
+                if (!direct[i] && !sdf[i]) continue;
+                int e = std::abs(direct[i] - sdf[i]);
+                maxErr = std::max(maxErr, e);
+                sum += e;
+                covered++;
+            }
+            meanSum += covered ? static_cast<double>(sum) / covered : 0.0;
+        }
+
+        double n = static_cast<double>(icons.size());
+        double mean = meanSum / n;
+        if (mean > kMaxMeanError) failed = true;
+        printf("%5d  %10.2f  %10.2f  %7.2fx  %8d  %9.2f%s\n", size,
+            directUs / n, sdfUs / n, directUs / sdfUs, maxErr, mean,
+            mean > kMaxMeanError ? "  FAIL" : "");
+    }
+
+    if (failed) {
+        printf("\nFAILED: SDF reconstruction error above %.1f\n", kMaxMeanError);
+        return 1;
+    }
+    printf("\nSDF reconstruction within %.1f mean coverage of direct\n", kMaxMeanError);
+    return 0;
+}
@@ -6,21 +6,46 @@
 extern "C" {
 #endif
 
-#ifdef LUCIDE_BUILD
+#if !defined(_WIN32)
+    #define LUCIDE_API __attribute__((visibility("default")))
+#elif defined(LUCIDE_BUILD)
     #define LUCIDE_API __declspec(dllexport)
 #else
     #define LUCIDE_API __declspec(dllimport)
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
-/// Get the number of available icons.
+/// Pixel layouts understood by the render and conversion entry points.
+typedef enum LucidePixelFormat {
+    LUCIDE_FORMAT_RGBA_PREMUL   = 0,  ///< D2D R8G8B8A8 (LucideRenderIcon output)
+    LUCIDE_FORMAT_BGRA_PREMUL   = 1,  ///< DIB sections, D2D B8G8R8A8, AlphaBlend
+    LUCIDE_FORMAT_RGBA_STRAIGHT = 2,  ///< PNG export
+    LUCIDE_FORMAT_BGRA_STRAIGHT = 3,
+    LUCIDE_FORMAT_A8            = 4,  ///< 8-bit coverage; LucideRenderIconInto only
+} LucidePixelFormat;
+
+/// How icons with a compiled stroke path are rasterized.
+typedef enum LucideRenderMode {
+    LUCIDE_RENDER_DIRECT = 0,  ///< Exact vector rasterization per size (default)
+    LUCIDE_RENDER_SDF    = 1,  ///< Resample a per-icon distance field built once
+} LucideRenderMode;
+
+/// Get the number of available icons: the embedded set plus every loaded
+/// icon pack (see LucideLoadIconPack).
 LUCIDE_API int LucideGetIconCount(void);
 
 /// Get the name of an icon by index (0-based).
 /// Returns nullptr if index is out of range.
 LUCIDE_API const char* LucideGetIconName(int index);
 
+/// Look up an icon's index by name. The lookup is a perfect-hash probe and
+/// one string compare; resolve once and use the *Index entry points on
+/// hot paths.
+/// @return Icon index, or -1 if no icon has that name.
+LUCIDE_API int LucideFindIcon(const char* name);
+
 /// Render an icon to an RGBA8888 bitmap.
 /// @param name   Icon name (e.g. "refresh", "settings")
 /// @param size   Output bitmap width and height in pixels
@@ -29,9 +54,40 @@ LUCIDE_API const char* LucideGetIconName(int index);
 ///               Caller must free with LucideFree().
 LUCIDE_API uint8_t* LucideRenderIcon(const char* name, int size, uint32_t color);
 
+/// LucideRenderIcon by index (see LucideFindIcon).
+LUCIDE_API uint8_t* LucideRenderIconIndex(int index, int size, uint32_t color);
+
+/// Render an icon straight into caller-owned memory, with no intermediate
+/// allocation or copy: a DIB section's bits, a locked texture, or a
+/// sub-rectangle of an atlas.
+/// @param name    Icon name
+/// @param size    Width and height in pixels
+/// @param color   Icon stroke color as 0xRRGGBB (ignored for A8)
+/// @param dst     First byte of the size×size destination block
+/// @param stride  Destination bytes per row (>= size * bytes per pixel)
+/// @param format  LucidePixelFormat of dst
+/// @return        1 on success, 0 on failure. The block is fully written on
+///                success; memory outside it is never touched.
+LUCIDE_API int LucideRenderIconInto(const char* name, int size, uint32_t color,
+                                    void* dst, int stride, int format);
+
+/// LucideRenderIconInto by index (see LucideFindIcon).
+LUCIDE_API int LucideRenderIconIntoIndex(int index, int size, uint32_t color,
+                                         void* dst, int stride, int format);
+
 /// Free memory returned by LucideRenderIcon.
 LUCIDE_API void LucideFree(void* ptr);
 
+/// Memory-map an icon pack built with `lucide_gen --pack` and append its
+/// icons to the icon table, so extensions can ship icons without
+/// rebuilding Lucide.dll. Lookups read the mapped file in place; the pack
+/// stays loaded until the process exits. Embedded icons and earlier packs
+/// win name clashes.
+/// @param path  Pack file
+/// @return      Index of the pack's first icon (its icons are sorted by
+///              name), or -1 if the file can't be mapped or is malformed.
+LUCIDE_API int LucideLoadIconPack(const wchar_t* path);
+
 /// Render an icon and create a Win32 HBITMAP (premultiplied alpha, top-down DIB).
 /// @param name   Icon name
 /// @param size   Bitmap width and height in pixels
@@ -39,6 +95,155 @@ LUCIDE_API void LucideFree(void* ptr);
 /// @return       HBITMAP handle, or NULL on failure. Caller must DeleteObject().
 LUCIDE_API void* LucideCreateHBitmap(const char* name, int size, uint32_t color);
 
+/// Read-only icon raster owned by the Lucide raster cache.
+typedef struct LucideRaster {
+    const uint8_t* pixels;  ///< Premultiplied RGBA, or 8-bit coverage for masks
+    int            size;    ///< Width and height in pixels
+    int            stride;  ///< Bytes per row
+} LucideRaster;
+
+/// Raster cache counters, for sizing the budget.
+typedef struct LucideCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytesInUse;
+    uint64_t budgetBytes;
+    uint64_t diskHits;      ///< Misses served from the persistent cache file
+    uint64_t diskWrites;    ///< Rasters appended to the persistent cache file
+} LucideCacheStats;
+
+/// Borrow a cached rendering of an icon, rasterizing it on a cache miss.
+/// A hit performs no allocation or copy. The pixels stay valid until the
+/// matching LucideReleaseIcon(), even if the entry is evicted meanwhile.
+/// @param name   Icon name
+/// @param size   Bitmap width and height in pixels
+/// @param color  Icon stroke color as 0xRRGGBB
+/// @return       Ref-counted raster, or nullptr on failure.
+LUCIDE_API const LucideRaster* LucideAcquireIcon(const char* name, int size, uint32_t color);
+
+/// LucideAcquireIcon by index (see LucideFindIcon).
+LUCIDE_API const LucideRaster* LucideAcquireIconIndex(int index, int size, uint32_t color);
+
+/// Return a raster obtained from LucideAcquireIcon. Accepts nullptr.
+LUCIDE_API void LucideReleaseIcon(const LucideRaster* raster);
+
+/// Render an icon's 8-bit alpha coverage mask. The mask does not depend on
+/// color, so one mask per (icon, size) serves every theme and state;
+/// tint it at draw time (D2D FillOpacityMask, or LucideTintMask).
+/// @param name  Icon name
+/// @param size  Mask width and height in pixels
+/// @return      size*size bytes of coverage (0 = empty, 255 = fully inside
+///              the stroke), or nullptr on failure. Free with LucideFree().
+LUCIDE_API uint8_t* LucideRenderMask(const char* name, int size);
+
+/// LucideRenderMask by index (see LucideFindIcon).
+LUCIDE_API uint8_t* LucideRenderMaskIndex(int index, int size);
+
+/// Borrow a cached coverage mask (stride == size). Shares the raster cache
+/// budget; return it with LucideReleaseIcon().
+LUCIDE_API const LucideRaster* LucideAcquireIconMask(const char* name, int size);
+
+/// LucideAcquireIconMask by index (see LucideFindIcon).
+LUCIDE_API const LucideRaster* LucideAcquireIconMaskIndex(int index, int size);
+
+/// LucideAcquireIconMaskIndex for a mask already in the memory cache: a
+/// lookup that never renders, cheap enough for a paint handler.
+/// @return  Ref-counted raster, or nullptr if not cached. Release with
+///          LucideReleaseIcon().
+LUCIDE_API const LucideRaster* LucidePeekIconMaskIndex(int index, int size);
+
+/// Tint a coverage mask with a 0xRRGGBB color into 32-bit pixels using the
+/// fastest SIMD kernel the CPU supports.
+/// @param mask        Coverage bytes
+/// @param maskStride  Mask bytes per row
+/// @param width       Pixels per row
+/// @param height      Rows
+/// @param color       Color as 0xRRGGBB
+/// @param dst         Destination pixels
+/// @param dstStride   Destination bytes per row
+/// @param dstFormat   LucidePixelFormat of dst
+/// @return            1 on success, 0 for bad arguments or an unknown format.
+LUCIDE_API int LucideTintMask(const uint8_t* mask, int maskStride, int width, int height,
+                              uint32_t color, void* dst, int dstStride, int dstFormat);
+
+/// Select the render mode for all subsequent renders. SDF mode builds a
+/// small distance field per icon on first use and reconstructs every size
+/// from it, so DPI and size changes cost a resample rather than a vector
+/// rasterization, at slightly softer corners at large sizes. Icons without
+/// a compiled path always render through lunasvg. Changing the mode empties
+/// the raster cache.
+/// @return 1 on success, 0 for an unknown mode.
+LUCIDE_API int LucideSetRenderMode(int mode);
+
+/// Current LucideRenderMode.
+LUCIDE_API int LucideGetRenderMode(void);
+
+/// Set the raster cache budget in bytes of pixel data (default 16 MiB).
+/// Least-recently-used entries are evicted immediately if over budget.
+LUCIDE_API void LucideSetCacheBudget(size_t bytes);
+
+/// Read the raster cache hit/miss/eviction counters.
+LUCIDE_API void LucideGetCacheStats(LucideCacheStats* stats);
+
+/// Rasters also persist across launches in a cache file, by default
+/// Lucide.cache next to Lucide.dll. It is memory-mapped read-only on first
+/// use, so a warm launch hands out pixels without rendering; rasters it
+/// lacks are appended from a background thread. Files written by another
+/// build of Lucide.dll, and damaged records, are ignored and replaced.
+/// @param path  Cache file to use from the next lookup on, or nullptr to
+///              turn the disk cache off. Rasters already borrowed stay valid.
+LUCIDE_API void LucideSetDiskCachePath(const wchar_t* path);
+
+/// Block until every raster queued for the disk cache has been written.
+LUCIDE_API void LucideFlushDiskCache(void);
+
+/// Convert pixels between LucidePixelFormat layouts using the fastest
+/// SIMD kernels the CPU supports. src and dst may be the same buffer.
+/// @param src        Source pixels
+/// @param srcFormat  LucidePixelFormat of src
+/// @param dst        Destination pixels (pixels*4 bytes)
+/// @param dstFormat  LucidePixelFormat of dst
+/// @param pixels     Number of pixels
+/// @return           1 on success, 0 for an unknown format.
+LUCIDE_API int LucideConvertPixels(const void* src, int srcFormat,
+                                   void* dst, int dstFormat, size_t pixels);
+
+/// One request in a batch render.
+typedef struct LucideBatchItem {
+    const char* name;    ///< in:  icon name, or nullptr to use `index`
+    int         index;   ///< in:  icon index when name is nullptr
+    int         size;    ///< in:  width and height in pixels
+    uint32_t    color;   ///< in:  stroke color as 0xRRGGBB
+    int         x;       ///< in/out: left edge of the icon's atlas rectangle
+    int         y;       ///< in/out: top edge of the icon's atlas rectangle
+    int         status;  ///< out: 1 if rendered, 0 on failure
+} LucideBatchItem;
+
+/// Assign atlas rectangles to a batch by shelf packing.
+/// Callers that manage their own layout can fill x/y themselves instead.
+/// @param items       Requests; x and y are written
+/// @param count       Number of requests
+/// @param atlasWidth  Atlas width in pixels
+/// @return            Atlas height required, or -1 if an icon is wider than the atlas.
+LUCIDE_API int LucideLayoutIconBatch(LucideBatchItem* items, int count, int atlasWidth);
+
+/// Rasterize a batch of icons in parallel into one premultiplied RGBA atlas.
+/// Each icon is written to the size×size rectangle at (x, y); pixels outside
+/// the item rectangles are not touched.
+/// @param items    Requests with x/y filled in; status is written
+/// @param count    Number of requests
+/// @param atlas    Caller-owned RGBA buffer
+/// @param width    Atlas width in pixels
+/// @param height   Atlas height in pixels
+/// @param stride   Atlas bytes per row
+/// @param threads  Maximum threads to use; <= 0 uses every hardware thread
+/// @return         Number of icons rendered successfully.
+LUCIDE_API int LucideRenderIconBatch(LucideBatchItem* items, int count,
+                                     uint8_t* atlas, int width, int height, int stride,
+                                     int threads);
+
 #ifdef __cplusplus
 }
 #endif
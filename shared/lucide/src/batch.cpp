@@ -0,0 +1,65 @@
+#include "batch.h"
+#include "icon_render.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace lucide {
+
+int LayoutBatch(LucideBatchItem* items, int count, int atlasWidth) {
+    if (!items || count < 0 || atlasWidth <= 0) return -1;
+
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [items](int a, int b) {
+        return items[a].size > items[b].size;
+    });
+
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int i : order) {
+        auto& item = items[i];
+        if (item.size <= 0) { item.x = item.y = 0; continue; }
+        if (item.size > atlasWidth) return -1;
+
+        if (x + item.size > atlasWidth) {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+        item.x = x;
+        item.y = y;
+        x += item.size;
+        shelfHeight = std::max(shelfHeight, item.size);
+    }
+    return y + shelfHeight;
+}
+
+int RenderBatch(LucideBatchItem* items, const int* indices, int count,
+                uint8_t* atlas, int atlasWidth, int atlasHeight, int stride,
+                int threads)
+{
+    std::atomic<int> rendered{0};
+
+    ParallelFor(count, threads, [&](int i) {
+        auto& item = items[i];
+        item.status = 0;
+        if (item.size <= 0 || item.x < 0 || item.y < 0
+            || item.x + item.size > atlasWidth
+            || item.y + item.size > atlasHeight)
+            return;
+
+        uint8_t* dst = atlas + static_cast<size_t>(item.y) * stride
+                             + static_cast<size_t>(item.x) * 4;
+        if (RenderIconInto(indices[i], item.size, item.color, dst, stride,
+                           LUCIDE_FORMAT_RGBA_PREMUL)) {
+            item.status = 1;
+            rendered.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    return rendered.load();
+}
+
+} // namespace lucide
@@ -0,0 +1,22 @@
+#pragma once
+// ── Batch Rendering ─────────────────────────────────────────
+// Shelf-packs a set of icon requests into one atlas and rasterizes them
+// in parallel on the worker pool.
+
+#include "lucide.h"
+
+namespace lucide {
+
+/// Assign x/y to every item by shelf packing (tallest first) into an
+/// atlas `atlasWidth` pixels wide. Returns the atlas height required, or
+/// -1 if an item is wider than the atlas.
+int LayoutBatch(LucideBatchItem* items, int count, int atlasWidth);
+
+/// Rasterize items[i] (icon `indices[i]`) into its rectangle of the RGBA
+/// atlas using up to `threads` threads. Sets each item's status and
+/// returns how many rendered successfully.
+int RenderBatch(LucideBatchItem* items, const int* indices, int count,
+                uint8_t* atlas, int atlasWidth, int atlasHeight, int stride,
+                int threads);
+
+} // namespace lucide
@@ -0,0 +1,494 @@
+#include "disk_cache.h"
+#include "icon_render.h"
+#include "icons_data.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <windows.h>
+
+namespace lucide {
+
+// ── File format ─────────────────────────────────────────────
+// FileHeader, then 8-byte aligned records back to back. A record is a
+// RecordHeader followed by its pixels, zero-padded to 8 bytes. Pad
+// records only cover the remains of an interrupted append.
+namespace {
+
+constexpr char     kMagic[8]        = { 'L', 'U', 'C', 'I', 'D', 'E', 'R', 'C' };
+constexpr uint32_t kFormatVersion   = 1;
+constexpr uint32_t kRecordTag       = 0x52524344;   // "DCRR"
+constexpr uint32_t kPadTag          = 0x44415044;   // "DPAD"
+constexpr uint64_t kMaxFileBytes    = 64ull << 20;
+constexpr size_t   kMaxQueuedBytes  = 8u << 20;
+constexpr wchar_t  kFileName[]      = L"Lucide.cache";
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerBytes;
+    uint64_t build;         // BuildHash() of the DLL that wrote the file
+    uint64_t reserved;
+};
+
+struct RecordHeader {
+    uint32_t tag;
+    uint32_t checksum;      // RecordChecksum()
+    uint64_t key;           // raster cache key
+    uint32_t size;          // width and height
+    uint16_t bpp;           // 4: premultiplied RGBA, 1: coverage mask
+    uint16_t mode;          // LucideRenderMode it was rendered in
+    uint32_t bytes;         // pixel bytes, before padding
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 32 && sizeof(RecordHeader) == 32);
+
+uint64_t Align8(uint64_t n) { return (n + 7) & ~7ull; }
+
+// Word-at-a-time hash over the header (checksum zeroed) and pixels. It
+// only has to catch torn writes and stray damage, and must stay far
+// cheaper than rendering the raster again.
+uint32_t RecordChecksum(const RecordHeader& header, const uint8_t* pixels) {
+    uint64_t acc = 0x9E3779B97F4A7C15ull;
+    auto mix = [&acc](uint64_t v) {
+        acc ^= v;
+        acc *= 0xFF51AFD7ED558CCDull;
+        acc ^= acc >> 32;
+    };
+
+    RecordHeader copy = header;
+    copy.checksum = 0;
+    uint64_t words[sizeof(copy) / 8];
+    memcpy(words, &copy, sizeof(copy));
+    for (uint64_t w : words) mix(w);
+
+    size_t i = 0;
+    for (; i + 8 <= header.bytes; i += 8) {
+        uint64_t w;
+        memcpy(&w, pixels + i, 8);
+        mix(w);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, pixels + i, header.bytes - i);
+    mix(tail ^ header.bytes);
+    return static_cast<uint32_t>(acc ^ (acc >> 32));
+}
+
+// Can `h` be a record with `remaining` bytes of file after its header?
+bool Plausible(const RecordHeader& h, uint64_t remaining) {
+    if (h.tag == kPadTag) return Align8(h.bytes) <= remaining;
+    if (h.tag != kRecordTag) return false;
+    if (h.size == 0 || h.size > 0xFFFF || (h.bpp != 1 && h.bpp != 4)) return false;
+    if (h.bytes != static_cast<uint64_t>(h.size) * h.size * h.bpp) return false;
+    return Align8(h.bytes) <= remaining;
+}
+
+HMODULE ThisModule() {
+    HMODULE module = nullptr;
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                       GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                       reinterpret_cast<LPCWSTR>(&ThisModule), &module);
+    return module;
+}
+
+// Changes with every link of Lucide.dll (PE timestamp, image size and
+// checksum) and with the shape of the embedded icon set.
+uint64_t BuildHash() {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+
+    if (auto* base = reinterpret_cast<const uint8_t*>(ThisModule())) {
+        auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        auto* nt  = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+        mix(nt->FileHeader.TimeDateStamp);
+        mix(nt->OptionalHeader.SizeOfImage);
+        mix(nt->OptionalHeader.CheckSum);
+    }
+    mix(kIconCount);
+    mix(sizeof(kIconPathData));
+    mix(sizeof(kIconSvgData));
+    return h;
+}
+
+std::wstring DefaultPath() {
+    wchar_t buffer[MAX_PATH];
+    DWORD len = GetModuleFileNameW(ThisModule(), buffer, MAX_PATH);
+    if (len == 0 || len >= MAX_PATH) return {};
+
+    std::wstring path(buffer, len);
+    size_t slash = path.find_last_of(L"\\/");
+    path.resize(slash == std::wstring::npos ? 0 : slash + 1);
+    return path + kFileName;
+}
+
+// Inter-process lock on one byte far past any real data, so it never
+// blocks I/O on the records themselves. Readers share it while mapping;
+// writers hold it exclusively while appending.
+class FileLock {
+public:
+    FileLock(HANDLE file, bool exclusive) : m_file(file) {
+        OVERLAPPED ov{};
+        ov.OffsetHigh = 0x7FFFFFFF;
+        m_locked = LockFileEx(file, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0, &ov) != 0;
+    }
+    ~FileLock() {
+        if (!m_locked) return;
+        OVERLAPPED ov{};
+        ov.OffsetHigh = 0x7FFFFFFF;
+        UnlockFileEx(m_file, 0, 1, 0, &ov);
+    }
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    bool Locked() const { return m_locked; }
+
+private:
+    HANDLE m_file;
+    bool   m_locked = false;
+};
+
+bool ReadAt(HANDLE file, uint64_t offset, void* data, DWORD bytes) {
+    OVERLAPPED ov{};
+    ov.Offset     = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    return ReadFile(file, data, bytes, &done, &ov) && done == bytes;
+}
+
+bool WriteAt(HANDLE file, uint64_t offset, const void* data, DWORD bytes) {
+    OVERLAPPED ov{};
+    ov.Offset     = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    return WriteFile(file, data, bytes, &done, &ov) && done == bytes;
+}
+
+// ── Cache file ──────────────────────────────────────────────
+// One file, mapped once. The index is built at open and never changes, so
+// lookups take no lock. Stores are never destroyed: handed-out pixels
+// point into the mapping.
+class DiskStore {
+public:
+    DiskStore(std::wstring path, uint64_t build)
+        : m_path(std::move(path)), m_build(build)
+    {
+        Map();
+    }
+
+    const uint8_t* Find(uint64_t key, int size, int bpp, uint32_t mode) const {
+        auto it = m_index.find(RecordKey{ key, mode });
+        if (it == m_index.end()) return nullptr;
+
+        const RecordHeader* h = it->second;
+        if (h->size != static_cast<uint32_t>(size) || h->bpp != bpp) return nullptr;
+        auto* pixels = reinterpret_cast<const uint8_t*>(h + 1);
+        return RecordChecksum(*h, pixels) == h->checksum ? pixels : nullptr;
+    }
+
+    // True the first time a raster missing from the file is offered, so
+    // one evicted and re-rendered repeatedly is still written only once.
+    // Caller holds the DiskCache lock.
+    bool Claim(uint64_t key, uint32_t mode) {
+        RecordKey k{ key, mode };
+        return !m_index.contains(k) && m_claimed.insert(k).second;
+    }
+
+    // Writer thread only.
+    bool Append(const RecordHeader& header, const uint8_t* pixels) {
+        if (m_writeFailed) return false;
+        if (m_writer == INVALID_HANDLE_VALUE) {
+            m_writer = CreateFileW(m_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_writer == INVALID_HANDLE_VALUE) {
+                m_writeFailed = true;
+                return false;
+            }
+        }
+
+        FileLock lock(m_writer, true);
+        uint64_t end = 0;
+        if (!lock.Locked() || !PrepareTail(end)) {
+            m_writeFailed = true;
+            return false;
+        }
+
+        uint64_t padded = Align8(header.bytes);
+        if (end + sizeof(RecordHeader) + padded > kMaxFileBytes) return false;
+
+        static constexpr uint8_t kZeros[8] = {};
+        bool ok = WriteAt(m_writer, end, &header, sizeof(header))
+               && WriteAt(m_writer, end + sizeof(header), pixels, header.bytes)
+               && (padded == header.bytes ||
+                   WriteAt(m_writer, end + sizeof(header) + header.bytes, kZeros,
+                           static_cast<DWORD>(padded - header.bytes)));
+        m_knownEnd = ok ? end + sizeof(header) + padded : 0;
+        return ok;
+    }
+
+private:
+    struct RecordKey {
+        uint64_t key;
+        uint32_t mode;
+        bool operator==(const RecordKey&) const = default;
+    };
+    struct RecordKeyHash {
+        size_t operator()(const RecordKey& k) const {
+            return std::hash<uint64_t>{}(k.key ^ (static_cast<uint64_t>(k.mode) << 62));
+        }
+    };
+
+    std::wstring m_path;
+    uint64_t     m_build;
+    std::unordered_map<RecordKey, const RecordHeader*, RecordKeyHash> m_index;
+    std::unordered_set<RecordKey, RecordKeyHash>                      m_claimed;
+
+    HANDLE   m_writer      = INVALID_HANDLE_VALUE;
+    bool     m_writeFailed = false;
+    uint64_t m_knownEnd    = 0;     // end of the last record this process verified
+
+    bool HeaderMatches(const FileHeader& h) const {
+        return memcmp(h.magic, kMagic, sizeof(kMagic)) == 0
+            && h.version == kFormatVersion
+            && h.headerBytes == sizeof(FileHeader)
+            && h.build == m_build;
+    }
+
+    void Map() {
+        HANDLE file = CreateFileW(m_path.c_str(), GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        // Hold the shared lock while mapping so no append is half-written
+        // inside the mapped range.
+        const uint8_t* view = nullptr;
+        uint64_t size = 0;
+        {
+            FileLock lock(file, false);
+            LARGE_INTEGER li{};
+            if (lock.Locked() && GetFileSizeEx(file, &li)) size = static_cast<uint64_t>(li.QuadPart);
+            if (size >= sizeof(FileHeader) && size <= kMaxFileBytes) {
+                if (HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+                    view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                    CloseHandle(mapping);
+                }
+            }
+        }
+        CloseHandle(file);
+        if (!view) return;
+
+        FileHeader header;
+        memcpy(&header, view, sizeof(header));
+        if (!HeaderMatches(header)) {
+            UnmapViewOfFile(view);
+            return;
+        }
+
+        // A damaged tail ends the walk; every record before it stays usable.
+        uint64_t offset = sizeof(FileHeader);
+        while (offset + sizeof(RecordHeader) <= size) {
+            auto* h = reinterpret_cast<const RecordHeader*>(view + offset);
+            if (!Plausible(*h, size - offset - sizeof(RecordHeader))) break;
+            if (h->tag == kRecordTag)
+                m_index.try_emplace(RecordKey{ h->key, h->mode }, h);
+            offset += sizeof(RecordHeader) + Align8(h->bytes);
+        }
+    }
+
+    // Caller holds the exclusive file lock. Finds where the next record
+    // goes, starting the file over if it is missing, stale or foreign and
+    // covering a torn tail with a pad record.
+    bool PrepareTail(uint64_t& end) {
+        LARGE_INTEGER li{};
+        if (!GetFileSizeEx(m_writer, &li)) return false;
+        uint64_t size = static_cast<uint64_t>(li.QuadPart);
+
+        FileHeader header{};
+        if (size < sizeof(header) || !ReadAt(m_writer, 0, &header, sizeof(header)) ||
+            !HeaderMatches(header))
+        {
+            // Truncation fails while another process still maps the old
+            // file; the disk cache then stays read-only for this session.
+            LARGE_INTEGER zero{};
+            if (!SetFilePointerEx(m_writer, zero, nullptr, FILE_BEGIN) || !SetEndOfFile(m_writer))
+                return false;
+            memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version     = kFormatVersion;
+            header.headerBytes = sizeof(FileHeader);
+            header.build       = m_build;
+            header.reserved    = 0;
+            if (!WriteAt(m_writer, 0, &header, sizeof(header))) return false;
+            end = m_knownEnd = sizeof(header);
+            return true;
+        }
+
+        // Other processes may have appended since; walk their records.
+        uint64_t offset = (m_knownEnd >= sizeof(header) && m_knownEnd <= size)
+            ? m_knownEnd : sizeof(header);
+        RecordHeader h;
+        while (offset + sizeof(h) <= size && ReadAt(m_writer, offset, &h, sizeof(h)) &&
+               Plausible(h, size - offset - sizeof(h)))
+            offset += sizeof(h) + Align8(h.bytes);
+
+        if (offset < size) {
+            RecordHeader pad{};
+            pad.tag   = kPadTag;
+            pad.bytes = static_cast<uint32_t>(
+                size - offset > sizeof(pad) ? Align8(size - offset - sizeof(pad)) : 0);
+            if (!WriteAt(m_writer, offset, &pad, sizeof(pad))) return false;
+            offset += sizeof(pad) + pad.bytes;
+        }
+        end = m_knownEnd = offset;
+        return true;
+    }
+};
+
+// ── Background writer ───────────────────────────────────────
+
+struct PendingRecord {
+    DiskStore*                 store;
+    RecordHeader               header;
+    std::unique_ptr<uint8_t[]> pixels;
+};
+
+struct DiskCache {
+    std::mutex                lock;
+    std::condition_variable   wake;
+    std::condition_variable   idle;
+    bool                      opened  = false;
+    bool                      enabled = true;
+    std::wstring              path;           // empty: DefaultPath()
+    DiskStore*                store   = nullptr;
+    uint64_t                  build   = 0;
+    std::deque<PendingRecord> queue;
+    size_t                    queuedBytes   = 0;
+    bool                      writing       = false;
+    bool                      writerStarted = false;
+    std::atomic<uint64_t>     hits{0};
+    std::atomic<uint64_t>     writes{0};
+};
+
+// Never destroyed, like the worker pool: the writer thread is detached and
+// may still be using it while the process exits.
+DiskCache& Disk() {
+    static DiskCache* disk = new DiskCache;
+    return *disk;
+}
+
+// Caller holds disk.lock.
+DiskStore* OpenStore(DiskCache& disk) {
+    if (!disk.opened) {
+        disk.opened = true;
+        if (disk.enabled) {
+            if (disk.build == 0) disk.build = BuildHash();
+            std::wstring path = disk.path.empty() ? DefaultPath() : disk.path;
+            if (!path.empty()) disk.store = new DiskStore(std::move(path), disk.build);
+        }
+    }
+    return disk.store;
+}
+
+void WriterLoop() {
+    auto& disk = Disk();
+    for (;;) {
+        PendingRecord record;
+        {
+            std::unique_lock<std::mutex> guard(disk.lock);
+            disk.wake.wait(guard, [&disk]() { return !disk.queue.empty(); });
+            record = std::move(disk.queue.front());
+            disk.queue.pop_front();
+            disk.writing = true;
+        }
+
+        if (record.store->Append(record.header, record.pixels.get()))
+            disk.writes.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(disk.lock);
+        disk.queuedBytes -= record.header.bytes;
+        disk.writing = false;
+        if (disk.queue.empty()) disk.idle.notify_all();
+    }
+}
+
+} // namespace
+
+const uint8_t* FindDiskRaster(uint64_t key, int size, int bpp) {
+    auto& disk = Disk();
+    DiskStore* store;
+    {
+        std::lock_guard<std::mutex> guard(disk.lock);
+        store = OpenStore(disk);
+    }
+    if (!store) return nullptr;
+
+    const uint8_t* pixels = store->Find(key, size, bpp, static_cast<uint32_t>(GetRenderMode()));
+    if (pixels) disk.hits.fetch_add(1, std::memory_order_relaxed);
+    return pixels;
+}
+
+void StoreDiskRaster(uint64_t key, int size, int bpp, const uint8_t* pixels) {
+    RecordHeader header{};
+    header.tag   = kRecordTag;
+    header.key   = key;
+    header.size  = static_cast<uint32_t>(size);
+    header.bpp   = static_cast<uint16_t>(bpp);
+    header.mode  = static_cast<uint16_t>(GetRenderMode());
+    header.bytes = static_cast<uint32_t>(size) * size * bpp;
+
+    auto& disk = Disk();
+    std::lock_guard<std::mutex> guard(disk.lock);
+    DiskStore* store = OpenStore(disk);
+    if (!store || disk.queuedBytes + header.bytes > kMaxQueuedBytes) return;
+    if (!store->Claim(key, header.mode)) return;
+
+    auto copy = std::make_unique<uint8_t[]>(header.bytes);
+    memcpy(copy.get(), pixels, header.bytes);
+    header.checksum = RecordChecksum(header, copy.get());
+
+    disk.queue.push_back(PendingRecord{ store, header, std::move(copy) });
+    disk.queuedBytes += header.bytes;
+    if (!disk.writerStarted) {
+        disk.writerStarted = true;
+        // Never joined, for the same loader-lock reason as the worker pool.
+        std::thread(WriterLoop).detach();
+    }
+    disk.wake.notify_one();
+}
+
+void SetDiskCachePath(const wchar_t* path) {
+    auto& disk = Disk();
+    std::lock_guard<std::mutex> guard(disk.lock);
+    // The previous store stays alive: borrowed rasters may point into it,
+    // and queued records still go to it.
+    disk.opened  = false;
+    disk.store   = nullptr;
+    disk.enabled = path != nullptr;
+    disk.path    = path ? path : L"";
+}
+
+void FlushDiskCache() {
+    auto& disk = Disk();
+    std::unique_lock<std::mutex> guard(disk.lock);
+    disk.idle.wait(guard, [&disk]() { return disk.queue.empty() && !disk.writing; });
+}
+
+void GetDiskStats(uint64_t& hits, uint64_t& writes) {
+    auto& disk = Disk();
+    hits   = disk.hits.load(std::memory_order_relaxed);
+    writes = disk.writes.load(std::memory_order_relaxed);
+}
+
+} // namespace lucide
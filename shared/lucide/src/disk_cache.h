@@ -0,0 +1,31 @@
+#pragma once
+// ── Persistent Raster Cache ─────────────────────────────────
+// Rasters survive across launches in a cache file, by default
+// Lucide.cache next to Lucide.dll. The file is mapped read-only the first
+// time it is needed and hits hand out pixels straight from the mapping;
+// new rasters are appended by a background thread. A header tied to the
+// DLL build and a checksum on every record keep stale or damaged files
+// from being used.
+
+#include <cstdint>
+
+namespace lucide {
+
+/// Pixels stored for raster-cache `key` (size×size, `bpp` bytes each) in
+/// the current render mode, or nullptr. Valid for the life of the process.
+const uint8_t* FindDiskRaster(uint64_t key, int size, int bpp);
+
+/// Queue a copy of a freshly rendered raster to be appended to the file.
+void StoreDiskRaster(uint64_t key, int size, int bpp, const uint8_t* pixels);
+
+/// Use the cache file at `path` from the next lookup on; nullptr turns the
+/// disk cache off.
+void SetDiskCachePath(const wchar_t* path);
+
+/// Block until every queued raster has been written.
+void FlushDiskCache();
+
+/// Lookups served from the file, and records appended to it.
+void GetDiskStats(uint64_t& hits, uint64_t& writes);
+
+} // namespace lucide
@@ -0,0 +1,24 @@
+#include "disk_cache.h"
+
+namespace lucide {
+
+// ── No persistent cache ─────────────────────────────────────
+// Hosts without Win32 file mapping (the portable benchmarks) keep rasters
+// in memory only; the raster cache treats every lookup as a miss.
+
+const uint8_t* FindDiskRaster(uint64_t, int, int) {
+    return nullptr;
+}
+
+void StoreDiskRaster(uint64_t, int, int, const uint8_t*) {}
+
+void SetDiskCachePath(const wchar_t*) {}
+
+void FlushDiskCache() {}
+
+void GetDiskStats(uint64_t& hits, uint64_t& writes) {
+    hits   = 0;
+    writes = 0;
+}
+
+} // namespace lucide
@@ -0,0 +1,103 @@
+#include "document_cache.h"
+#include "icon_source.h"
+#include "icon_svg.h"
+#include "lucide.h"
+#include "pixel_convert.h"
+#include "slot_table.h"
+
+#include <lunasvg.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace lucide {
+
+// ── Document slots ──────────────────────────────────────────
+// One slot per icon index, embedded or from a pack. The document is
+// parsed on first use and kept for the lifetime of the DLL. The per-icon
+// mutex serializes stroke mutation and rendering of that document;
+// different icons render concurrently.
+namespace {
+
+constexpr uint32_t kNoStroke = 0xFFFFFFFFu;
+
+struct DocumentSlot {
+    std::once_flag                     parsed;
+    std::unique_ptr<lunasvg::Document> doc;
+    std::mutex                         lock;
+    uint32_t                           stroke = kNoStroke;
+};
+
+SlotTable<DocumentSlot> s_slots;
+
+lunasvg::Document* GetDocument(int index) {
+    auto& slot = s_slots[index];
+    std::call_once(slot.parsed, [&slot, index]() {
+        // The text is only needed for the parse; the document outlives it.
+        IconData icon;
+        std::string svg;
+        if (GetIcon(index, icon) && DecodeIconSvg(icon, svg))
+            slot.doc = lunasvg::Document::loadFromData(svg.data(), svg.size());
+    });
+    return slot.doc.get();
+}
+
+// Lucide SVGs declare stroke="currentColor" on the root <svg> element and
+// every shape inherits it, so overriding the root attribute recolors the
+// whole icon.
+void ApplyStroke(DocumentSlot& slot, uint32_t color) {
+    color &= 0xFFFFFF;
+    if (slot.stroke == color) return;
+
+    char hex[8];
+    snprintf(hex, sizeof(hex), "#%02X%02X%02X",
+        (color >> 16) & 0xFF,
+        (color >>  8) & 0xFF,
+        (color      ) & 0xFF
+    );
+    slot.doc->documentElement().setAttribute("stroke", hex);
+    slot.doc->forceLayout();
+    slot.stroke = color;
+}
+
+} // namespace
+
+bool RenderDocumentInto(int index, int size, uint32_t color,
+                        uint8_t* dst, int stride, int format)
+{
+    if (index < 0 || index >= IconCount() || size <= 0) return false;
+    if (format < LUCIDE_FORMAT_RGBA_PREMUL || format > LUCIDE_FORMAT_BGRA_STRAIGHT) return false;
+
+    auto* doc = GetDocument(index);
+    if (!doc) return false;
+
+    size_t rowBytes = static_cast<size_t>(size) * 4;
+    for (int y = 0; y < size; y++)
+        memset(dst + static_cast<size_t>(y) * stride, 0, rowBytes);
+
+    lunasvg::Bitmap bitmap(dst, size, size, stride);
+    lunasvg::Matrix scale(
+        static_cast<float>(size) / doc->width(), 0,
+        0, static_cast<float>(size) / doc->height(),
+        0, 0);
+    {
+        auto& slot = s_slots[index];
+        std::lock_guard<std::mutex> guard(slot.lock);
+        ApplyStroke(slot, color);
+        doc->render(bitmap, scale);
+    }
+
+    // lunasvg renders BGRA premultiplied; convert in place if asked for
+    // anything else.
+    if (format != LUCIDE_FORMAT_BGRA_PREMUL) {
+        for (int y = 0; y < size; y++) {
+            uint8_t* row = dst + static_cast<size_t>(y) * stride;
+            ConvertPixels(row, LUCIDE_FORMAT_BGRA_PREMUL, row, format, static_cast<size_t>(size));
+        }
+    }
+    return true;
+}
+
+} // namespace lucide
@@ -0,0 +1,19 @@
+#pragma once
+// ── Parsed Icon Documents ───────────────────────────────────
+// Each icon is parsed once into a long-lived lunasvg document.
+// Recoloring changes the stroke attribute on the parsed tree instead of
+// rewriting SVG text and re-parsing it.
+
+#include <cstdint>
+
+namespace lucide {
+
+/// Render icon `index` at size×size with a 0xRRGGBB stroke color straight
+/// into caller memory: a block of 32-bit `format` pixels (a 32-bit
+/// LucidePixelFormat) at `dst` with `stride` bytes per row. The block is
+/// cleared first; memory outside it is not touched. Returns false if the
+/// index or format is invalid or the SVG failed to parse.
+bool RenderDocumentInto(int index, int size, uint32_t color,
+                        uint8_t* dst, int stride, int format);
+
+} // namespace lucide
@@ -0,0 +1,24 @@
+#pragma once
+// ── Icon Name Hash ──────────────────────────────────────────
+// Shared by lucide_gen (which builds the perfect-hash tables) and the
+// runtime lookup, so both sides always agree on bucket and slot.
+
+#include <cstdint>
+#include <string_view>
+
+namespace lucide {
+
+/// Seeded FNV-1a with a final avalanche step.
+constexpr uint32_t IconHash(std::string_view name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+} // namespace lucide
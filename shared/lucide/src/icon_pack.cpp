@@ -0,0 +1,78 @@
+#include "icon_pack.h"
+#include "path_format.h"
+
+#include <cstring>
+
+namespace lucide {
+
+namespace {
+
+bool InRange(uint64_t offset, uint64_t bytes, uint64_t total) {
+    return offset <= total && bytes <= total - offset;
+}
+
+} // namespace
+
+bool IconPack::Open(const uint8_t* data, size_t size) {
+    if (!data || size < sizeof(pack::Header)) return false;
+
+    pack::Header header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, pack::kMagic, sizeof(pack::kMagic)) != 0 ||
+        header.version != pack::kVersion || header.fileSize != size)
+        return false;
+
+    // Entries are read in place, so they must be aligned in memory too.
+    auto entriesAddress = reinterpret_cast<uintptr_t>(data) + header.entriesOffset;
+    if (entriesAddress % alignof(pack::Entry) != 0 ||
+        !InRange(header.entriesOffset, uint64_t(header.iconCount) * sizeof(pack::Entry), size) ||
+        !InRange(header.dictOffset, header.dictSize, size))
+        return false;
+
+    m_data    = data;
+    m_entries = reinterpret_cast<const pack::Entry*>(data + header.entriesOffset);
+
+    for (uint32_t i = 0; i < header.iconCount; i++) {
+        const pack::Entry& e = m_entries[i];
+        if (!InRange(e.nameOffset, uint64_t(e.nameLength) + 1, size) ||
+            data[e.nameOffset + e.nameLength] != 0 ||
+            !InRange(e.svgOffset, e.svgSize, size) ||
+            !InRange(e.pathOffset, e.pathSize, size))
+            return false;
+        if (e.pathSize != 0 &&
+            (e.pathSize < path::kHeaderSize || data[e.pathOffset] != path::kVersion))
+            return false;
+
+        // Strictly increasing: binary search works and names are unique.
+        if (i > 0 && !(Name(i - 1) < Name(i))) return false;
+    }
+
+    m_count    = header.iconCount;
+    m_dict     = data + header.dictOffset;
+    m_dictSize = header.dictSize;
+    return true;
+}
+
+int IconPack::Find(std::string_view name) const {
+    uint32_t lo = 0, hi = m_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (Name(mid) < name) lo = mid + 1;
+        else                  hi = mid;
+    }
+    return lo < m_count && Name(lo) == name ? static_cast<int>(lo) : -1;
+}
+
+void IconPack::Get(int i, IconData& out) const {
+    const pack::Entry& e = m_entries[i];
+    out.name        = reinterpret_cast<const char*>(m_data + e.nameOffset);
+    out.svgDict     = m_dict;
+    out.svgDictSize = m_dictSize;
+    out.svg         = m_data + e.svgOffset;
+    out.svgSize     = e.svgSize;
+    out.svgLength   = e.svgLength;
+    out.path        = m_data + e.pathOffset;
+    out.pathSize    = e.pathSize;
+}
+
+} // namespace lucide
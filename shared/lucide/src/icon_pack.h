@@ -0,0 +1,42 @@
+#pragma once
+// ── Icon Pack Reader ────────────────────────────────────────
+// Zero-copy view of one icon pack (pack_format.h). Open() validates every
+// offset once, so later lookups index straight into the pack bytes.
+
+#include "icon_source.h"
+#include "pack_format.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace lucide {
+
+class IconPack {
+public:
+    /// Validate `size` bytes at `data` and adopt them. The bytes must
+    /// outlive the view. Returns false for a malformed pack.
+    bool Open(const uint8_t* data, size_t size);
+
+    int Count() const { return static_cast<int>(m_count); }
+
+    /// Pack-local index of `name`, or -1; binary search over the index.
+    int Find(std::string_view name) const;
+
+    /// Icon `i` of the pack, 0 <= i < Count().
+    void Get(int i, IconData& out) const;
+
+private:
+    const uint8_t*     m_data    = nullptr;
+    const pack::Entry* m_entries = nullptr;
+    uint32_t           m_count   = 0;
+    const uint8_t*     m_dict    = nullptr;
+    uint32_t           m_dictSize = 0;
+
+    std::string_view Name(uint32_t i) const {
+        return { reinterpret_cast<const char*>(m_data + m_entries[i].nameOffset),
+                 m_entries[i].nameLength };
+    }
+};
+
+} // namespace lucide
@@ -0,0 +1,21 @@
+#pragma once
+// ── Icon Registry ───────────────────────────────────────────
+// Name → index lookup over the generated perfect-hash table. No
+// allocation and no startup construction; usable in constant expressions.
+
+#include "icons_data.h"
+#include "icon_hash.h"
+
+#include <string_view>
+
+namespace lucide {
+
+/// Index of the embedded icon called `name`, or -1 if there is none.
+constexpr int FindEmbeddedIcon(std::string_view name) {
+    uint32_t bucket = IconHash(name, 0) % kIconHashBuckets;
+    uint32_t slot   = IconHash(name, kIconHashSeeds[bucket]) % kIconCount;
+    int index = kIconHashSlots[slot];
+    return name == kIcons[index].name ? index : -1;
+}
+
+} // namespace lucide
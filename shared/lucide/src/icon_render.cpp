@@ -0,0 +1,101 @@
+#include "icon_render.h"
+#include "icon_source.h"
+#include "lucide.h"
+#include "document_cache.h"
+#include "path_raster.h"
+#include "pixel_convert.h"
+#include "sdf.h"
+
+#include <atomic>
+#include <vector>
+
+namespace lucide {
+
+namespace {
+
+std::atomic<int> s_renderMode{ LUCIDE_RENDER_DIRECT };
+
+// Per-thread scratch so batch workers don't allocate per icon.
+uint8_t* MaskScratch(size_t bytes) {
+    thread_local std::vector<uint8_t> buffer;
+    if (buffer.size() < bytes) buffer.resize(bytes);
+    return buffer.data();
+}
+
+uint8_t* PixelScratch(size_t bytes) {
+    thread_local std::vector<uint8_t> buffer;
+    if (buffer.size() < bytes) buffer.resize(bytes);
+    return buffer.data();
+}
+
+bool RasterizeCompiled(int index, int size, uint8_t* mask, int stride) {
+    IconData icon;
+    if (!GetIcon(index, icon) || icon.pathSize == 0) return false;
+
+    if (s_renderMode.load(std::memory_order_relaxed) == LUCIDE_RENDER_SDF) {
+        if (const uint8_t* field = IconSdf(index)) {
+            RenderSdfMask(field, size, mask, stride);
+            return true;
+        }
+    }
+    return RasterizePathMask(icon.path, icon.pathSize, size, mask, stride);
+}
+
+} // namespace
+
+bool SetRenderMode(int mode) {
+    if (mode != LUCIDE_RENDER_DIRECT && mode != LUCIDE_RENDER_SDF) return false;
+    s_renderMode.store(mode, std::memory_order_relaxed);
+    return true;
+}
+
+int GetRenderMode() {
+    return s_renderMode.load(std::memory_order_relaxed);
+}
+
+bool HasCompiledPath(int index) {
+    IconData icon;
+    return GetIcon(index, icon) && icon.pathSize != 0;
+}
+
+bool RenderIconInto(int index, int size, uint32_t color,
+                    uint8_t* dst, int stride, int format)
+{
+    if (index < 0 || index >= IconCount() || size <= 0) return false;
+    if (format == LUCIDE_FORMAT_A8) return RenderIconMask(index, size, dst, stride);
+    if (format < LUCIDE_FORMAT_RGBA_PREMUL || format > LUCIDE_FORMAT_BGRA_STRAIGHT) return false;
+
+    uint8_t* mask = MaskScratch(static_cast<size_t>(size) * size);
+    if (!RasterizeCompiled(index, size, mask, size))
+        return RenderDocumentInto(index, size, color, dst, stride, format);
+
+    for (int y = 0; y < size; y++) {
+        TintPixels(mask + static_cast<size_t>(y) * size, dst + static_cast<size_t>(y) * stride,
+                   format, static_cast<size_t>(size), color);
+    }
+    return true;
+}
+
+bool RenderIconRGBA(int index, int size, uint32_t color, uint8_t* dst) {
+    return RenderIconInto(index, size, color, dst, size * 4, LUCIDE_FORMAT_RGBA_PREMUL);
+}
+
+bool RenderIconMask(int index, int size, uint8_t* mask, int stride) {
+    if (index < 0 || index >= IconCount() || size <= 0) return false;
+    if (RasterizeCompiled(index, size, mask, stride)) return true;
+
+    // lunasvg fallback: stroked in white, premultiplied alpha is exactly
+    // the coverage. BGRA is lunasvg's native order, so no conversion pass.
+    uint8_t* bgra = PixelScratch(static_cast<size_t>(size) * size * 4);
+    if (!RenderDocumentInto(index, size, 0xFFFFFF, bgra, size * 4, LUCIDE_FORMAT_BGRA_PREMUL))
+        return false;
+
+    for (int y = 0; y < size; y++) {
+        const uint8_t* src = bgra + static_cast<size_t>(y) * size * 4;
+        uint8_t* row = mask + static_cast<size_t>(y) * stride;
+        for (int x = 0; x < size; x++) row[x] = src[x * 4 + 3];
+    }
+    return true;
+}
+
+} // namespace lucide
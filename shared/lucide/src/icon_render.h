@@ -0,0 +1,34 @@
+#pragma once
+// ── Icon Rendering ──────────────────────────────────────────
+// Single entry point for turning an embedded icon into pixels. Icons with
+// a compiled path (see path_format.h) go through the path rasterizer, or
+// through their distance field in LUCIDE_RENDER_SDF mode; the rest fall
+// back to their parsed lunasvg document.
+
+#include <cstdint>
+
+namespace lucide {
+
+/// Select how compiled icons are rasterized (a LucideRenderMode).
+/// Returns false for an unknown mode.
+bool SetRenderMode(int mode);
+int  GetRenderMode();
+
+/// True if icon `index` has a compiled path and skips lunasvg.
+bool HasCompiledPath(int index);
+
+/// Render icon `index` into a size×size block of LucidePixelFormat
+/// `format` pixels at `dst` with `stride` bytes per row. The block is
+/// fully overwritten; memory outside it is not touched. Returns false on
+/// failure or an unknown format.
+bool RenderIconInto(int index, int size, uint32_t color,
+                    uint8_t* dst, int stride, int format);
+
+/// RenderIconInto with a tightly packed premultiplied RGBA destination.
+bool RenderIconRGBA(int index, int size, uint32_t color, uint8_t* dst);
+
+/// Render the color-independent 8-bit coverage mask of icon `index` into
+/// a size×size block at `mask` with `stride` bytes per row.
+bool RenderIconMask(int index, int size, uint8_t* mask, int stride);
+
+} // namespace lucide
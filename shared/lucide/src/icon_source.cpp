@@ -0,0 +1,91 @@
+#include "icon_source.h"
+#include "icon_pack.h"
+#include "icon_registry.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace lucide {
+
+// ── Pack list ───────────────────────────────────────────────
+// Append-only. A pack is fully constructed before it is published by the
+// release store of s_packCount, and s_iconCount only grows after that, so
+// readers never lock.
+namespace {
+
+constexpr int kMaxPacks = 64;
+
+struct LoadedPack {
+    IconPack pack;
+    int      base = 0;
+};
+
+std::mutex        s_loadLock;
+const LoadedPack* s_packs[kMaxPacks];
+std::atomic<int>  s_packCount{0};
+std::atomic<int>  s_iconCount{kIconCount};
+
+} // namespace
+
+int IconCount() {
+    return s_iconCount.load(std::memory_order_acquire);
+}
+
+bool GetIcon(int index, IconData& out) {
+    if (index < 0) return false;
+
+    if (index < kIconCount) {
+        auto& icon = kIcons[index];
+        out.name        = icon.name;
+        out.svgDict     = kIconSvgDict;
+        out.svgDictSize = sizeof(kIconSvgDict);
+        out.svg         = kIconSvgData + icon.svgOffset;
+        out.svgSize     = icon.svgSize;
+        out.svgLength   = icon.svgLength;
+        out.path        = kIconPathData + icon.pathOffset;
+        out.pathSize    = icon.pathSize;
+        return true;
+    }
+
+    int packs = s_packCount.load(std::memory_order_acquire);
+    for (int p = 0; p < packs; p++) {
+        const LoadedPack* loaded = s_packs[p];
+        if (index < loaded->base + loaded->pack.Count()) {
+            loaded->pack.Get(index - loaded->base, out);
+            return true;
+        }
+    }
+    return false;
+}
+
+int FindIcon(std::string_view name) {
+    int index = FindEmbeddedIcon(name);
+    if (index >= 0) return index;
+
+    int packs = s_packCount.load(std::memory_order_acquire);
+    for (int p = 0; p < packs; p++) {
+        const LoadedPack* loaded = s_packs[p];
+        int local = loaded->pack.Find(name);
+        if (local >= 0) return loaded->base + local;
+    }
+    return -1;
+}
+
+int AddIconPack(const uint8_t* data, size_t size) {
+    auto loaded = std::make_unique<LoadedPack>();
+    if (!loaded->pack.Open(data, size)) return -1;
+
+    std::lock_guard<std::mutex> guard(s_loadLock);
+    int packs = s_packCount.load(std::memory_order_relaxed);
+    int base  = s_iconCount.load(std::memory_order_relaxed);
+    if (packs == kMaxPacks || loaded->pack.Count() > kMaxIcons - base) return -1;
+
+    loaded->base = base;
+    s_packs[packs] = loaded.release();
+    s_packCount.store(packs + 1, std::memory_order_release);
+    s_iconCount.store(base + s_packs[packs]->pack.Count(), std::memory_order_release);
+    return base;
+}
+
+} // namespace lucide
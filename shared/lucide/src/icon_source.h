@@ -0,0 +1,43 @@
+#pragma once
+// ── Icon Table ──────────────────────────────────────────────
+// Every icon Lucide can render: the embedded set at indices
+// [0, kIconCount), then each loaded icon pack in load order. Indices never
+// change once handed out, and packs stay mapped until the process exits,
+// so all pointers here are valid for the life of the process.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace lucide {
+
+/// Upper bound on embedded plus pack icons; per-icon tables are sized by it.
+constexpr int kMaxIcons = 1 << 16;
+
+struct IconData {
+    const char*    name;
+    const uint8_t* svgDict;     // svg_codec.h dictionary
+    size_t         svgDictSize;
+    const uint8_t* svg;         // compressed stream
+    uint32_t       svgSize;
+    uint32_t       svgLength;   // decoded bytes
+    const uint8_t* path;        // compiled path (path_format.h)
+    uint32_t       pathSize;    // 0: no compiled path, use lunasvg
+};
+
+/// Embedded plus loaded icons.
+int IconCount();
+
+/// Look up icon `index`. Returns false if there is no such icon.
+bool GetIcon(int index, IconData& out);
+
+/// Index of the icon called `name`, or -1. Embedded icons win over pack
+/// icons of the same name, and earlier packs over later ones.
+int FindIcon(std::string_view name);
+
+/// Register a validated icon pack (pack_format.h) that stays readable at
+/// `data` for the life of the process. Returns the index of its first
+/// icon, or -1 if the pack is malformed or would exceed kMaxIcons.
+int AddIconPack(const uint8_t* data, size_t size);
+
+} // namespace lucide
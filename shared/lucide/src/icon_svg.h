@@ -0,0 +1,35 @@
+#pragma once
+// ── Icon SVG Text ───────────────────────────────────────────
+// Access to the minified SVG text of an icon. The text is stored
+// compressed (see svg_codec.h) and decoded on request; callers keep the
+// parsed result, not the text.
+
+#include "icon_source.h"
+#include "icons_data.h"
+#include "svg_codec.h"
+
+#include <string>
+
+namespace lucide {
+
+/// Decode the SVG text of `icon` into `out`. Returns false for a corrupt
+/// stream.
+inline bool DecodeIconSvg(const IconData& icon, std::string& out) {
+    out.resize(icon.svgLength);
+    return DecodeSvg(icon.svgDict, icon.svgDictSize, icon.svg, icon.svgSize,
+                     out.data(), out.size());
+}
+
+/// Decode the SVG text of embedded icon `index` into `out`. Returns false
+/// for an invalid index or a corrupt stream.
+inline bool DecodeIconSvg(int index, std::string& out) {
+    if (index < 0 || index >= kIconCount) return false;
+
+    auto& icon = kIcons[index];
+    out.resize(icon.svgLength);
+    return DecodeSvg(kIconSvgDict, sizeof(kIconSvgDict),
+                     kIconSvgData + icon.svgOffset, icon.svgSize,
+                     out.data(), out.size());
+}
+
+} // namespace lucide
@@ -1,44 +1,23 @@
 #include "lucide.h"
-#include "icons_data.h"
+#include "icon_source.h"
+#include "icon_render.h"
+#include "raster_cache.h"
+#include "disk_cache.h"
+#include "batch.h"
+#include "pixel_convert.h"
 
-#include <lunasvg.h>
-#include <cstring>
-#include <string>
-#include <unordered_map>
-#include <mutex>
-#include <memory>
+#include <cstdlib>
+#include <vector>
 
 #include <windows.h>
 
 // ── Icon Registry ───────────────────────────────────────────
-static std::unordered_map<std::string, int>& GetNameIndex() {
-    static std::unordered_map<std::string, int> map = []() {
-        std::unordered_map<std::string, int> m;
-        for (int i = 0; i < kIconCount; i++)
-            m[kIcons[i].name] = i;
-        return m;
-    }();
-    return map;
-}
-
-// ── Color injection ─────────────────────────────────────────
-// Lucide SVGs use stroke="currentColor". We replace it with the requested color.
-static std::string InjectColor(const char* svg, uint32_t color) {
-    char hex[8];
-    snprintf(hex, sizeof(hex), "#%02X%02X%02X",
-        (color >> 16) & 0xFF,
-        (color >>  8) & 0xFF,
-        (color      ) & 0xFF
-    );
-
-    std::string result(svg);
-    const std::string target = "currentColor";
-    size_t pos = 0;
-    while ((pos = result.find(target, pos)) != std::string::npos) {
-        result.replace(pos, target.length(), hex);
-        pos += 7;
-    }
-    return result;
+static int ResolveIcon(const char* name) {
+    return name ? lucide::FindIcon(name) : -1;
+}
+
+static bool ValidIcon(int index) {
+    return index >= 0 && index < lucide::IconCount();
 }
 
 // ── Public API ──────────────────────────────────────────────
@@ -46,63 +25,83 @@ static std::string InjectColor(const char* svg, uint32_t color) {
 extern "C" {
 
 LUCIDE_API int LucideGetIconCount(void) {
-    return kIconCount;
+    return lucide::IconCount();
 }
 
 LUCIDE_API const char* LucideGetIconName(int index) {
-    if (index < 0 || index >= kIconCount) return nullptr;
-    return kIcons[index].name;
+    lucide::IconData icon;
+    return lucide::GetIcon(index, icon) ? icon.name : nullptr;
 }
 
-LUCIDE_API uint8_t* LucideRenderIcon(const char* name, int size, uint32_t color) {
-    if (!name || size <= 0) return nullptr;
-
-    auto& idx = GetNameIndex();
-    auto it = idx.find(name);
-    if (it == idx.end()) return nullptr;
-
-    std::string colored = InjectColor(kIcons[it->second].svg, color);
+LUCIDE_API int LucideFindIcon(const char* name) {
+    return ResolveIcon(name);
+}
 
-    auto doc = lunasvg::Document::loadFromData(colored);
-    if (!doc) return nullptr;
+LUCIDE_API uint8_t* LucideRenderIcon(const char* name, int size, uint32_t color) {
+    return LucideRenderIconIndex(ResolveIcon(name), size, color);
+}
 
-    auto bitmap = doc->renderToBitmap(size, size);
-    if (!bitmap.valid()) return nullptr;
+LUCIDE_API uint8_t* LucideRenderIconIndex(int index, int size, uint32_t color) {
+    if (!ValidIcon(index) || size <= 0) return nullptr;
 
     size_t bytes = static_cast<size_t>(size) * size * 4;
     auto* out = static_cast<uint8_t*>(malloc(bytes));
     if (!out) return nullptr;
 
-    // lunasvg renders BGRA premultiplied — convert to RGBA
-    const auto* src = bitmap.data();
-    for (size_t i = 0; i < bytes; i += 4) {
-        out[i + 0] = src[i + 2]; // R (from B)
-        out[i + 1] = src[i + 1]; // G
-        out[i + 2] = src[i + 0]; // B (from R)
-        out[i + 3] = src[i + 3]; // A
+    if (!lucide::RenderIconRGBA(index, size, color, out)) {
+        free(out);
+        return nullptr;
     }
-
     return out;
 }
 
-LUCIDE_API void LucideFree(void* ptr) {
-    free(ptr);
+LUCIDE_API int LucideRenderIconInto(const char* name, int size, uint32_t color,
+                                    void* dst, int stride, int format)
+{
+    return LucideRenderIconIntoIndex(ResolveIcon(name), size, color, dst, stride, format);
 }
 
-LUCIDE_API void* LucideCreateHBitmap(const char* name, int size, uint32_t color) {
-    if (!name || size <= 0) return nullptr;
+LUCIDE_API int LucideRenderIconIntoIndex(int index, int size, uint32_t color,
+                                         void* dst, int stride, int format)
+{
+    if (!ValidIcon(index) || size <= 0 || !dst) return 0;
+    int bpp = format == LUCIDE_FORMAT_A8 ? 1 : 4;
+    if (stride < size * bpp) return 0;
+    return lucide::RenderIconInto(index, size, color, static_cast<uint8_t*>(dst),
+                                  stride, format) ? 1 : 0;
+}
+
+LUCIDE_API int LucideLoadIconPack(const wchar_t* path) {
+    if (!path) return -1;
 
-    auto& idx = GetNameIndex();
-    auto it = idx.find(name);
-    if (it == idx.end()) return nullptr;
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return -1;
+
+    LARGE_INTEGER size{};
+    const uint8_t* view = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= 0x7FFFFFFF) {
+        if (HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+            view = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    if (!view) return -1;
 
-    std::string colored = InjectColor(kIcons[it->second].svg, color);
+    // Mapped for good on success: icon names and documents point into it.
+    int first = lucide::AddIconPack(view, static_cast<size_t>(size.QuadPart));
+    if (first < 0) UnmapViewOfFile(view);
+    return first;
+}
 
-    auto doc = lunasvg::Document::loadFromData(colored);
-    if (!doc) return nullptr;
+LUCIDE_API void LucideFree(void* ptr) {
+    free(ptr);
+}
 
-    auto bitmap = doc->renderToBitmap(size, size);
-    if (!bitmap.valid()) return nullptr;
+LUCIDE_API void* LucideCreateHBitmap(const char* name, int size, uint32_t color) {
+    int index = ResolveIcon(name);
+    if (index < 0 || size <= 0) return nullptr;
 
     // Create a top-down 32-bit DIB section
     BITMAPINFO bmi{};
@@ -117,10 +116,131 @@ LUCIDE_API void* LucideCreateHBitmap(const char* name, int size, uint32_t color)
     HBITMAP hbm = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
     if (!hbm || !bits) return nullptr;
 
-    // lunasvg outputs BGRA premultiplied — perfect for Win32 AlphaBlend
-    memcpy(bits, bitmap.data(), static_cast<size_t>(size) * size * 4);
-
+    // Render straight into the DIB bits as BGRA premultiplied, the layout
+    // Win32 AlphaBlend expects.
+    if (!lucide::RenderIconInto(index, size, color, static_cast<uint8_t*>(bits),
+                                size * 4, LUCIDE_FORMAT_BGRA_PREMUL)) {
+        DeleteObject(hbm);
+        return nullptr;
+    }
     return hbm;
 }
 
+LUCIDE_API const LucideRaster* LucideAcquireIcon(const char* name, int size, uint32_t color) {
+    return LucideAcquireIconIndex(ResolveIcon(name), size, color);
+}
+
+LUCIDE_API const LucideRaster* LucideAcquireIconIndex(int index, int size, uint32_t color) {
+    if (!ValidIcon(index) || size <= 0) return nullptr;
+    return lucide::AcquireRaster(index, size, color);
+}
+
+LUCIDE_API void LucideReleaseIcon(const LucideRaster* raster) {
+    lucide::ReleaseRaster(raster);
+}
+
+LUCIDE_API uint8_t* LucideRenderMask(const char* name, int size) {
+    return LucideRenderMaskIndex(ResolveIcon(name), size);
+}
+
+LUCIDE_API uint8_t* LucideRenderMaskIndex(int index, int size) {
+    if (!ValidIcon(index) || size <= 0) return nullptr;
+
+    auto* out = static_cast<uint8_t*>(malloc(static_cast<size_t>(size) * size));
+    if (!out) return nullptr;
+
+    if (!lucide::RenderIconMask(index, size, out, size)) {
+        free(out);
+        return nullptr;
+    }
+    return out;
+}
+
+LUCIDE_API const LucideRaster* LucideAcquireIconMask(const char* name, int size) {
+    return LucideAcquireIconMaskIndex(ResolveIcon(name), size);
+}
+
+LUCIDE_API const LucideRaster* LucideAcquireIconMaskIndex(int index, int size) {
+    if (!ValidIcon(index) || size <= 0) return nullptr;
+    return lucide::AcquireMask(index, size);
+}
+
+LUCIDE_API const LucideRaster* LucidePeekIconMaskIndex(int index, int size) {
+    if (!ValidIcon(index) || size <= 0) return nullptr;
+    return lucide::PeekMask(index, size);
+}
+
+LUCIDE_API int LucideTintMask(const uint8_t* mask, int maskStride, int width, int height,
+                              uint32_t color, void* dst, int dstStride, int dstFormat)
+{
+    if (!mask || !dst || width <= 0 || height <= 0 ||
+        maskStride < width || dstStride < width * 4)
+        return 0;
+
+    auto* out = static_cast<uint8_t*>(dst);
+    for (int y = 0; y < height; y++) {
+        if (!lucide::TintPixels(mask + static_cast<size_t>(y) * maskStride,
+                                out + static_cast<size_t>(y) * dstStride,
+                                dstFormat, static_cast<size_t>(width), color))
+            return 0;
+    }
+    return 1;
+}
+
+LUCIDE_API int LucideSetRenderMode(int mode) {
+    if (mode == lucide::GetRenderMode()) return 1;
+    if (!lucide::SetRenderMode(mode)) return 0;
+    lucide::PurgeRasters();
+    return 1;
+}
+
+LUCIDE_API int LucideGetRenderMode(void) {
+    return lucide::GetRenderMode();
+}
+
+LUCIDE_API void LucideSetCacheBudget(size_t bytes) {
+    lucide::SetRasterBudget(bytes);
+}
+
+LUCIDE_API void LucideGetCacheStats(LucideCacheStats* stats) {
+    if (!stats) return;
+    lucide::GetRasterStats(*stats);
+    lucide::GetDiskStats(stats->diskHits, stats->diskWrites);
+}
+
+LUCIDE_API void LucideSetDiskCachePath(const wchar_t* path) {
+    lucide::SetDiskCachePath(path);
+}
+
+LUCIDE_API void LucideFlushDiskCache(void) {
+    lucide::FlushDiskCache();
+}
+
+LUCIDE_API int LucideConvertPixels(const void* src, int srcFormat,
+                                   void* dst, int dstFormat, size_t pixels)
+{
+    if (!src || !dst) return 0;
+    return lucide::ConvertPixels(static_cast<const uint8_t*>(src), srcFormat,
+                                 static_cast<uint8_t*>(dst), dstFormat, pixels) ? 1 : 0;
+}
+
+LUCIDE_API int LucideLayoutIconBatch(LucideBatchItem* items, int count, int atlasWidth) {
+    return lucide::LayoutBatch(items, count, atlasWidth);
+}
+
+LUCIDE_API int LucideRenderIconBatch(LucideBatchItem* items, int count,
+                                     uint8_t* atlas, int width, int height, int stride,
+                                     int threads)
+{
+    if (!items || count <= 0 || !atlas || width <= 0 || height <= 0 || stride < width * 4)
+        return 0;
+
+    std::vector<int> indices(count);
+    for (int i = 0; i < count; i++)
+        indices[i] = items[i].name ? ResolveIcon(items[i].name) : items[i].index;
+
+    return lucide::RenderBatch(items, indices.data(), count,
+                               atlas, width, height, stride, threads);
+}
+
 } // extern "C"
@@ -0,0 +1,46 @@
+#pragma once
+// ── Icon Pack Format ────────────────────────────────────────
+// Memory-mappable file of additional icons, written by
+// `lucide_gen --pack` and loaded with LucideLoadIconPack. Everything is
+// used in place; loading only validates offsets.
+//
+//   Header
+//   Entry[iconCount]   sorted by name (bytewise), the lookup index
+//   names              NUL-terminated
+//   dictionary         shared SVG dictionary (svg_codec.h)
+//   payload            compressed SVG streams and compiled paths
+//                      (path_format.h)
+//
+// Offsets are from the start of the file; all values are little-endian.
+
+#include <cstdint>
+
+namespace lucide::pack {
+
+constexpr char     kMagic[8] = { 'L', 'U', 'C', 'I', 'D', 'E', 'P', 'K' };
+constexpr uint32_t kVersion  = 1;
+
+struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t iconCount;
+    uint32_t entriesOffset;
+    uint32_t dictOffset;
+    uint32_t dictSize;
+    uint32_t fileSize;
+};
+
+struct Entry {
+    uint32_t nameOffset;
+    uint32_t nameLength;    // excluding the NUL
+    uint32_t svgOffset;
+    uint32_t svgSize;       // compressed bytes
+    uint32_t svgLength;     // decoded bytes
+    uint32_t pathOffset;
+    uint32_t pathSize;      // 0: no compiled path, use lunasvg
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Entry) == 32);
+
+} // namespace lucide::pack
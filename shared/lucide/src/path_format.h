@@ -0,0 +1,31 @@
+#pragma once
+// ── Compiled Path Format ────────────────────────────────────
+// Binary command stream produced by lucide_gen for icons that use only
+// round-capped, round-joined, unfilled strokes (every stock Lucide
+// icon). Curves and arcs are flattened at build time, so the runtime
+// rasterizer sees nothing but polylines and circles.
+//
+//   header   u8 version, u8 viewBox width, u8 viewBox height, u8 0
+//   commands u8 opcode followed by its operands, until kOpEnd
+//
+// Coordinates are signed 8.8 fixed point in viewBox units, lengths are
+// unsigned 8.8; all multi-byte values are little-endian.
+
+#include <cstdint>
+
+namespace lucide::path {
+
+constexpr uint8_t kVersion    = 1;
+constexpr int     kHeaderSize = 4;
+constexpr float   kFixedScale = 1.0f / 256.0f;
+
+enum Op : uint8_t {
+    kOpEnd    = 0,   // —
+    kOpStroke = 1,   // u16 width: stroke width for following shapes
+    kOpMove   = 2,   // i16 x, i16 y: start a new subpath
+    kOpLine   = 3,   // i16 x, i16 y: line from the current point
+    kOpClose  = 4,   // —: line back to the subpath start
+    kOpCircle = 5,   // i16 cx, i16 cy, u16 r: stroked circle outline
+};
+
+} // namespace lucide::path
@@ -0,0 +1,199 @@
+#include "path_raster.h"
+#include "path_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace lucide {
+
+namespace {
+
+using namespace path;
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t len) : m_p(data), m_end(data + len) {}
+
+    bool U8(uint8_t& v) {
+        if (m_end - m_p < 1) return false;
+        v = *m_p++;
+        return true;
+    }
+
+    bool Coord(float& v) {
+        if (m_end - m_p < 2) return false;
+        auto raw = static_cast<int16_t>(m_p[0] | (m_p[1] << 8));
+        m_p += 2;
+        v = raw * kFixedScale;
+        return true;
+    }
+
+    bool Length(float& v) {
+        if (m_end - m_p < 2) return false;
+        auto raw = static_cast<uint16_t>(m_p[0] | (m_p[1] << 8));
+        m_p += 2;
+        v = raw * kFixedScale;
+        return true;
+    }
+
+private:
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+};
+
+// Visits every pixel whose center lies within `pad` of a shape's stroke
+// and hands the sink the signed distance from that center to the stroke
+// edge (negative inside).
+template <typename Sink>
+struct Canvas {
+    Sink& sink;
+    int   size;
+    float pad;
+
+    // Pixel rows/columns whose centers can be within `reach` of [lo, hi].
+    void Span(float lo, float hi, float reach, int& first, int& last) const {
+        first = std::max(0, static_cast<int>(std::floor(lo - reach - 0.5f)));
+        last  = std::min(size - 1, static_cast<int>(std::ceil(hi + reach - 0.5f)));
+    }
+
+    void Capsule(float ax, float ay, float bx, float by, float hw) {
+        float reach = hw + pad;
+        int x0, x1, y0, y1;
+        Span(std::min(ax, bx), std::max(ax, bx), reach, x0, x1);
+        Span(std::min(ay, by), std::max(ay, by), reach, y0, y1);
+
+        float dx = bx - ax, dy = by - ay;
+        float len2 = dx * dx + dy * dy;
+        float inv = len2 > 0.0f ? 1.0f / len2 : 0.0f;
+
+        for (int y = y0; y <= y1; y++) {
+            float py = y + 0.5f - ay;
+            for (int x = x0; x <= x1; x++) {
+                float px = x + 0.5f - ax;
+                float t = std::clamp((px * dx + py * dy) * inv, 0.0f, 1.0f);
+                float ex = px - t * dx, ey = py - t * dy;
+                sink(x, y, std::sqrt(ex * ex + ey * ey) - hw);
+            }
+        }
+    }
+
+    void Ring(float cx, float cy, float r, float hw) {
+        float reach = r + hw + pad;
+        int x0, x1, y0, y1;
+        Span(cx, cx, reach, x0, x1);
+        Span(cy, cy, reach, y0, y1);
+
+        for (int y = y0; y <= y1; y++) {
+            float py = y + 0.5f - cy;
+            for (int x = x0; x <= x1; x++) {
+                float px = x + 0.5f - cx;
+                sink(x, y, std::fabs(std::sqrt(px * px + py * py) - r) - hw);
+            }
+        }
+    }
+};
+
+// Decode the command stream and draw it onto `canvas` at size×size.
+template <typename Sink>
+bool Walk(const uint8_t* data, size_t len, Canvas<Sink>& canvas) {
+    if (!data || len < kHeaderSize || canvas.size <= 0) return false;
+    if (data[0] != kVersion || data[1] == 0 || data[2] == 0) return false;
+
+    // Same mapping lunasvg uses: viewBox stretched to size×size. Stroke
+    // widths scale by the mean of the two axes (they're equal for every
+    // stock icon).
+    float sx = static_cast<float>(canvas.size) / data[1];
+    float sy = static_cast<float>(canvas.size) / data[2];
+    float sw = 0.5f * (sx + sy);
+
+    Reader in(data + kHeaderSize, len - kHeaderSize);
+
+    float hw = 0.5f * sw;      // SVG default stroke-width is 1
+    float startX = 0, startY = 0, curX = 0, curY = 0;
+
+    for (;;) {
+        uint8_t op;
+        if (!in.U8(op)) return false;
+
+        switch (op) {
+        case kOpEnd:
+            return true;
+        case kOpStroke: {
+            float width;
+            if (!in.Length(width)) return false;
+            hw = 0.5f * width * sw;
+            break;
+        }
+        case kOpMove: {
+            float x, y;
+            if (!in.Coord(x) || !in.Coord(y)) return false;
+            startX = curX = x * sx;
+            startY = curY = y * sy;
+            break;
+        }
+        case kOpLine: {
+            float x, y;
+            if (!in.Coord(x) || !in.Coord(y)) return false;
+            x *= sx;
+            y *= sy;
+            canvas.Capsule(curX, curY, x, y, hw);
+            curX = x;
+            curY = y;
+            break;
+        }
+        case kOpClose:
+            canvas.Capsule(curX, curY, startX, startY, hw);
+            curX = startX;
+            curY = startY;
+            break;
+        case kOpCircle: {
+            float cx, cy, r;
+            if (!in.Coord(cx) || !in.Coord(cy) || !in.Length(r)) return false;
+            canvas.Ring(cx * sx, cy * sy, r * sw, hw);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+}
+
+} // namespace
+
+bool RasterizePathMask(const uint8_t* data, size_t len, int size,
+                       uint8_t* mask, int stride)
+{
+    if (!mask || size <= 0) return false;
+    for (int y = 0; y < size; y++)
+        memset(mask + static_cast<size_t>(y) * stride, 0, size);
+
+    // Coverage of a one-pixel box approximated from the center distance,
+    // max-combined so overlapping joins don't darken.
+    auto plot = [mask, stride](int x, int y, float distance) {
+        float cov = 0.5f - distance;
+        if (cov <= 0.0f) return;
+        auto value = static_cast<uint8_t>(std::min(cov, 1.0f) * 255.0f + 0.5f);
+        uint8_t& px = mask[static_cast<size_t>(y) * stride + x];
+        if (value > px) px = value;
+    };
+    Canvas<decltype(plot)> canvas{ plot, size, 0.5f };
+    return Walk(data, len, canvas);
+}
+
+bool RasterizePathDistance(const uint8_t* data, size_t len, int size, float range,
+                           float* field, int stride)
+{
+    if (!field || size <= 0 || range <= 0.0f) return false;
+    for (int y = 0; y < size; y++)
+        std::fill_n(field + static_cast<size_t>(y) * stride, size, range);
+
+    auto plot = [field, stride, range](int x, int y, float distance) {
+        float& px = field[static_cast<size_t>(y) * stride + x];
+        px = std::min(px, std::max(distance, -range));
+    };
+    Canvas<decltype(plot)> canvas{ plot, size, range };
+    return Walk(data, len, canvas);
+}
+
+} // namespace lucide
@@ -0,0 +1,25 @@
+#pragma once
+// ── Compiled Path Rasterizer ────────────────────────────────
+// Renders the command streams from path_format.h without lunasvg. Every
+// shape is a round-capped stroke, so each segment is a capsule and each
+// circle a ring: coverage is the clamped distance from the pixel center
+// to the shape, max-combined so overlapping joins don't darken.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lucide {
+
+/// Rasterize a compiled path to a size×size 8-bit coverage mask with
+/// `stride` bytes per row. The mask is cleared first. Returns false if
+/// the stream is truncated or has an unknown version or opcode.
+bool RasterizePathMask(const uint8_t* data, size_t len, int size,
+                       uint8_t* mask, int stride);
+
+/// Signed distance in pixels from each pixel center to the nearest stroke
+/// edge (negative inside), clamped to [-range, range], into a size×size
+/// float grid with `stride` floats per row. Input for the SDF builder.
+bool RasterizePathDistance(const uint8_t* data, size_t len, int size, float range,
+                           float* field, int stride);
+
+} // namespace lucide
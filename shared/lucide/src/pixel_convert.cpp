@@ -0,0 +1,473 @@
+#include "pixel_convert.h"
+#include "lucide.h"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define LUCIDE_PIXEL_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+namespace lucide {
+
+namespace {
+
+// ── Scalar reference ────────────────────────────────────────
+// Premultiply rounds c*a/255 to nearest; unpremultiply uses single
+// precision c*(255/a)+0.5 truncated, which the SIMD paths reproduce
+// exactly lane for lane. Kept as separate statements so no compiler
+// contracts them into an FMA.
+
+inline uint8_t MulDiv255(unsigned c, unsigned a) {
+    unsigned t = c * a + 128;
+    return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+}
+
+inline uint8_t Unpremul(unsigned c, float scale) {
+    float v = static_cast<float>(c) * scale;
+    v = v + 0.5f;
+    int r = static_cast<int>(v);
+    return static_cast<uint8_t>(r > 255 ? 255 : r);
+}
+
+void ScalarSwizzle(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    for (size_t i = 0; i < pixels * 4; i += 4) {
+        uint8_t c0 = src[i], c1 = src[i + 1], c2 = src[i + 2], a = src[i + 3];
+        dst[i]     = c2;
+        dst[i + 1] = c1;
+        dst[i + 2] = c0;
+        dst[i + 3] = a;
+    }
+}
+
+template <bool Swap>
+void ScalarPremultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    for (size_t i = 0; i < pixels * 4; i += 4) {
+        uint8_t c0 = src[i], c1 = src[i + 1], c2 = src[i + 2], a = src[i + 3];
+        if (Swap) { uint8_t t = c0; c0 = c2; c2 = t; }
+        dst[i]     = MulDiv255(c0, a);
+        dst[i + 1] = MulDiv255(c1, a);
+        dst[i + 2] = MulDiv255(c2, a);
+        dst[i + 3] = a;
+    }
+}
+
+template <bool Swap>
+void ScalarUnpremultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    for (size_t i = 0; i < pixels * 4; i += 4) {
+        uint8_t c0 = src[i], c1 = src[i + 1], c2 = src[i + 2], a = src[i + 3];
+        if (Swap) { uint8_t t = c0; c0 = c2; c2 = t; }
+        if (a == 0) {
+            dst[i] = dst[i + 1] = dst[i + 2] = dst[i + 3] = 0;
+            continue;
+        }
+        float scale = 255.0f / static_cast<float>(a);
+        dst[i]     = Unpremul(c0, scale);
+        dst[i + 1] = Unpremul(c1, scale);
+        dst[i + 2] = Unpremul(c2, scale);
+        dst[i + 3] = a;
+    }
+}
+
+void ScalarTint(const uint8_t* mask, uint8_t* dst, size_t pixels, uint32_t color) {
+    unsigned c0 = (color >> 16) & 0xFF, c1 = (color >> 8) & 0xFF, c2 = color & 0xFF;
+    for (size_t i = 0; i < pixels; i++, dst += 4) {
+        unsigned a = mask[i];
+        dst[0] = MulDiv255(c0, a);
+        dst[1] = MulDiv255(c1, a);
+        dst[2] = MulDiv255(c2, a);
+        dst[3] = static_cast<uint8_t>(a);
+    }
+}
+
+constexpr PixelKernels kScalar {
+    PixelIsa::Scalar, "scalar",
+    ScalarSwizzle,
+    ScalarPremultiply<false>,
+    ScalarUnpremultiply<false>,
+    ScalarPremultiply<true>,
+    ScalarUnpremultiply<true>,
+    ScalarTint,
+};
+
+#if defined(LUCIDE_PIXEL_X86)
+
+// ── SSSE3 (4 pixels per step) ───────────────────────────────
+
+#define LUCIDE_SSSE3 __attribute__((target("ssse3")))
+#define LUCIDE_AVX2  __attribute__((target("avx2")))
+
+LUCIDE_SSSE3 inline __m128i SwapMask128() {
+    return _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+}
+
+LUCIDE_SSSE3 void Ssse3Swizzle(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m128i swap = SwapMask128();
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_shuffle_epi8(v, swap));
+    }
+    ScalarSwizzle(src + i * 4, dst + i * 4, pixels - i);
+}
+
+// (t + (t >> 8)) >> 8 with t = c*a + 128, per 16-bit lane.
+LUCIDE_SSSE3 inline __m128i MulDiv255x8(__m128i c, __m128i a) {
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+template <bool Swap>
+LUCIDE_SSSE3 void Ssse3Premultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m128i swap    = SwapMask128();
+    const __m128i zero    = _mm_setzero_si128();
+    // Broadcast each pixel's alpha over its color lanes; the alpha lane
+    // itself is multiplied by 255 so it passes through unchanged.
+    const __m128i alphaLo = _mm_setr_epi8(3, -128, 3, -128, 3, -128, -128, -128,
+                                          7, -128, 7, -128, 7, -128, -128, -128);
+    const __m128i alphaHi = _mm_setr_epi8(11, -128, 11, -128, 11, -128, -128, -128,
+                                          15, -128, 15, -128, 15, -128, -128, -128);
+    const __m128i opaque  = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        if (Swap) v = _mm_shuffle_epi8(v, swap);
+
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i alo = _mm_or_si128(_mm_shuffle_epi8(v, alphaLo), opaque);
+        __m128i ahi = _mm_or_si128(_mm_shuffle_epi8(v, alphaHi), opaque);
+
+        __m128i out = _mm_packus_epi16(MulDiv255x8(lo, alo), MulDiv255x8(hi, ahi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+    }
+    ScalarPremultiply<Swap>(src + i * 4, dst + i * 4, pixels - i);
+}
+
+// One pixel per 128-bit float vector: c * (255 / a) + 0.5, zero where a == 0.
+LUCIDE_SSSE3 inline __m128i UnpremulPixel(__m128i px) {
+    __m128  c     = _mm_cvtepi32_ps(px);
+    __m128  a     = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128  none  = _mm_cmpeq_ps(a, _mm_setzero_ps());
+    __m128  scale = _mm_div_ps(_mm_set1_ps(255.0f), a);
+    __m128  v     = _mm_add_ps(_mm_mul_ps(c, scale), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(_mm_andnot_ps(none, v));
+}
+
+template <bool Swap>
+LUCIDE_SSSE3 void Ssse3Unpremultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m128i swap  = SwapMask128();
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        if (Swap) v = _mm_shuffle_epi8(v, swap);
+
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        __m128i p0 = UnpremulPixel(_mm_unpacklo_epi16(lo, zero));
+        __m128i p1 = UnpremulPixel(_mm_unpackhi_epi16(lo, zero));
+        __m128i p2 = UnpremulPixel(_mm_unpacklo_epi16(hi, zero));
+        __m128i p3 = UnpremulPixel(_mm_unpackhi_epi16(hi, zero));
+
+        // Saturating packs clamp to 255; then restore the original alpha.
+        __m128i out = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        out = _mm_or_si128(_mm_andnot_si128(alpha, out), _mm_and_si128(alpha, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), out);
+    }
+    ScalarUnpremultiply<Swap>(src + i * 4, dst + i * 4, pixels - i);
+}
+
+// Color lanes (c0, c1, c2, 255) twice; the 255 makes the alpha lane come
+// out as the coverage value itself.
+LUCIDE_SSSE3 inline __m128i TintColor128(uint32_t color) {
+    short c0 = static_cast<short>((color >> 16) & 0xFF);
+    short c1 = static_cast<short>((color >>  8) & 0xFF);
+    short c2 = static_cast<short>(color & 0xFF);
+    return _mm_setr_epi16(c0, c1, c2, 255, c0, c1, c2, 255);
+}
+
+LUCIDE_SSSE3 void Ssse3Tint(const uint8_t* mask, uint8_t* dst, size_t pixels, uint32_t color) {
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i rgba   = TintColor128(color);
+    const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+
+    size_t i = 0;
+    for (; i + 4 <= pixels; i += 4) {
+        int m;
+        memcpy(&m, mask + i, 4);
+        __m128i a  = _mm_shuffle_epi8(_mm_cvtsi32_si128(m), spread);
+        __m128i lo = MulDiv255x8(rgba, _mm_unpacklo_epi8(a, zero));
+        __m128i hi = MulDiv255x8(rgba, _mm_unpackhi_epi8(a, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    ScalarTint(mask + i, dst + i * 4, pixels - i, color);
+}
+
+// ── AVX2 (8 pixels per step) ────────────────────────────────
+// Same arithmetic as SSSE3; unpack/pack operate per 128-bit lane so the
+// pixel order round-trips unchanged.
+
+LUCIDE_AVX2 inline __m256i SwapMask256() {
+    return _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                            2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+}
+
+LUCIDE_AVX2 void Avx2Swizzle(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m256i swap = SwapMask256();
+    size_t i = 0;
+    for (; i + 8 <= pixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_shuffle_epi8(v, swap));
+    }
+    Ssse3Swizzle(src + i * 4, dst + i * 4, pixels - i);
+}
+
+LUCIDE_AVX2 inline __m256i MulDiv255x16(__m256i c, __m256i a) {
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+template <bool Swap>
+LUCIDE_AVX2 void Avx2Premultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m256i swap    = SwapMask256();
+    const __m256i zero    = _mm256_setzero_si256();
+    const __m256i alphaLo = _mm256_setr_epi8(3, -128, 3, -128, 3, -128, -128, -128,
+                                             7, -128, 7, -128, 7, -128, -128, -128,
+                                             3, -128, 3, -128, 3, -128, -128, -128,
+                                             7, -128, 7, -128, 7, -128, -128, -128);
+    const __m256i alphaHi = _mm256_setr_epi8(11, -128, 11, -128, 11, -128, -128, -128,
+                                             15, -128, 15, -128, 15, -128, -128, -128,
+                                             11, -128, 11, -128, 11, -128, -128, -128,
+                                             15, -128, 15, -128, 15, -128, -128, -128);
+    const __m256i opaque  = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255,
+                                              0, 0, 0, 255, 0, 0, 0, 255);
+
+    size_t i = 0;
+    for (; i + 8 <= pixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        if (Swap) v = _mm256_shuffle_epi8(v, swap);
+
+        __m256i lo  = _mm256_unpacklo_epi8(v, zero);
+        __m256i hi  = _mm256_unpackhi_epi8(v, zero);
+        __m256i alo = _mm256_or_si256(_mm256_shuffle_epi8(v, alphaLo), opaque);
+        __m256i ahi = _mm256_or_si256(_mm256_shuffle_epi8(v, alphaHi), opaque);
+
+        __m256i out = _mm256_packus_epi16(MulDiv255x16(lo, alo), MulDiv255x16(hi, ahi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), out);
+    }
+    Ssse3Premultiply<Swap>(src + i * 4, dst + i * 4, pixels - i);
+}
+
+LUCIDE_AVX2 inline __m256i UnpremulPixel2(__m256i px) {
+    __m256 c     = _mm256_cvtepi32_ps(px);
+    __m256 a     = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+    __m256 none  = _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 scale = _mm256_div_ps(_mm256_set1_ps(255.0f), a);
+    __m256 v     = _mm256_add_ps(_mm256_mul_ps(c, scale), _mm256_set1_ps(0.5f));
+    return _mm256_cvttps_epi32(_mm256_andnot_ps(none, v));
+}
+
+template <bool Swap>
+LUCIDE_AVX2 void Avx2Unpremultiply(const uint8_t* src, uint8_t* dst, size_t pixels) {
+    const __m256i swap  = SwapMask256();
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    size_t i = 0;
+    for (; i + 8 <= pixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        if (Swap) v = _mm256_shuffle_epi8(v, swap);
+
+        __m256i lo = _mm256_unpacklo_epi8(v, zero);
+        __m256i hi = _mm256_unpackhi_epi8(v, zero);
+        __m256i p0 = UnpremulPixel2(_mm256_unpacklo_epi16(lo, zero));
+        __m256i p1 = UnpremulPixel2(_mm256_unpackhi_epi16(lo, zero));
+        __m256i p2 = UnpremulPixel2(_mm256_unpacklo_epi16(hi, zero));
+        __m256i p3 = UnpremulPixel2(_mm256_unpackhi_epi16(hi, zero));
+
+        __m256i out = _mm256_packus_epi16(_mm256_packs_epi32(p0, p1), _mm256_packs_epi32(p2, p3));
+        out = _mm256_or_si256(_mm256_andnot_si256(alpha, out), _mm256_and_si256(alpha, v));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), out);
+    }
+    Ssse3Unpremultiply<Swap>(src + i * 4, dst + i * 4, pixels - i);
+}
+
+LUCIDE_AVX2 void Avx2Tint(const uint8_t* mask, uint8_t* dst, size_t pixels, uint32_t color) {
+    const __m256i zero     = _mm256_setzero_si256();
+    const __m128i rgba128  = TintColor128(color);
+    const __m256i rgba     = _mm256_set_m128i(rgba128, rgba128);
+    const __m128i spreadLo = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const __m128i spreadHi = _mm_setr_epi8(4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7);
+
+    size_t i = 0;
+    for (; i + 8 <= pixels; i += 8) {
+        __m128i m  = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i));
+        __m256i a  = _mm256_set_m128i(_mm_shuffle_epi8(m, spreadHi), _mm_shuffle_epi8(m, spreadLo));
+        __m256i lo = MulDiv255x16(rgba, _mm256_unpacklo_epi8(a, zero));
+        __m256i hi = MulDiv255x16(rgba, _mm256_unpackhi_epi8(a, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+    }
+    Ssse3Tint(mask + i, dst + i * 4, pixels - i, color);
+}
+
+constexpr PixelKernels kSsse3 {
+    PixelIsa::SSSE3, "ssse3",
+    Ssse3Swizzle,
+    Ssse3Premultiply<false>,
+    Ssse3Unpremultiply<false>,
+    Ssse3Premultiply<true>,
+    Ssse3Unpremultiply<true>,
+    Ssse3Tint,
+};
+
+constexpr PixelKernels kAvx2 {
+    PixelIsa::AVX2, "avx2",
+    Avx2Swizzle,
+    Avx2Premultiply<false>,
+    Avx2Unpremultiply<false>,
+    Avx2Premultiply<true>,
+    Avx2Unpremultiply<true>,
+    Avx2Tint,
+};
+
+// ── CPU features ────────────────────────────────────────────
+// Read with CPUID and XGETBV directly: __builtin_cpu_supports needs
+// compiler-rt's __cpu_model, which windows-msvc builds don't link.
+
+struct CpuFeatures {
+    bool ssse3;
+    bool avx2;
+};
+
+void Cpuid(int leaf, int subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, subleaf);
+    for (int i = 0; i < 4; i++) regs[i] = static_cast<unsigned>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Only called once CPUID reports OSXSAVE.
+__attribute__((target("xsave"))) unsigned long long EnabledXState() {
+    return _xgetbv(0);
+}
+
+CpuFeatures DetectCpu() {
+    CpuFeatures f{};
+    unsigned r[4];
+    Cpuid(0, 0, r);
+    unsigned maxLeaf = r[0];
+    if (maxLeaf < 1) return f;
+
+    Cpuid(1, 0, r);
+    f.ssse3 = (r[2] >> 9) & 1;
+    bool osxsave = (r[2] >> 27) & 1;
+    bool avx     = (r[2] >> 28) & 1;
+    // AVX state also needs the OS to save YMM registers (XCR0 bits 1, 2).
+    if (maxLeaf < 7 || !osxsave || !avx || (EnabledXState() & 6) != 6) return f;
+
+    Cpuid(7, 0, r);
+    f.avx2 = (r[1] >> 5) & 1;
+    return f;
+}
+
+const CpuFeatures& Cpu() {
+    static const CpuFeatures features = DetectCpu();
+    return features;
+}
+
+#endif // LUCIDE_PIXEL_X86
+
+} // namespace
+
+// ── Dispatch ────────────────────────────────────────────────
+
+const PixelKernels* KernelsFor(PixelIsa isa) {
+    switch (isa) {
+    case PixelIsa::Scalar:
+        return &kScalar;
+#if defined(LUCIDE_PIXEL_X86)
+    case PixelIsa::SSSE3:
+        return Cpu().ssse3 ? &kSsse3 : nullptr;
+    case PixelIsa::AVX2:
+        return Cpu().avx2 ? &kAvx2 : nullptr;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+const PixelKernels& Kernels() {
+    static const PixelKernels& best = []() -> const PixelKernels& {
+        const PixelIsa preferred[] = { PixelIsa::AVX2, PixelIsa::SSSE3 };
+        for (PixelIsa isa : preferred) {
+            if (auto* k = KernelsFor(isa)) return *k;
+        }
+        return kScalar;
+    }();
+    return best;
+}
+
+// LucidePixelFormat: bit 0 = BGRA order, bit 1 = straight alpha.
+bool ConvertPixels(const uint8_t* src, int srcFormat,
+                   uint8_t* dst, int dstFormat, size_t pixels)
+{
+    if (srcFormat < LUCIDE_FORMAT_RGBA_PREMUL || srcFormat > LUCIDE_FORMAT_BGRA_STRAIGHT ||
+        dstFormat < LUCIDE_FORMAT_RGBA_PREMUL || dstFormat > LUCIDE_FORMAT_BGRA_STRAIGHT)
+        return false;
+
+    bool swap       = ((srcFormat ^ dstFormat) & 1) != 0;
+    bool alphaDiff  = ((srcFormat ^ dstFormat) & 2) != 0;
+    bool toStraight = (dstFormat & 2) != 0;
+    auto& k = Kernels();
+
+    if (!alphaDiff) {
+        if (swap)            k.swizzle(src, dst, pixels);
+        else if (src != dst) memmove(dst, src, pixels * 4);
+    } else if (toStraight) {
+        (swap ? k.swizzleUnpremultiply : k.unpremultiply)(src, dst, pixels);
+    } else {
+        (swap ? k.swizzlePremultiply : k.premultiply)(src, dst, pixels);
+    }
+    return true;
+}
+
+bool TintPixels(const uint8_t* mask, uint8_t* dst, int dstFormat,
+                size_t pixels, uint32_t color)
+{
+    if (dstFormat < LUCIDE_FORMAT_RGBA_PREMUL || dstFormat > LUCIDE_FORMAT_BGRA_STRAIGHT)
+        return false;
+
+    if (dstFormat & 1)
+        color = ((color & 0xFF) << 16) | (color & 0xFF00) | ((color >> 16) & 0xFF);
+
+    if (!(dstFormat & 2)) {
+        Kernels().tint(mask, dst, pixels, color);
+        return true;
+    }
+
+    // Straight alpha: the color is constant. Fully transparent pixels are
+    // zeroed to match unpremultiply.
+    uint8_t c0 = (color >> 16) & 0xFF, c1 = (color >> 8) & 0xFF, c2 = color & 0xFF;
+    for (size_t i = 0; i < pixels; i++, dst += 4) {
+        uint8_t a = mask[i];
+        dst[0] = a ? c0 : 0;
+        dst[1] = a ? c1 : 0;
+        dst[2] = a ? c2 : 0;
+        dst[3] = a;
+    }
+    return true;
+}
+
+} // namespace lucide
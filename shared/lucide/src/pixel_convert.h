@@ -0,0 +1,55 @@
+#pragma once
+// ── Pixel Format Kernels ────────────────────────────────────
+// R/B swizzle, premultiply, unpremultiply and coverage-mask tinting for
+// 32-bit pixels, with scalar, SSSE3 and AVX2 implementations picked at
+// runtime. Every implementation produces bit-identical output to the
+// scalar one.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lucide {
+
+enum class PixelIsa {
+    Scalar,
+    SSSE3,
+    AVX2,
+};
+
+// All kernels take `pixels` 4-byte pixels; src and dst may be the same
+// buffer but must not otherwise overlap. Channel order is preserved
+// unless the kernel swaps R and B.
+using PixelKernel = void(*)(const uint8_t* src, uint8_t* dst, size_t pixels);
+
+// Expands `pixels` 8-bit coverage values to premultiplied 32-bit pixels
+// of 0xC0C1C2 (written in that byte order, alpha last).
+using TintKernel = void(*)(const uint8_t* mask, uint8_t* dst, size_t pixels, uint32_t color);
+
+struct PixelKernels {
+    PixelIsa    isa;
+    const char* name;
+    PixelKernel swizzle;                // swap R and B
+    PixelKernel premultiply;            // straight → premultiplied
+    PixelKernel unpremultiply;          // premultiplied → straight
+    PixelKernel swizzlePremultiply;     // swap R/B, straight → premultiplied
+    PixelKernel swizzleUnpremultiply;   // swap R/B, premultiplied → straight
+    TintKernel  tint;                   // coverage mask → premultiplied color
+};
+
+/// Best kernel set for this CPU, selected once.
+const PixelKernels& Kernels();
+
+/// Kernel set for a specific ISA, or nullptr if the CPU doesn't support it.
+const PixelKernels* KernelsFor(PixelIsa isa);
+
+/// Convert between LucidePixelFormat values. Returns false for an
+/// unknown format.
+bool ConvertPixels(const uint8_t* src, int srcFormat,
+                   uint8_t* dst, int dstFormat, size_t pixels);
+
+/// Tint `pixels` coverage values with a 0xRRGGBB color into a
+/// LucidePixelFormat. Returns false for an unknown format.
+bool TintPixels(const uint8_t* mask, uint8_t* dst, int dstFormat,
+                size_t pixels, uint32_t color);
+
+} // namespace lucide
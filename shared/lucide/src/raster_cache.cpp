@@ -0,0 +1,200 @@
+#include "raster_cache.h"
+#include "disk_cache.h"
+#include "icon_render.h"
+#include "icons_data.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace lucide {
+
+namespace {
+
+// The public LucideRaster is the first member so a handed-out pointer can
+// be converted back to its entry. `refs` counts borrowers plus one for
+// membership in the cache; whoever drops it to zero frees the entry.
+// `pixels` is empty when the raster points into the disk cache mapping.
+struct RasterEntry {
+    LucideRaster                    raster{};
+    uint64_t                        key   = 0;
+    size_t                          bytes = 0;
+    std::atomic<int>                refs{1};
+    std::list<RasterEntry*>::iterator lru;
+    std::unique_ptr<uint8_t[]>      pixels;
+};
+
+struct RasterCache {
+    std::mutex                                  lock;
+    std::unordered_map<uint64_t, RasterEntry*>  entries;
+    std::list<RasterEntry*>                     lru;    // front = most recent
+    size_t                                      budget    = kDefaultCacheBudget;
+    size_t                                      bytes     = 0;
+    uint64_t                                    hits      = 0;
+    uint64_t                                    misses    = 0;
+    uint64_t                                    evictions = 0;
+};
+
+RasterCache& Cache() {
+    static RasterCache cache;
+    return cache;
+}
+
+// Coverage masks share the table with colored rasters; the top bit keeps
+// their keys apart.
+constexpr uint64_t kMaskKey = 1ull << 63;
+
+uint64_t MakeKey(int index, int size, uint32_t color) {
+    return (static_cast<uint64_t>(index) << 40)
+         | (static_cast<uint64_t>(size & 0xFFFF) << 24)
+         | (color & 0xFFFFFF);
+}
+
+void Unref(RasterEntry* entry) {
+    if (entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete entry;
+}
+
+// Caller holds cache.lock.
+void EvictTo(RasterCache& cache, size_t budget) {
+    while (cache.bytes > budget && !cache.lru.empty()) {
+        RasterEntry* victim = cache.lru.back();
+        cache.lru.pop_back();
+        cache.entries.erase(victim->key);
+        cache.bytes -= victim->bytes;
+        cache.evictions++;
+        Unref(victim);
+    }
+}
+
+// Caller holds cache.lock. A hit is moved to the front, referenced and
+// counted.
+const LucideRaster* Lookup(RasterCache& cache, uint64_t key) {
+    auto it = cache.entries.find(key);
+    if (it == cache.entries.end()) return nullptr;
+    RasterEntry* entry = it->second;
+    cache.lru.splice(cache.lru.begin(), cache.lru, entry->lru);
+    entry->refs.fetch_add(1, std::memory_order_relaxed);
+    cache.hits++;
+    return &entry->raster;
+}
+
+// Shared hit/miss/insert path. A `persistent` miss is served from the
+// disk cache when it has the raster; otherwise `render(pixels)` fills
+// size*size pixels of `bpp` bytes each and a persistent result is queued
+// for the disk cache.
+template <typename Render>
+const LucideRaster* Acquire(uint64_t key, int size, int bpp, bool persistent, Render&& render) {
+    auto& cache = Cache();
+
+    {
+        std::lock_guard<std::mutex> guard(cache.lock);
+        if (const LucideRaster* hit = Lookup(cache, key)) return hit;
+        cache.misses++;
+    }
+
+    // Render outside the lock so hits on other keys are not blocked.
+    auto entry = std::make_unique<RasterEntry>();
+    entry->bytes = static_cast<size_t>(size) * size * bpp;
+    const uint8_t* stored = persistent ? FindDiskRaster(key, size, bpp) : nullptr;
+    if (stored) {
+        entry->raster.pixels = stored;
+    } else {
+        entry->pixels = std::make_unique<uint8_t[]>(entry->bytes);
+        if (!render(entry->pixels.get())) return nullptr;
+        if (persistent) StoreDiskRaster(key, size, bpp, entry->pixels.get());
+        entry->raster.pixels = entry->pixels.get();
+    }
+
+    entry->key           = key;
+    entry->raster.size   = size;
+    entry->raster.stride = size * bpp;
+
+    std::lock_guard<std::mutex> guard(cache.lock);
+
+    // Another thread may have rendered the same key meanwhile.
+    auto it = cache.entries.find(key);
+    if (it != cache.entries.end()) {
+        RasterEntry* existing = it->second;
+        cache.lru.splice(cache.lru.begin(), cache.lru, existing->lru);
+        existing->refs.fetch_add(1, std::memory_order_relaxed);
+        return &existing->raster;
+    }
+
+    // Larger than the whole budget: hand it out uncached. The single
+    // reference belongs to the caller.
+    if (entry->bytes > cache.budget) return &entry.release()->raster;
+
+    RasterEntry* raw = entry.release();
+    raw->refs.store(2, std::memory_order_relaxed);   // cache + caller
+    cache.lru.push_front(raw);
+    raw->lru = cache.lru.begin();
+    cache.entries.emplace(key, raw);
+    cache.bytes += raw->bytes;
+    EvictTo(cache, cache.budget);
+    return &raw->raster;
+}
+
+// Pack icon indices depend on which packs a process loads, and in what
+// order, so only embedded icons have stable keys across launches.
+bool Persistent(int index) {
+    return index < kIconCount;
+}
+
+} // namespace
+
+const LucideRaster* AcquireRaster(int index, int size, uint32_t color) {
+    if (size <= 0 || size > 0xFFFF) return nullptr;
+    return Acquire(MakeKey(index, size, color), size, 4, Persistent(index), [&](uint8_t* pixels) {
+        return RenderIconRGBA(index, size, color, pixels);
+    });
+}
+
+const LucideRaster* AcquireMask(int index, int size) {
+    if (size <= 0 || size > 0xFFFF) return nullptr;
+    return Acquire(MakeKey(index, size, 0) | kMaskKey, size, 1, Persistent(index), [&](uint8_t* pixels) {
+        return RenderIconMask(index, size, pixels, size);
+    });
+}
+
+const LucideRaster* PeekMask(int index, int size) {
+    if (size <= 0 || size > 0xFFFF) return nullptr;
+    auto& cache = Cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+    return Lookup(cache, MakeKey(index, size, 0) | kMaskKey);
+}
+
+void ReleaseRaster(const LucideRaster* raster) {
+    if (!raster) return;
+    // LucideRaster is the first member of RasterEntry.
+    auto* entry = reinterpret_cast<RasterEntry*>(const_cast<LucideRaster*>(raster));
+    Unref(entry);
+}
+
+void SetRasterBudget(size_t bytes) {
+    auto& cache = Cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+    cache.budget = bytes;
+    EvictTo(cache, cache.budget);
+}
+
+void PurgeRasters() {
+    auto& cache = Cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+    EvictTo(cache, 0);
+}
+
+void GetRasterStats(LucideCacheStats& stats) {
+    auto& cache = Cache();
+    std::lock_guard<std::mutex> guard(cache.lock);
+    stats.hits        = cache.hits;
+    stats.misses      = cache.misses;
+    stats.evictions   = cache.evictions;
+    stats.entries     = cache.entries.size();
+    stats.bytesInUse  = cache.bytes;
+    stats.budgetBytes = cache.budget;
+}
+
+} // namespace lucide
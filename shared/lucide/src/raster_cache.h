@@ -0,0 +1,41 @@
+#pragma once
+// ── Raster Cache ────────────────────────────────────────────
+// Bounded LRU cache of rendered icons keyed by (icon index, size, color),
+// plus color-independent coverage masks keyed by (icon index, size).
+// Entries are handed out as ref-counted, read-only LucideRaster pointers;
+// a hit costs one hash lookup and a refcount increment.
+
+#include "lucide.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace lucide {
+
+constexpr size_t kDefaultCacheBudget = 16u * 1024u * 1024u;
+
+/// Borrow the raster for (index, size, color), rendering it on a miss.
+/// Returns nullptr if the icon cannot be rendered. Every non-null result
+/// must be returned with ReleaseRaster().
+const LucideRaster* AcquireRaster(int index, int size, uint32_t color);
+
+/// Borrow the 8-bit coverage mask for (index, size); stride == size.
+/// Release with ReleaseRaster().
+const LucideRaster* AcquireMask(int index, int size);
+
+/// AcquireMask() for a mask already in memory; never renders. Returns
+/// nullptr on a miss. Release with ReleaseRaster().
+const LucideRaster* PeekMask(int index, int size);
+
+/// Drop a reference obtained from AcquireRaster(), AcquireMask() or PeekMask().
+void ReleaseRaster(const LucideRaster* raster);
+
+/// Set the pixel-byte budget, evicting least-recently-used entries as needed.
+void SetRasterBudget(size_t bytes);
+
+/// Drop every cached entry (borrowed rasters stay valid until released).
+void PurgeRasters();
+
+/// Snapshot the cache counters.
+void GetRasterStats(LucideCacheStats& stats);
+
+} // namespace lucide
@@ -0,0 +1,91 @@
+#include "sdf.h"
+#include "icon_source.h"
+#include "path_raster.h"
+#include "slot_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lucide {
+
+namespace {
+
+struct SdfSlot {
+    std::once_flag             built;
+    std::unique_ptr<uint8_t[]> field;
+};
+
+SlotTable<SdfSlot> s_slots;
+
+constexpr float kStep = 127.0f / kSdfRange;   // encoded units per field pixel
+
+} // namespace
+
+bool BuildSdf(const uint8_t* path, size_t len, uint8_t* field) {
+    std::vector<float> distance(static_cast<size_t>(kSdfSize) * kSdfSize);
+    if (!RasterizePathDistance(path, len, kSdfSize, kSdfRange, distance.data(), kSdfSize))
+        return false;
+
+    for (size_t i = 0; i < distance.size(); i++) {
+        float v = std::round(128.0f - distance[i] * kStep);
+        field[i] = static_cast<uint8_t>(std::clamp(v, 0.0f, 255.0f));
+    }
+    return true;
+}
+
+const uint8_t* IconSdf(int index) {
+    IconData icon;
+    if (!GetIcon(index, icon) || icon.pathSize == 0) return nullptr;
+
+    auto& slot = s_slots[index];
+    std::call_once(slot.built, [&slot, &icon]() {
+        auto field = std::make_unique<uint8_t[]>(static_cast<size_t>(kSdfSize) * kSdfSize);
+        if (BuildSdf(icon.path, icon.pathSize, field.get()))
+            slot.field = std::move(field);
+    });
+    return slot.field.get();
+}
+
+void RenderSdfMask(const uint8_t* field, int size, uint8_t* mask, int stride) {
+    // Field pixels per output pixel. Coverage is 0.5 - distance in output
+    // pixels, which is linear in the encoded value: cov = v * a + b.
+    float scale = static_cast<float>(kSdfSize) / size;
+    float a = 1.0f / (kStep * scale);
+    float b = 0.5f - 128.0f * a;
+
+    // Column taps are the same for every row.
+    thread_local std::vector<int>   col;
+    thread_local std::vector<float> colWeight;
+    col.resize(size);
+    colWeight.resize(size);
+    for (int x = 0; x < size; x++) {
+        float fx = std::clamp((x + 0.5f) * scale - 0.5f, 0.0f, kSdfSize - 1.0f);
+        int x0 = std::min(static_cast<int>(fx), kSdfSize - 2);
+        col[x] = x0;
+        colWeight[x] = fx - x0;
+    }
+
+    for (int y = 0; y < size; y++) {
+        float fy = std::clamp((y + 0.5f) * scale - 0.5f, 0.0f, kSdfSize - 1.0f);
+        int y0 = std::min(static_cast<int>(fy), kSdfSize - 2);
+        float wy = fy - y0;
+        const uint8_t* r0 = field + static_cast<size_t>(y0) * kSdfSize;
+        const uint8_t* r1 = r0 + kSdfSize;
+        uint8_t* out = mask + static_cast<size_t>(y) * stride;
+
+        for (int x = 0; x < size; x++) {
+            int x0 = col[x];
+            float wx = colWeight[x];
+            float top = r0[x0] + (r0[x0 + 1] - r0[x0]) * wx;
+            float bot = r1[x0] + (r1[x0 + 1] - r1[x0]) * wx;
+            float v   = top + (bot - top) * wy;
+            float cov = std::clamp(v * a + b, 0.0f, 1.0f);
+            out[x] = static_cast<uint8_t>(cov * 255.0f + 0.5f);
+        }
+    }
+}
+
+} // namespace lucide
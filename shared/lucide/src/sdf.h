@@ -0,0 +1,28 @@
+#pragma once
+// ── Signed Distance Fields ──────────────────────────────────
+// Optional render mode: each compiled icon is turned once into a small
+// 8-bit distance field, and every target size is reconstructed from it
+// with one bilinear sample per pixel. DPI and size changes then cost a
+// resample instead of a vector rasterization.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lucide {
+
+constexpr int   kSdfSize  = 64;     // field width and height
+constexpr float kSdfRange = 6.0f;   // encoded distance range, in field pixels
+
+/// Build a kSdfSize×kSdfSize field from a compiled path. 128 encodes the
+/// stroke edge; each step of 127/kSdfRange is one field pixel, larger
+/// values inside.
+bool BuildSdf(const uint8_t* path, size_t len, uint8_t* field);
+
+/// The field for icon `index`, built on first use and kept for the life of
+/// the process. nullptr if the icon has no compiled path.
+const uint8_t* IconSdf(int index);
+
+/// Reconstruct a size×size coverage mask from a field.
+void RenderSdfMask(const uint8_t* field, int size, uint8_t* mask, int stride);
+
+} // namespace lucide
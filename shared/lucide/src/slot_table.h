@@ -0,0 +1,40 @@
+#pragma once
+// ── Per-Icon Slot Table ─────────────────────────────────────
+// One T per icon index, for per-icon state that used to be a fixed
+// kIconCount array. Icon packs add indices at runtime, so slots live in
+// chunks allocated on first touch and published with a compare-exchange:
+// lookups never lock and a slot never moves once created.
+
+#include "icon_source.h"
+
+#include <atomic>
+
+namespace lucide {
+
+template <typename T>
+class SlotTable {
+public:
+    static constexpr int kChunkBits = 8;
+    static constexpr int kChunkSize = 1 << kChunkBits;
+    static constexpr int kChunks    = kMaxIcons / kChunkSize;
+
+    /// Slot for `index`, 0 <= index < kMaxIcons.
+    T& operator[](int index) {
+        auto& chunk = m_chunks[index >> kChunkBits];
+        T* slots = chunk.load(std::memory_order_acquire);
+        if (!slots) {
+            T* fresh = new T[kChunkSize];
+            if (chunk.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel))
+                slots = fresh;
+            else
+                delete[] fresh;     // another thread won; `slots` holds its chunk
+        }
+        return slots[index & (kChunkSize - 1)];
+    }
+
+private:
+    // Never freed: slots may be in use by detached workers at exit.
+    std::atomic<T*> m_chunks[kChunks] = {};
+};
+
+} // namespace lucide
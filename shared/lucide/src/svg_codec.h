@@ -0,0 +1,79 @@
+#pragma once
+// ── Embedded SVG Codec ──────────────────────────────────────
+// Byte-oriented LZ77 for the embedded SVG text. lucide_gen compresses
+// each icon on its own against a shared dictionary (kIconSvgDict), so any
+// one icon decodes without touching the others. The decoder lives here so
+// the generator can check that every stream round-trips.
+//
+// A stream is a run of sequences:
+//
+//   token     literal count << 4 | (match length - kSvgMinMatch)
+//   [ext]     literal count extension if its nibble is 15
+//   literals  copied to the output
+//   [ext]     match length extension if its nibble is 15
+//   offset    u16 LE distance back from the output position; distances
+//             past the start of the output reach into the dictionary
+//
+// Extensions are bytes added to 15; a 255 byte adds 255 and continues,
+// any other byte adds itself and stops.
+//
+// The last sequence carries literals only and ends at the end of input.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lucide {
+
+inline constexpr size_t kSvgMinMatch    = 4;
+inline constexpr size_t kSvgMaxDistance = 0xFFFF;
+
+/// Decode `src` into exactly `outLen` bytes at `out`. Returns false if the
+/// stream is malformed or doesn't produce exactly `outLen` bytes.
+inline bool DecodeSvg(const uint8_t* dict, size_t dictLen,
+                      const uint8_t* src, size_t srcLen,
+                      char* out, size_t outLen)
+{
+    const uint8_t* end = src + srcLen;
+    size_t pos = 0;
+
+    auto readLength = [&](size_t base, size_t& len) {
+        len = base;
+        if (base != 15) return true;
+        for (;;) {
+            if (src >= end) return false;
+            uint8_t b = *src++;
+            len += b;
+            if (b != 255) return true;
+        }
+    };
+
+    while (src < end) {
+        uint8_t token = *src++;
+
+        size_t literals;
+        if (!readLength(token >> 4, literals)) return false;
+        if (literals > static_cast<size_t>(end - src) || literals > outLen - pos) return false;
+        for (size_t i = 0; i < literals; i++) out[pos++] = static_cast<char>(*src++);
+
+        if (src == end) break;
+
+        size_t match;
+        if (!readLength(token & 15, match)) return false;
+        match += kSvgMinMatch;
+        if (end - src < 2) return false;
+        size_t distance = src[0] | (static_cast<size_t>(src[1]) << 8);
+        src += 2;
+        if (distance == 0 || distance > pos + dictLen || match > outLen - pos) return false;
+
+        // Byte by byte: matches may overlap their own output and may start
+        // in the dictionary and run on into the output.
+        for (size_t i = 0; i < match; i++, pos++) {
+            out[pos] = distance > pos
+                ? static_cast<char>(dict[dictLen - (distance - pos)])
+                : out[pos - distance];
+        }
+    }
+    return pos == outLen;
+}
+
+} // namespace lucide
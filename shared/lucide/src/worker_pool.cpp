@@ -0,0 +1,111 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lucide {
+
+namespace {
+
+class WorkerPool {
+public:
+    explicit WorkerPool(int workers) {
+        for (int i = 0; i < workers; i++)
+            m_threads.emplace_back([this, i]() { WorkerLoop(i); });
+        // Never joined: joining from a static destructor would run under
+        // the loader lock during DLL unload. The OS reclaims them at exit.
+        for (auto& t : m_threads) t.detach();
+    }
+
+    int Workers() const { return static_cast<int>(m_threads.size()); }
+
+    void Run(int count, int helpers, const std::function<void(int)>& fn) {
+        std::lock_guard<std::mutex> serial(m_runLock);
+        {
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_job     = &fn;
+            m_count   = count;
+            m_helpers = helpers;
+            m_active  = helpers;
+            m_next.store(0, std::memory_order_relaxed);
+            m_generation++;
+        }
+        m_wake.notify_all();
+
+        Drain();
+
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_done.wait(guard, [this]() { return m_active == 0; });
+        m_job = nullptr;
+    }
+
+private:
+    std::vector<std::thread>          m_threads;
+    std::mutex                        m_runLock;
+    std::mutex                        m_lock;
+    std::condition_variable           m_wake;
+    std::condition_variable           m_done;
+    const std::function<void(int)>*   m_job        = nullptr;
+    std::atomic<int>                  m_next{0};
+    int                               m_count      = 0;
+    int                               m_helpers    = 0;
+    int                               m_active     = 0;
+    uint64_t                          m_generation = 0;
+
+    void Drain() {
+        for (;;) {
+            int i = m_next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= m_count) break;
+            (*m_job)(i);
+        }
+    }
+
+    void WorkerLoop(int id) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(m_lock);
+                m_wake.wait(guard, [&]() { return m_generation != seen; });
+                seen = m_generation;
+                if (id >= m_helpers) continue;
+            }
+
+            Drain();
+
+            std::lock_guard<std::mutex> guard(m_lock);
+            if (--m_active == 0) m_done.notify_one();
+        }
+    }
+};
+
+WorkerPool& Pool() {
+    static WorkerPool* pool = new WorkerPool(HardwareThreads() - 1);
+    return *pool;
+}
+
+} // namespace
+
+int HardwareThreads() {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ParallelFor(int count, int threads, const std::function<void(int)>& fn) {
+    if (count <= 0) return;
+    if (threads <= 0) threads = HardwareThreads();
+    threads = std::min(threads, count);
+
+    if (threads == 1) {
+        for (int i = 0; i < count; i++) fn(i);
+        return;
+    }
+
+    auto& pool = Pool();
+    pool.Run(count, std::min(threads - 1, pool.Workers()), fn);
+}
+
+} // namespace lucide
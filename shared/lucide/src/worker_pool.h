@@ -0,0 +1,18 @@
+#pragma once
+// ── Worker Pool ─────────────────────────────────────────────
+// Small persistent thread pool for data-parallel rendering. Threads are
+// created on first use and live until the process exits.
+
+#include <functional>
+
+namespace lucide {
+
+/// Number of hardware threads (at least 1).
+int HardwareThreads();
+
+/// Call fn(i) for every i in [0, count) using up to `threads` threads,
+/// including the calling thread. Returns once all calls have finished.
+/// threads <= 0 uses HardwareThreads(). Concurrent calls are serialized.
+void ParallelFor(int count, int threads, const std::function<void(int)>& fn);
+
+} // namespace lucide
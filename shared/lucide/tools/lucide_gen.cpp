@@ -0,0 +1,283 @@
+// ── lucide_gen — Embedded Icon Generator ────────────────────
+// Build-time tool: reads every *.svg in an icon directory and writes
+// icons_data.h with the minified SVG text compressed against a shared
+// dictionary (src/svg_codec.h), a perfect-hash name table and the
+// compiled path stream (src/path_format.h) for every icon that fits the
+// fast rasterizer. With --pack it writes the same icons as an icon pack
+// (src/pack_format.h) that Lucide.dll loads at runtime instead.
+//
+//   lucide_gen <icon-dir> <output-header>
+//   lucide_gen --pack <icon-dir> <output-pack>
+//
+// Outputs are only rewritten when their content changes, so unrelated
+// reconfigures don't trigger a rebuild of Lucide.
+
+#include "../src/icon_hash.h"
+#include "../src/svg_codec.h"
+#include "pack_writer.h"
+#include "path_compiler.h"
+#include "svg_pack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Icon {
+    std::string          name;
+    std::string          svg;     // minified
+    std::vector<uint8_t> packed;  // svg compressed against the dictionary
+    std::vector<uint8_t> path;    // empty: render through lunasvg
+};
+
+bool ReadFile(const fs::path& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+// ── Perfect hash (hash-and-displace) ────────────────────────
+// Keys are grouped into buckets by IconHash(name, 0). Buckets are placed
+// largest first; each gets the smallest seed that sends all its keys to
+// free slots via IconHash(name, seed) % count.
+struct PerfectHash {
+    uint32_t              buckets = 0;
+    std::vector<uint32_t> seeds;
+    std::vector<int>      slots;
+};
+
+bool BuildPerfectHash(const std::vector<Icon>& icons, PerfectHash& ph) {
+    const uint32_t n = static_cast<uint32_t>(icons.size());
+    ph.buckets = std::max<uint32_t>(1, (n + 1) / 2);
+    ph.seeds.assign(ph.buckets, 0);
+    ph.slots.assign(n, -1);
+
+    std::vector<std::vector<int>> members(ph.buckets);
+    for (uint32_t i = 0; i < n; i++)
+        members[lucide::IconHash(icons[i].name, 0) % ph.buckets].push_back(static_cast<int>(i));
+
+    std::vector<uint32_t> order(ph.buckets);
+    for (uint32_t b = 0; b < ph.buckets; b++) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return members[a].size() > members[b].size();
+    });
+
+    std::vector<uint32_t> taken;
+    for (uint32_t b : order) {
+        if (members[b].empty()) continue;
+
+        bool placed = false;
+        for (uint32_t seed = 1; seed < 0x1000000 && !placed; seed++) {
+            taken.clear();
+            bool ok = true;
+            for (int idx : members[b]) {
+                uint32_t slot = lucide::IconHash(icons[idx].name, seed) % n;
+                if (ph.slots[slot] != -1 ||
+                    std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                    ok = false;
+                    break;
+                }
+                taken.push_back(slot);
+            }
+            if (!ok) continue;
+
+            for (size_t k = 0; k < taken.size(); k++)
+                ph.slots[taken[k]] = members[b][k];
+            ph.seeds[b] = seed;
+            placed = true;
+        }
+        if (!placed) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void WriteArray(std::ostringstream& out, const std::vector<T>& values) {
+    for (size_t i = 0; i < values.size(); i++) {
+        out << (i % 12 == 0 ? "    " : " ") << values[i] << ",";
+        if (i % 12 == 11 || i + 1 == values.size()) out << "\n";
+    }
+}
+
+std::string Generate(const std::vector<Icon>& icons, const std::string& dict,
+                     const PerfectHash& ph)
+{
+    std::ostringstream out;
+    out << "#pragma once\n"
+           "// Auto-generated by lucide_gen — do not edit\n"
+           "#include <cstdint>\n\n"
+           "struct IconEntry {\n"
+           "    const char* name;\n"
+           "    uint32_t    svgOffset;    // into kIconSvgData\n"
+           "    uint32_t    svgSize;      // compressed bytes\n"
+           "    uint32_t    svgLength;    // decoded bytes\n"
+           "    uint32_t    pathOffset;   // into kIconPathData\n"
+           "    uint32_t    pathSize;     // 0: no compiled path, use lunasvg\n"
+           "};\n\n"
+           "inline constexpr int kIconCount = " << icons.size() << ";\n\n"
+           "inline constexpr IconEntry kIcons[] = {\n";
+    std::vector<unsigned> svgBlob, blob;
+    for (auto& icon : icons) {
+        out << "    { \"" << icon.name << "\", "
+            << svgBlob.size() << ", " << icon.packed.size() << ", " << icon.svg.size() << ", "
+            << (icon.path.empty() ? 0 : blob.size()) << ", " << icon.path.size() << " },\n";
+        svgBlob.insert(svgBlob.end(), icon.packed.begin(), icon.packed.end());
+        blob.insert(blob.end(), icon.path.begin(), icon.path.end());
+    }
+    out << "};\n\n";
+
+    // Never empty, so the arrays are always well-formed.
+    std::vector<unsigned> dictBytes(dict.begin(), dict.end());
+    for (auto& b : dictBytes) b &= 0xFF;
+    if (dictBytes.empty()) dictBytes.push_back(0);
+    if (svgBlob.empty()) svgBlob.push_back(0);
+    out << "// SVG text: see src/svg_codec.h and lucide::DecodeIconSvg\n"
+           "inline constexpr uint8_t kIconSvgDict[] = {\n";
+    WriteArray(out, dictBytes);
+    out << "};\n\n"
+           "inline constexpr uint8_t kIconSvgData[] = {\n";
+    WriteArray(out, svgBlob);
+    out << "};\n\n";
+
+    if (blob.empty()) blob.push_back(0);
+    out << "// Compiled paths: see src/path_format.h\n"
+           "inline constexpr uint8_t kIconPathData[] = {\n";
+    WriteArray(out, blob);
+    out << "};\n\n";
+
+    out << "// Perfect hash: see lucide::FindEmbeddedIcon in icon_registry.h\n"
+           "inline constexpr uint32_t kIconHashBuckets = " << ph.buckets << ";\n\n"
+           "inline constexpr uint32_t kIconHashSeeds[] = {\n";
+    WriteArray(out, ph.seeds);
+    out << "};\n\n"
+           "inline constexpr int kIconHashSlots[] = {\n";
+    WriteArray(out, ph.slots);
+    out << "};\n";
+    return out.str();
+}
+
+// Read, minify, compile and compress every icon in `iconDir`, sorted by
+// name. Prints the reason for any failure.
+bool LoadIcons(const fs::path& iconDir, std::vector<Icon>& icons, std::string& dict) {
+    size_t sourceBytes = 0;
+    std::error_code ec;
+    for (auto& entry : fs::directory_iterator(iconDir, ec)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".svg") continue;
+        Icon icon;
+        icon.name = entry.path().stem().string();
+        std::string source;
+        if (!ReadFile(entry.path(), source)) {
+            fprintf(stderr, "lucide_gen: cannot read %s\n", entry.path().string().c_str());
+            return false;
+        }
+        if (!lucide_gen::MinifySvg(source, icon.svg)) {
+            printf("lucide_gen: %s cannot be minified, embedding as is\n", icon.name.c_str());
+            icon.svg = source;
+        }
+        sourceBytes += source.size();
+
+        std::string reason;
+        if (!lucide_gen::CompilePath(icon.svg, icon.path, reason)) {
+            icon.path.clear();
+            printf("lucide_gen: %s falls back to lunasvg: %s\n", icon.name.c_str(), reason.c_str());
+        } else {
+            // Minification must not change what the icon draws.
+            std::vector<uint8_t> original;
+            if (!lucide_gen::CompilePath(source, original, reason) || original != icon.path) {
+                fprintf(stderr, "lucide_gen: minifying %s changed its geometry\n", icon.name.c_str());
+                return false;
+            }
+        }
+        icons.push_back(std::move(icon));
+    }
+    if (ec || icons.empty()) {
+        fprintf(stderr, "lucide_gen: no icons found in %s\n", iconDir.string().c_str());
+        return false;
+    }
+    std::sort(icons.begin(), icons.end(), [](const Icon& a, const Icon& b) {
+        return a.name < b.name;
+    });
+
+    std::vector<std::string> texts;
+    for (auto& icon : icons) texts.push_back(icon.svg);
+    dict = lucide_gen::BuildSvgDictionary(texts);
+
+    size_t minifiedBytes = 0, packedBytes = 0;
+    for (auto& icon : icons) {
+        icon.packed = lucide_gen::CompressSvg(dict, icon.svg);
+
+        std::string check(icon.svg.size(), '\0');
+        if (!lucide::DecodeSvg(reinterpret_cast<const uint8_t*>(dict.data()), dict.size(),
+                               icon.packed.data(), icon.packed.size(),
+                               check.data(), check.size()) || check != icon.svg) {
+            fprintf(stderr, "lucide_gen: %s does not round-trip\n", icon.name.c_str());
+            return false;
+        }
+        minifiedBytes += icon.svg.size();
+        packedBytes   += icon.packed.size();
+    }
+    printf("lucide_gen: %zu icons, SVG %zu bytes, minified %zu, compressed %zu + %zu dictionary\n",
+        icons.size(), sourceBytes, minifiedBytes, packedBytes, dict.size());
+    return true;
+}
+
+bool WriteIfChanged(const fs::path& output, const std::string& content) {
+    std::string existing;
+    if (ReadFile(output, existing) && existing == content) return true;
+
+    std::error_code ec;
+    fs::create_directories(output.parent_path(), ec);
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out || !(out << content)) {
+        fprintf(stderr, "lucide_gen: cannot write %s\n", output.string().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool pack = argc == 4 && std::string(argv[1]) == "--pack";
+    if (argc != 3 && !pack) {
+        fprintf(stderr, "usage: lucide_gen [--pack] <icon-dir> <output>\n");
+        return 2;
+    }
+    fs::path iconDir = argv[argc - 2];
+    fs::path output  = argv[argc - 1];
+
+    std::vector<Icon> icons;
+    std::string dict;
+    if (!LoadIcons(iconDir, icons, dict)) return 1;
+
+    if (pack) {
+        std::vector<lucide_gen::PackIcon> packIcons;
+        for (auto& icon : icons) {
+            packIcons.push_back({ icon.name, icon.packed,
+                                  static_cast<uint32_t>(icon.svg.size()), icon.path });
+        }
+        std::vector<uint8_t> bytes = lucide_gen::BuildIconPack(std::move(packIcons), dict);
+        if (bytes.empty()) {
+            fprintf(stderr, "lucide_gen: duplicate icon names\n");
+            return 1;
+        }
+        return WriteIfChanged(output, std::string(bytes.begin(), bytes.end())) ? 0 : 1;
+    }
+
+    PerfectHash ph;
+    if (!BuildPerfectHash(icons, ph)) {
+        fprintf(stderr, "lucide_gen: failed to build perfect hash\n");
+        return 1;
+    }
+    return WriteIfChanged(output, Generate(icons, dict, ph)) ? 0 : 1;
+}
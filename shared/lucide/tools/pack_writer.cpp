@@ -0,0 +1,62 @@
+#include "pack_writer.h"
+#include "../src/pack_format.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lucide_gen {
+
+namespace {
+
+uint32_t Append(std::vector<uint8_t>& out, const void* data, size_t bytes) {
+    auto offset = static_cast<uint32_t>(out.size());
+    auto* p = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), p, p + bytes);
+    return offset;
+}
+
+} // namespace
+
+std::vector<uint8_t> BuildIconPack(std::vector<PackIcon> icons, const std::string& dict) {
+    using namespace lucide::pack;
+
+    std::sort(icons.begin(), icons.end(), [](const PackIcon& a, const PackIcon& b) {
+        return a.name < b.name;
+    });
+    for (size_t i = 1; i < icons.size(); i++)
+        if (icons[i - 1].name == icons[i].name) return {};
+
+    // Header and index first; entries are filled in as payloads land.
+    std::vector<uint8_t> out(sizeof(Header) + icons.size() * sizeof(Entry));
+    std::vector<Entry> entries(icons.size());
+
+    for (size_t i = 0; i < icons.size(); i++) {
+        entries[i].nameOffset = Append(out, icons[i].name.c_str(), icons[i].name.size() + 1);
+        entries[i].nameLength = static_cast<uint32_t>(icons[i].name.size());
+    }
+
+    Header header{};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.iconCount     = static_cast<uint32_t>(icons.size());
+    header.entriesOffset = sizeof(Header);
+    header.dictOffset    = Append(out, dict.data(), dict.size());
+    header.dictSize      = static_cast<uint32_t>(dict.size());
+
+    for (size_t i = 0; i < icons.size(); i++) {
+        auto& icon = icons[i];
+        entries[i].svgOffset  = Append(out, icon.svg.data(), icon.svg.size());
+        entries[i].svgSize    = static_cast<uint32_t>(icon.svg.size());
+        entries[i].svgLength  = icon.svgLength;
+        entries[i].pathOffset = Append(out, icon.path.data(), icon.path.size());
+        entries[i].pathSize   = static_cast<uint32_t>(icon.path.size());
+    }
+
+    header.fileSize = static_cast<uint32_t>(out.size());
+    memcpy(out.data(), &header, sizeof(header));
+    if (!entries.empty())
+        memcpy(out.data() + sizeof(Header), entries.data(), entries.size() * sizeof(Entry));
+    return out;
+}
+
+} // namespace lucide_gen
@@ -0,0 +1,23 @@
+#pragma once
+// ── Icon Pack Writer ────────────────────────────────────────
+// Lays out icons in the pack format of src/pack_format.h. Used by
+// `lucide_gen --pack` and by the pack benchmark.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lucide_gen {
+
+struct PackIcon {
+    std::string          name;
+    std::vector<uint8_t> svg;           // compressed against the pack dictionary
+    uint32_t             svgLength = 0; // decoded bytes
+    std::vector<uint8_t> path;          // compiled path, or empty
+};
+
+/// Serialize `icons` (in any order) with their shared SVG dictionary.
+/// Returns an empty buffer if two icons share a name.
+std::vector<uint8_t> BuildIconPack(std::vector<PackIcon> icons, const std::string& dict);
+
+} // namespace lucide_gen
@@ -0,0 +1,724 @@
+#include "path_compiler.h"
+#include "../src/path_format.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+
+namespace lucide_gen {
+
+namespace {
+
+using namespace lucide::path;
+
+constexpr double kTolerance = 0.01;   // max flattening error, viewBox units
+
+struct Point { double x = 0, y = 0; };
+
+// ── Minimal XML tag scanner ─────────────────────────────────
+// Enough for icon files: elements, attributes, comments and the XML
+// declaration. Entities and CDATA are not expected and cause a reject.
+
+struct Attr {
+    std::string name;
+    std::string value;
+};
+
+struct Tag {
+    std::string       name;
+    std::vector<Attr> attrs;
+    bool              closing = false;
+
+    const std::string* Find(const char* attr) const {
+        for (auto& a : attrs) if (a.name == attr) return &a.value;
+        return nullptr;
+    }
+};
+
+enum class Scan { Tag, Done, Error };
+
+Scan NextTag(const std::string& s, size_t& pos, Tag& tag) {
+    for (;;) {
+        pos = s.find('<', pos);
+        if (pos == std::string::npos) return Scan::Done;
+
+        if (s.compare(pos, 4, "<!--") == 0) {
+            pos = s.find("-->", pos);
+            if (pos == std::string::npos) return Scan::Error;
+            pos += 3;
+            continue;
+        }
+        if (s.compare(pos, 2, "<?") == 0 || s.compare(pos, 2, "<!") == 0) {
+            pos = s.find('>', pos);
+            if (pos == std::string::npos) return Scan::Error;
+            pos++;
+            continue;
+        }
+        break;
+    }
+
+    tag = Tag{};
+    pos++;
+    if (pos < s.size() && s[pos] == '/') { tag.closing = true; pos++; }
+
+    auto isName = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == ':' || c == '_';
+    };
+    auto skipWs = [&]() {
+        while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) pos++;
+    };
+
+    while (pos < s.size() && isName(s[pos])) tag.name += s[pos++];
+    if (tag.name.empty()) return Scan::Error;
+
+    for (;;) {
+        skipWs();
+        if (pos >= s.size()) return Scan::Error;
+        if (s[pos] == '>') { pos++; return Scan::Tag; }
+        if (s[pos] == '/') {
+            if (pos + 1 >= s.size() || s[pos + 1] != '>') return Scan::Error;
+            pos += 2;
+            return Scan::Tag;
+        }
+
+        Attr attr;
+        while (pos < s.size() && isName(s[pos])) attr.name += s[pos++];
+        skipWs();
+        if (attr.name.empty() || pos >= s.size() || s[pos] != '=') return Scan::Error;
+        pos++;
+        skipWs();
+        if (pos >= s.size() || (s[pos] != '"' && s[pos] != '\'')) return Scan::Error;
+        char quote = s[pos++];
+        size_t end = s.find(quote, pos);
+        if (end == std::string::npos) return Scan::Error;
+        attr.value = s.substr(pos, end - pos);
+        if (attr.value.find('&') != std::string::npos) return Scan::Error;
+        pos = end + 1;
+        tag.attrs.push_back(std::move(attr));
+    }
+}
+
+bool ParseNumber(const std::string& text, double& out) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    out = std::strtod(begin, &end);
+    if (end == begin) return false;
+    while (*end && std::isspace(static_cast<unsigned char>(*end))) end++;
+    if (std::strcmp(end, "px") == 0) end += 2;
+    return *end == '\0' && std::isfinite(out);
+}
+
+// ── Command stream writer ───────────────────────────────────
+
+class Writer {
+public:
+    explicit Writer(std::vector<uint8_t>& out) : m_out(out) {}
+
+    bool ok() const { return m_ok; }
+
+    void Header(int viewW, int viewH) {
+        m_out.push_back(kVersion);
+        m_out.push_back(static_cast<uint8_t>(viewW));
+        m_out.push_back(static_cast<uint8_t>(viewH));
+        m_out.push_back(0);
+    }
+
+    void Stroke(double width) {
+        m_out.push_back(kOpStroke);
+        U16(width);
+    }
+
+    void Move(Point p) {
+        int16_t x, y;
+        if (!Fixed(p.x, x) || !Fixed(p.y, y)) return;
+        m_out.push_back(kOpMove);
+        I16(x);
+        I16(y);
+        m_lastX = x;
+        m_lastY = y;
+        m_afterMove = true;
+    }
+
+    void Line(Point p) {
+        int16_t x, y;
+        if (!Fixed(p.x, x) || !Fixed(p.y, y)) return;
+        // Drop repeated points, but keep a zero-length segment right after
+        // a move: with round caps it draws a dot.
+        if (!m_afterMove && x == m_lastX && y == m_lastY) return;
+        m_out.push_back(kOpLine);
+        I16(x);
+        I16(y);
+        m_lastX = x;
+        m_lastY = y;
+        m_afterMove = false;
+    }
+
+    void Close() {
+        m_out.push_back(kOpClose);
+        m_afterMove = false;
+    }
+
+    void Circle(Point c, double r) {
+        int16_t x, y;
+        if (!Fixed(c.x, x) || !Fixed(c.y, y)) return;
+        m_out.push_back(kOpCircle);
+        I16(x);
+        I16(y);
+        U16(r);
+    }
+
+    void End() { m_out.push_back(kOpEnd); }
+
+private:
+    std::vector<uint8_t>& m_out;
+    bool    m_ok        = true;
+    bool    m_afterMove = false;
+    int16_t m_lastX     = 0;
+    int16_t m_lastY     = 0;
+
+    bool Fixed(double v, int16_t& q) {
+        double s = std::round(v * 256.0);
+        if (s < -32768.0 || s > 32767.0) { m_ok = false; return false; }
+        q = static_cast<int16_t>(s);
+        return true;
+    }
+
+    void I16(int16_t v) {
+        m_out.push_back(static_cast<uint8_t>(v & 0xFF));
+        m_out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
+    }
+
+    void U16(double v) {
+        double s = std::round(v * 256.0);
+        if (s < 0.0 || s > 65535.0) { m_ok = false; return; }
+        uint16_t q = static_cast<uint16_t>(s);
+        m_out.push_back(static_cast<uint8_t>(q & 0xFF));
+        m_out.push_back(static_cast<uint8_t>(q >> 8));
+    }
+};
+
+// ── Curve flattening ────────────────────────────────────────
+
+int Segments(double dd, double divisor) {
+    return std::clamp(static_cast<int>(std::ceil(std::sqrt(dd / divisor))), 1, 256);
+}
+
+void FlattenQuad(Writer& w, Point p0, Point p1, Point p2) {
+    double dd = std::hypot(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y);
+    int n = Segments(dd, 4 * kTolerance);
+    for (int i = 1; i <= n; i++) {
+        double t = static_cast<double>(i) / n, u = 1 - t;
+        w.Line({ u * u * p0.x + 2 * u * t * p1.x + t * t * p2.x,
+                 u * u * p0.y + 2 * u * t * p1.y + t * t * p2.y });
+    }
+}
+
+void FlattenCubic(Writer& w, Point p0, Point p1, Point p2, Point p3) {
+    double dd = std::max(
+        std::hypot(p0.x - 2 * p1.x + p2.x, p0.y - 2 * p1.y + p2.y),
+        std::hypot(p1.x - 2 * p2.x + p3.x, p1.y - 2 * p2.y + p3.y));
+    int n = Segments(3 * dd, 4 * kTolerance);
+    for (int i = 1; i <= n; i++) {
+        double t = static_cast<double>(i) / n, u = 1 - t;
+        double a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+        w.Line({ a * p0.x + b * p1.x + c * p2.x + d * p3.x,
+                 a * p0.y + b * p1.y + c * p2.y + d * p3.y });
+    }
+}
+
+// Endpoint → center parameterization per SVG 1.1 appendix F.6.5.
+void FlattenArc(Writer& w, Point p0, double rx, double ry, double angle,
+                bool largeArc, bool sweep, Point p1)
+{
+    rx = std::fabs(rx);
+    ry = std::fabs(ry);
+    if (rx == 0 || ry == 0 || (p0.x == p1.x && p0.y == p1.y)) {
+        w.Line(p1);
+        return;
+    }
+
+    double phi = angle * std::numbers::pi / 180.0;
+    double cs = std::cos(phi), sn = std::sin(phi);
+    double dx = (p0.x - p1.x) / 2, dy = (p0.y - p1.y) / 2;
+    double x1 =  cs * dx + sn * dy;
+    double y1 = -sn * dx + cs * dy;
+
+    double lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+    if (lambda > 1) {
+        double s = std::sqrt(lambda);
+        rx *= s;
+        ry *= s;
+    }
+
+    double num = rx * rx * ry * ry - rx * rx * y1 * y1 - ry * ry * x1 * x1;
+    double den = rx * rx * y1 * y1 + ry * ry * x1 * x1;
+    double coef = std::sqrt(std::max(0.0, num / den));
+    if (largeArc == sweep) coef = -coef;
+    double cx1 =  coef * rx * y1 / ry;
+    double cy1 = -coef * ry * x1 / rx;
+
+    double cx = cs * cx1 - sn * cy1 + (p0.x + p1.x) / 2;
+    double cy = sn * cx1 + cs * cy1 + (p0.y + p1.y) / 2;
+
+    auto vecAngle = [](double ux, double uy, double vx, double vy) {
+        return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+    };
+    double theta = vecAngle(1, 0, (x1 - cx1) / rx, (y1 - cy1) / ry);
+    double delta = vecAngle((x1 - cx1) / rx, (y1 - cy1) / ry,
+                            (-x1 - cx1) / rx, (-y1 - cy1) / ry);
+    if (!sweep && delta > 0) delta -= 2 * std::numbers::pi;
+    if (sweep && delta < 0)  delta += 2 * std::numbers::pi;
+
+    double r = std::max(rx, ry);
+    double step = 2 * std::acos(std::max(-1.0, 1 - kTolerance / r));
+    int n = std::clamp(static_cast<int>(std::ceil(std::fabs(delta) / step)), 1, 256);
+    for (int i = 1; i < n; i++) {
+        double t = theta + delta * i / n;
+        double ex = rx * std::cos(t), ey = ry * std::sin(t);
+        w.Line({ cs * ex - sn * ey + cx, sn * ex + cs * ey + cy });
+    }
+    w.Line(p1);
+}
+
+// ── Path data ───────────────────────────────────────────────
+
+class PathData {
+public:
+    explicit PathData(const std::string& d) : m_p(d.c_str()), m_end(d.c_str() + d.size()) {}
+
+    bool Compile(Writer& w, std::string& reason) {
+        Point cur, start, ctrl;
+        char prev = 0, cmd = 0;
+
+        for (;;) {
+            SkipSeparators();
+            if (m_p >= m_end) break;
+
+            if (std::isalpha(static_cast<unsigned char>(*m_p))) {
+                cmd = *m_p++;
+            } else if (cmd == 0) {
+                reason = "path data does not start with a command";
+                return false;
+            } else if (cmd == 'M') {
+                cmd = 'L';      // implicit lineto after moveto
+            } else if (cmd == 'm') {
+                cmd = 'l';
+            } else if (cmd == 'Z' || cmd == 'z') {
+                reason = "number after closepath";
+                return false;
+            }
+
+            bool rel = std::islower(static_cast<unsigned char>(cmd)) != 0;
+            Point base = rel ? cur : Point{};
+            char up = static_cast<char>(std::toupper(static_cast<unsigned char>(cmd)));
+
+            switch (up) {
+            case 'M': {
+                Point p;
+                if (!Pair(p)) return Fail(reason);
+                cur = start = { base.x + p.x, base.y + p.y };
+                w.Move(cur);
+                break;
+            }
+            case 'L': {
+                Point p;
+                if (!Pair(p)) return Fail(reason);
+                cur = { base.x + p.x, base.y + p.y };
+                w.Line(cur);
+                break;
+            }
+            case 'H': {
+                double x;
+                if (!Number(x)) return Fail(reason);
+                cur.x = base.x + x;
+                w.Line(cur);
+                break;
+            }
+            case 'V': {
+                double y;
+                if (!Number(y)) return Fail(reason);
+                cur.y = base.y + y;
+                w.Line(cur);
+                break;
+            }
+            case 'C': {
+                Point p1, p2, p;
+                if (!Pair(p1) || !Pair(p2) || !Pair(p)) return Fail(reason);
+                p1 = { base.x + p1.x, base.y + p1.y };
+                p2 = { base.x + p2.x, base.y + p2.y };
+                p  = { base.x + p.x,  base.y + p.y };
+                FlattenCubic(w, cur, p1, p2, p);
+                ctrl = p2;
+                cur = p;
+                break;
+            }
+            case 'S': {
+                Point p2, p;
+                if (!Pair(p2) || !Pair(p)) return Fail(reason);
+                Point p1 = (prev == 'C' || prev == 'S')
+                    ? Point{ 2 * cur.x - ctrl.x, 2 * cur.y - ctrl.y } : cur;
+                p2 = { base.x + p2.x, base.y + p2.y };
+                p  = { base.x + p.x,  base.y + p.y };
+                FlattenCubic(w, cur, p1, p2, p);
+                ctrl = p2;
+                cur = p;
+                break;
+            }
+            case 'Q': {
+                Point p1, p;
+                if (!Pair(p1) || !Pair(p)) return Fail(reason);
+                p1 = { base.x + p1.x, base.y + p1.y };
+                p  = { base.x + p.x,  base.y + p.y };
+                FlattenQuad(w, cur, p1, p);
+                ctrl = p1;
+                cur = p;
+                break;
+            }
+            case 'T': {
+                Point p;
+                if (!Pair(p)) return Fail(reason);
+                Point p1 = (prev == 'Q' || prev == 'T')
+                    ? Point{ 2 * cur.x - ctrl.x, 2 * cur.y - ctrl.y } : cur;
+                p = { base.x + p.x, base.y + p.y };
+                FlattenQuad(w, cur, p1, p);
+                ctrl = p1;
+                cur = p;
+                break;
+            }
+            case 'A': {
+                double rx, ry, angle;
+                bool large, sweep;
+                Point p;
+                if (!Number(rx) || !Number(ry) || !Number(angle) ||
+                    !Flag(large) || !Flag(sweep) || !Pair(p))
+                    return Fail(reason);
+                p = { base.x + p.x, base.y + p.y };
+                FlattenArc(w, cur, rx, ry, angle, large, sweep, p);
+                cur = p;
+                break;
+            }
+            case 'Z':
+                w.Close();
+                cur = start;
+                break;
+            default:
+                reason = std::string("unsupported path command '") + cmd + "'";
+                return false;
+            }
+            prev = up;
+        }
+        return true;
+    }
+
+private:
+    const char* m_p;
+    const char* m_end;
+
+    static bool Fail(std::string& reason) {
+        reason = "malformed path data";
+        return false;
+    }
+
+    void SkipSeparators() {
+        while (m_p < m_end && (std::isspace(static_cast<unsigned char>(*m_p)) || *m_p == ','))
+            m_p++;
+    }
+
+    // SVG number grammar: sign, digits, optional fraction, optional
+    // exponent. "1.5.5" is two numbers and "1-2" is two numbers.
+    bool Number(double& out) {
+        SkipSeparators();
+        const char* s = m_p;
+        if (s < m_end && (*s == '+' || *s == '-')) s++;
+        bool digits = false;
+        while (s < m_end && std::isdigit(static_cast<unsigned char>(*s))) { s++; digits = true; }
+        if (s < m_end && *s == '.') {
+            s++;
+            while (s < m_end && std::isdigit(static_cast<unsigned char>(*s))) { s++; digits = true; }
+        }
+        if (!digits) return false;
+        if (s < m_end && (*s == 'e' || *s == 'E')) {
+            const char* e = s + 1;
+            if (e < m_end && (*e == '+' || *e == '-')) e++;
+            if (e < m_end && std::isdigit(static_cast<unsigned char>(*e))) {
+                while (e < m_end && std::isdigit(static_cast<unsigned char>(*e))) e++;
+                s = e;
+            }
+        }
+        out = std::strtod(std::string(m_p, s).c_str(), nullptr);
+        m_p = s;
+        return true;
+    }
+
+    // Arc flags are single characters and may be packed ("a1 1 0 011 1").
+    bool Flag(bool& out) {
+        SkipSeparators();
+        if (m_p >= m_end || (*m_p != '0' && *m_p != '1')) return false;
+        out = *m_p++ == '1';
+        return true;
+    }
+
+    bool Pair(Point& p) { return Number(p.x) && Number(p.y); }
+};
+
+// ── Elements ────────────────────────────────────────────────
+
+bool Attribute(const Tag& tag, const char* name, double& out, double fallback) {
+    auto* v = tag.Find(name);
+    if (!v) { out = fallback; return true; }
+    return ParseNumber(*v, out);
+}
+
+bool PointList(const std::string& text, std::vector<Point>& out) {
+    const char* p = text.c_str();
+    out.clear();
+    for (;;) {
+        while (*p && (std::isspace(static_cast<unsigned char>(*p)) || *p == ',')) p++;
+        if (!*p) return out.size() >= 2;
+        char* end = nullptr;
+        double x = std::strtod(p, &end);
+        if (end == p) return false;
+        p = end;
+        while (*p && (std::isspace(static_cast<unsigned char>(*p)) || *p == ',')) p++;
+        double y = std::strtod(p, &end);
+        if (end == p) return false;
+        p = end;
+        out.push_back({ x, y });
+    }
+}
+
+void EllipseOutline(Writer& w, double cx, double cy, double rx, double ry) {
+    double r = std::max(rx, ry);
+    double step = 2 * std::acos(std::max(-1.0, 1 - kTolerance / r));
+    int n = std::clamp(static_cast<int>(std::ceil(2 * std::numbers::pi / step)), 8, 512);
+    w.Move({ cx + rx, cy });
+    for (int i = 1; i < n; i++) {
+        double t = 2 * std::numbers::pi * i / n;
+        w.Line({ cx + rx * std::cos(t), cy + ry * std::sin(t) });
+    }
+    w.Close();
+}
+
+bool CompileRect(Writer& w, const Tag& tag, std::string& reason) {
+    double x, y, width, height, rx, ry;
+    if (!Attribute(tag, "x", x, 0) || !Attribute(tag, "y", y, 0) ||
+        !Attribute(tag, "width", width, 0) || !Attribute(tag, "height", height, 0) ||
+        !Attribute(tag, "rx", rx, -1) || !Attribute(tag, "ry", ry, -1)) {
+        reason = "malformed rect";
+        return false;
+    }
+    if (width <= 0 || height <= 0) return true;   // not rendered
+
+    // SVG auto rules: a missing radius takes the other's value.
+    if (rx < 0 && ry < 0) rx = ry = 0;
+    else if (rx < 0) rx = ry;
+    else if (ry < 0) ry = rx;
+    rx = std::min(rx, width / 2);
+    ry = std::min(ry, height / 2);
+
+    if (rx == 0 || ry == 0) {
+        w.Move({ x, y });
+        w.Line({ x + width, y });
+        w.Line({ x + width, y + height });
+        w.Line({ x, y + height });
+        w.Close();
+        return true;
+    }
+
+    double r = x + width, b = y + height;
+    w.Move({ x + rx, y });
+    w.Line({ r - rx, y });
+    FlattenArc(w, { r - rx, y }, rx, ry, 0, false, true, { r, y + ry });
+    w.Line({ r, b - ry });
+    FlattenArc(w, { r, b - ry }, rx, ry, 0, false, true, { r - rx, b });
+    w.Line({ x + rx, b });
+    FlattenArc(w, { x + rx, b }, rx, ry, 0, false, true, { x, b - ry });
+    w.Line({ x, y + ry });
+    FlattenArc(w, { x, y + ry }, rx, ry, 0, false, true, { x + rx, y });
+    w.Close();
+    return true;
+}
+
+bool CompileElement(Writer& w, const Tag& tag, std::string& reason) {
+    if (tag.name == "path") {
+        auto* d = tag.Find("d");
+        if (!d) return true;
+        PathData data(*d);
+        return data.Compile(w, reason);
+    }
+    if (tag.name == "line") {
+        double x1, y1, x2, y2;
+        if (!Attribute(tag, "x1", x1, 0) || !Attribute(tag, "y1", y1, 0) ||
+            !Attribute(tag, "x2", x2, 0) || !Attribute(tag, "y2", y2, 0)) {
+            reason = "malformed line";
+            return false;
+        }
+        w.Move({ x1, y1 });
+        w.Line({ x2, y2 });
+        return true;
+    }
+    if (tag.name == "circle") {
+        double cx, cy, r;
+        if (!Attribute(tag, "cx", cx, 0) || !Attribute(tag, "cy", cy, 0) ||
+            !Attribute(tag, "r", r, 0)) {
+            reason = "malformed circle";
+            return false;
+        }
+        if (r > 0) w.Circle({ cx, cy }, r);
+        return true;
+    }
+    if (tag.name == "ellipse") {
+        double cx, cy, rx, ry;
+        if (!Attribute(tag, "cx", cx, 0) || !Attribute(tag, "cy", cy, 0) ||
+            !Attribute(tag, "rx", rx, 0) || !Attribute(tag, "ry", ry, 0)) {
+            reason = "malformed ellipse";
+            return false;
+        }
+        if (rx > 0 && ry > 0) EllipseOutline(w, cx, cy, rx, ry);
+        return true;
+    }
+    if (tag.name == "rect") {
+        return CompileRect(w, tag, reason);
+    }
+    if (tag.name == "polyline" || tag.name == "polygon") {
+        std::vector<Point> pts;
+        auto* text = tag.Find("points");
+        if (!text || !PointList(*text, pts)) {
+            reason = "malformed " + tag.name;
+            return false;
+        }
+        w.Move(pts[0]);
+        for (size_t i = 1; i < pts.size(); i++) w.Line(pts[i]);
+        if (tag.name == "polygon") w.Close();
+        return true;
+    }
+    reason = "unsupported element <" + tag.name + ">";
+    return false;
+}
+
+// Presentation attributes the rasterizer can honour. Anything else on a
+// shape (fill, transform, opacity, dashes...) sends the icon to lunasvg.
+bool CheckStyle(const Tag& tag, bool root, std::string& reason) {
+    static const char* const kGeometry[] = {
+        "d", "x", "y", "width", "height", "rx", "ry", "cx", "cy", "r",
+        "x1", "y1", "x2", "y2", "points",
+    };
+    static const char* const kIgnored[] = {
+        "xmlns", "class", "id", "key", "viewBox", "version",
+    };
+
+    for (auto& a : tag.attrs) {
+        auto in = [&](auto& list) {
+            return std::find_if(std::begin(list), std::end(list),
+                [&](const char* n) { return a.name == n; }) != std::end(list);
+        };
+        if (in(kIgnored)) continue;
+        if (!root && in(kGeometry)) continue;
+        if (root && (a.name == "width" || a.name == "height")) continue;
+
+        if (a.name == "fill" && a.value == "none") continue;
+        if (a.name == "stroke" && a.value == "currentColor") continue;
+        if (a.name == "stroke-linecap" && a.value == "round") continue;
+        if (a.name == "stroke-linejoin" && a.value == "round") continue;
+        if (a.name == "stroke-width") continue;
+
+        reason = "unsupported attribute " + a.name + "=\"" + a.value + "\" on <" + tag.name + ">";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool CompilePath(const std::string& svg, std::vector<uint8_t>& out, std::string& reason) {
+    out.clear();
+    Writer w(out);
+
+    size_t pos = 0;
+    Tag tag;
+    if (NextTag(svg, pos, tag) != Scan::Tag || tag.name != "svg" || tag.closing) {
+        reason = "missing <svg> root";
+        return false;
+    }
+    if (!CheckStyle(tag, true, reason)) return false;
+
+    // The root must set everything the rasterizer assumes.
+    auto require = [&](const char* name, const char* value) {
+        auto* v = tag.Find(name);
+        if (v && *v == value) return true;
+        reason = std::string("root must declare ") + name + "=\"" + value + "\"";
+        return false;
+    };
+    if (!require("fill", "none") || !require("stroke", "currentColor") ||
+        !require("stroke-linecap", "round") || !require("stroke-linejoin", "round"))
+        return false;
+
+    int viewW = 0, viewH = 0;
+    {
+        auto* vb = tag.Find("viewBox");
+        double v[4] = {};
+        const char* p = vb ? vb->c_str() : "";
+        for (double& d : v) {
+            char* end = nullptr;
+            d = std::strtod(p, &end);
+            if (end == p) { reason = "missing or malformed viewBox"; return false; }
+            p = end;
+            while (*p == ',' || std::isspace(static_cast<unsigned char>(*p))) p++;
+        }
+        if (v[0] != 0 || v[1] != 0 || v[2] != std::floor(v[2]) || v[3] != std::floor(v[3]) ||
+            v[2] < 1 || v[2] > 255 || v[3] < 1 || v[3] > 255) {
+            reason = "viewBox must be 0 0 W H with integer W, H in 1..255";
+            return false;
+        }
+        viewW = static_cast<int>(v[2]);
+        viewH = static_cast<int>(v[3]);
+    }
+
+    double rootStroke = 1.0;
+    if (auto* sw = tag.Find("stroke-width"); sw && !ParseNumber(*sw, rootStroke)) {
+        reason = "malformed stroke-width";
+        return false;
+    }
+
+    w.Header(viewW, viewH);
+    w.Stroke(rootStroke);
+    double currentStroke = rootStroke;
+
+    for (;;) {
+        Scan s = NextTag(svg, pos, tag);
+        if (s == Scan::Done) break;
+        if (s == Scan::Error) { reason = "malformed XML"; return false; }
+        if (tag.closing) {
+            if (tag.name == "svg") break;
+            continue;
+        }
+        if (tag.name == "title" || tag.name == "desc") {
+            reason = "text content elements are not supported";
+            return false;
+        }
+        if (!CheckStyle(tag, false, reason)) return false;
+
+        double stroke = rootStroke;
+        if (auto* sw = tag.Find("stroke-width"); sw && !ParseNumber(*sw, stroke)) {
+            reason = "malformed stroke-width";
+            return false;
+        }
+        if (stroke != currentStroke) {
+            w.Stroke(stroke);
+            currentStroke = stroke;
+        }
+        if (!CompileElement(w, tag, reason)) return false;
+    }
+
+    w.End();
+    if (!w.ok()) {
+        reason = "coordinates out of fixed-point range";
+        return false;
+    }
+    return true;
+}
+
+} // namespace lucide_gen
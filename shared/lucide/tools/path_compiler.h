@@ -0,0 +1,17 @@
+#pragma once
+// ── SVG → Compiled Path ─────────────────────────────────────
+// Turns a Lucide-style SVG into the command stream described in
+// src/path_format.h. Anything outside the supported subset is rejected
+// with a reason, and the icon keeps rendering through lunasvg.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lucide_gen {
+
+/// Compile `svg` into `out`. Returns false (with `reason` set) if the
+/// icon uses a feature the runtime rasterizer doesn't handle.
+bool CompilePath(const std::string& svg, std::vector<uint8_t>& out, std::string& reason);
+
+} // namespace lucide_gen
@@ -0,0 +1,315 @@
+#include "svg_pack.h"
+#include "../src/svg_codec.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+
+namespace lucide_gen {
+
+namespace {
+
+bool IsSpace(char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+bool IsDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
+
+bool IsNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == ':' || c == '_';
+}
+
+// ── Numbers ─────────────────────────────────────────────────
+
+// Length of the SVG number starting at `p`, or 0 if there is none.
+size_t ScanNumber(const std::string& s, size_t p) {
+    size_t i = p, digits = 0;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) i++;
+    while (i < s.size() && IsDigit(s[i])) { i++; digits++; }
+    if (i < s.size() && s[i] == '.') {
+        i++;
+        while (i < s.size() && IsDigit(s[i])) { i++; digits++; }
+    }
+    if (digits == 0) return 0;
+
+    if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+        size_t j = i + 1, expDigits = 0;
+        if (j < s.size() && (s[j] == '+' || s[j] == '-')) j++;
+        while (j < s.size() && IsDigit(s[j])) { j++; expDigits++; }
+        if (expDigits) i = j;
+    }
+    return i - p;
+}
+
+// Shortest spelling of a decimal without changing its digits:
+// "+0.50" → ".5", "2.0" → "2". Exponents are left alone.
+std::string CompactNumber(std::string num) {
+    if (num[0] == '+') num.erase(0, 1);
+    if (num.find_first_of("eE") != std::string::npos) return num;
+
+    if (num.find('.') != std::string::npos) {
+        while (num.back() == '0') num.pop_back();
+        if (num.back() == '.') num.pop_back();
+    }
+    size_t lead = num[0] == '-' ? 1 : 0;
+    if (num.size() > lead + 1 && num[lead] == '0' && num[lead + 1] == '.')
+        num.erase(lead, 1);
+    if (num.empty() || num == "-") num = "0";
+    return num;
+}
+
+// Path data and point lists: drop every separator a parser doesn't need.
+// A number only needs one after another number, unless it starts with a
+// sign, or starts with '.' and the previous one already has a '.' or an
+// exponent. Anything unexpected keeps the value as written.
+std::string CompactList(const std::string& value) {
+    std::string out;
+    bool afterNumber = false, afterFraction = false;
+
+    for (size_t i = 0; i < value.size();) {
+        char c = value[i];
+        if (IsSpace(c) || c == ',') { i++; continue; }
+
+        if (size_t len = ScanNumber(value, i)) {
+            std::string num = CompactNumber(value.substr(i, len));
+            bool joins = num[0] == '-' || (num[0] == '.' && afterFraction);
+            if (afterNumber && !joins) out += ' ';
+            out += num;
+            afterNumber   = true;
+            afterFraction = num.find_first_of(".eE") != std::string::npos;
+            i += len;
+            continue;
+        }
+
+        if (!std::isalpha(static_cast<unsigned char>(c))) return value;
+        out += c;
+        afterNumber = afterFraction = false;
+        i++;
+    }
+    return out;
+}
+
+std::string CompactValue(const std::string& name, const std::string& value) {
+    if (name == "d" || name == "points" || name == "viewBox")
+        return CompactList(value);
+
+    size_t start = 0, end = value.size();
+    while (start < end && IsSpace(value[start])) start++;
+    while (end > start && IsSpace(value[end - 1])) end--;
+    std::string trimmed = value.substr(start, end - start);
+    if (!trimmed.empty() && ScanNumber(trimmed, 0) == trimmed.size())
+        return CompactNumber(trimmed);
+    return value;
+}
+
+// ── Dictionary fragments ────────────────────────────────────
+
+// Root tag plus each element opener up to its first attribute value,
+// e.g. `<circle cx="`.
+std::vector<std::string> Fragments(const std::string& svg) {
+    std::vector<std::string> out;
+    size_t root = svg.find('>');
+    if (root == std::string::npos) return out;
+    out.push_back(svg.substr(0, root + 1));
+
+    for (size_t pos = svg.find('<', root); pos != std::string::npos; pos = svg.find('<', pos + 1)) {
+        if (pos + 1 >= svg.size() || svg[pos + 1] == '/') continue;
+        size_t value = svg.find("=\"", pos);
+        size_t close = svg.find('>', pos);
+        if (value != std::string::npos && value < close)
+            out.push_back(svg.substr(pos, value + 2 - pos));
+    }
+    return out;
+}
+
+// ── Compressor ──────────────────────────────────────────────
+
+constexpr size_t kMaxDictionary = 4096;
+constexpr int    kHashBits      = 14;
+constexpr int    kMaxChain      = 256;
+
+uint32_t Hash4(const std::string& s, size_t p) {
+    uint32_t v = static_cast<uint8_t>(s[p])
+               | static_cast<uint8_t>(s[p + 1]) << 8
+               | static_cast<uint8_t>(s[p + 2]) << 16
+               | static_cast<uint32_t>(static_cast<uint8_t>(s[p + 3])) << 24;
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteExtension(std::vector<uint8_t>& out, size_t len) {
+    if (len < 15) return;
+    len -= 15;
+    while (len >= 255) { out.push_back(255); len -= 255; }
+    out.push_back(static_cast<uint8_t>(len));
+}
+
+void WriteSequence(std::vector<uint8_t>& out, const std::string& window,
+                   size_t litStart, size_t litEnd, size_t match, size_t distance)
+{
+    size_t literals = litEnd - litStart;
+    size_t extra = match ? match - lucide::kSvgMinMatch : 0;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4 |
+                                       std::min<size_t>(extra, 15)));
+    WriteExtension(out, literals);
+    out.insert(out.end(), window.begin() + litStart, window.begin() + litEnd);
+    if (!match) return;
+
+    WriteExtension(out, extra);
+    out.push_back(static_cast<uint8_t>(distance));
+    out.push_back(static_cast<uint8_t>(distance >> 8));
+}
+
+} // namespace
+
+bool MinifySvg(const std::string& s, std::string& out) {
+    out.clear();
+    size_t pos = 0;
+
+    auto skipWs = [&]() { while (pos < s.size() && IsSpace(s[pos])) pos++; };
+    auto readName = [&]() {
+        std::string name;
+        while (pos < s.size() && IsNameChar(s[pos])) name += s[pos++];
+        return name;
+    };
+
+    while (pos < s.size()) {
+        if (s[pos] != '<') {
+            size_t next = std::min(s.find('<', pos), s.size());
+            std::string text = s.substr(pos, next - pos);
+            if (!std::all_of(text.begin(), text.end(), IsSpace)) out += text;
+            pos = next;
+            continue;
+        }
+
+        if (s.compare(pos, 4, "<!--") == 0) {
+            pos = s.find("-->", pos);
+            if (pos == std::string::npos) return false;
+            pos += 3;
+            continue;
+        }
+        if (s.compare(pos, 2, "<?") == 0 || s.compare(pos, 2, "<!") == 0) {
+            pos = s.find('>', pos);
+            if (pos == std::string::npos) return false;
+            pos++;
+            continue;
+        }
+
+        pos++;
+        if (pos < s.size() && s[pos] == '/') {
+            pos++;
+            std::string name = readName();
+            skipWs();
+            if (name.empty() || pos >= s.size() || s[pos] != '>') return false;
+            pos++;
+            out += "</" + name + ">";
+            continue;
+        }
+
+        std::string name = readName();
+        if (name.empty()) return false;
+        out += "<" + name;
+
+        for (;;) {
+            skipWs();
+            if (pos >= s.size()) return false;
+            if (s[pos] == '>') { pos++; out += ">"; break; }
+            if (s[pos] == '/') {
+                if (pos + 1 >= s.size() || s[pos + 1] != '>') return false;
+                pos += 2;
+                out += "/>";
+                break;
+            }
+
+            std::string attr = readName();
+            skipWs();
+            if (attr.empty() || pos >= s.size() || s[pos] != '=') return false;
+            pos++;
+            skipWs();
+            if (pos >= s.size() || (s[pos] != '"' && s[pos] != '\'')) return false;
+            char quote = s[pos++];
+            size_t end = s.find(quote, pos);
+            if (end == std::string::npos) return false;
+            std::string value = s.substr(pos, end - pos);
+            pos = end + 1;
+
+            // Styling hooks for web pages; nothing here renders them.
+            if (attr == "class") continue;
+
+            value = CompactValue(attr, value);
+            char q = value.find('"') == std::string::npos ? '"' : '\'';
+            out += " " + attr + "=" + q + value + q;
+        }
+    }
+    return true;
+}
+
+std::string BuildSvgDictionary(const std::vector<std::string>& svgs) {
+    std::map<std::string, size_t> counts;
+    for (auto& svg : svgs)
+        for (auto& fragment : Fragments(svg)) counts[fragment]++;
+
+    std::vector<std::pair<std::string, size_t>> shared;
+    for (auto& [fragment, count] : counts)
+        if (count > 1) shared.emplace_back(fragment, count);
+
+    // Keep the most valuable fragments if the set outgrows the budget.
+    std::stable_sort(shared.begin(), shared.end(), [](auto& a, auto& b) {
+        return a.second * a.first.size() > b.second * b.first.size();
+    });
+    size_t bytes = 0, keep = 0;
+    while (keep < shared.size() && bytes + shared[keep].first.size() <= kMaxDictionary)
+        bytes += shared[keep++].first.size();
+    shared.resize(keep);
+
+    std::stable_sort(shared.begin(), shared.end(), [](auto& a, auto& b) {
+        return a.second < b.second;
+    });
+    std::string dict;
+    for (auto& [fragment, count] : shared) dict += fragment;
+    if (svgs.size() > 1) dict += "\"/></svg>";
+    return dict;
+}
+
+std::vector<uint8_t> CompressSvg(const std::string& dict, const std::string& svg) {
+    const std::string window = dict + svg;
+    const size_t base = dict.size();
+
+    std::vector<int> head(size_t(1) << kHashBits, -1);
+    std::vector<int> prev(window.size(), -1);
+    auto insert = [&](size_t p) {
+        if (p + 4 > window.size()) return;
+        uint32_t h = Hash4(window, p);
+        prev[p] = head[h];
+        head[h] = static_cast<int>(p);
+    };
+    for (size_t p = 0; p < base; p++) insert(p);
+
+    std::vector<uint8_t> out;
+    size_t litStart = base;
+    for (size_t i = base; i < window.size();) {
+        size_t bestLen = 0, bestDistance = 0;
+        if (i + 4 <= window.size()) {
+            int tries = 0;
+            for (int cand = head[Hash4(window, i)]; cand >= 0 && tries < kMaxChain;
+                 cand = prev[cand], tries++)
+            {
+                size_t distance = i - cand;
+                if (distance > lucide::kSvgMaxDistance) break;
+                size_t len = 0;
+                while (i + len < window.size() && window[cand + len] == window[i + len]) len++;
+                if (len > bestLen) { bestLen = len; bestDistance = distance; }
+            }
+        }
+
+        if (bestLen < lucide::kSvgMinMatch) {
+            insert(i++);
+            continue;
+        }
+        WriteSequence(out, window, litStart, i, bestLen, bestDistance);
+        for (size_t k = 0; k < bestLen; k++) insert(i + k);
+        i += bestLen;
+        litStart = i;
+    }
+    if (litStart < window.size())
+        WriteSequence(out, window, litStart, window.size(), 0, 0);
+    return out;
+}
+
+} // namespace lucide_gen
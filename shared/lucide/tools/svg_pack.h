@@ -0,0 +1,26 @@
+#pragma once
+// ── SVG Minify & Compress ───────────────────────────────────
+// Build-time half of the embedded SVG storage: strips everything a
+// renderer ignores from the icon text, derives a shared dictionary from
+// the whole set and compresses each icon against it in the format
+// described in src/svg_codec.h.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lucide_gen {
+
+/// Drop comments, processing instructions, inter-tag whitespace and
+/// class attributes; normalize attribute spacing; compact numbers and
+/// path/point lists. Returns false if the markup can't be scanned.
+bool MinifySvg(const std::string& svg, std::string& out);
+
+/// Dictionary of markup fragments shared across `svgs`, most frequent
+/// last so the commonest matches get the shortest distances.
+std::string BuildSvgDictionary(const std::vector<std::string>& svgs);
+
+/// Compress `svg` against `dict`.
+std::vector<uint8_t> CompressSvg(const std::string& dict, const std::string& svg);
+
+} // namespace lucide_gen
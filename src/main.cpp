@@ -1,6 +1,10 @@
 #include <windows.h>
 #include <commctrl.h>
 #include <uxtheme.h>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
 #include "resource.h"
 
 // ExoUI shared library
@@ -8,34 +12,125 @@
 #include <exo/theme.h>
 #include <exo/render.h>
 #include <exo/icons.h>
+#include <exo/animator.h>
+#include <exo/icon_service.h>
 #include <exo/controls/toolbar.h>
 #include <exo/controls/sidebar.h>
 #include <exo/controls/statusbar.h>
+#include <exo/controls/item_view.h>
+#include <exo/controls/profiler_overlay.h>
 
 // ── Control IDs ─────────────────────────────────────────────
 enum CtrlId : int {
     IDC_TOOLBAR   = 100,
     IDC_SIDEBAR   = 101,
-    IDC_LISTVIEW  = 102,
+    IDC_ITEMVIEW  = 102,
     IDC_STATUSBAR = 103,
 };
 
+// ── Commands ────────────────────────────────────────────────
+// Keyboard-only, through the accelerator table made in wWinMain.
+enum CmdId : int {
+    IDM_PROFILER      = 200,    // F12: show or hide the paint profiler
+    IDM_PROFILER_DUMP = 201,    // Ctrl+F12: write the profile to a file
+};
+
+static constexpr UINT_PTR       TIMER_PROFILER      = 1;
+static constexpr UINT           PROFILER_REFRESH_MS = 1000;
+static constexpr const wchar_t* PROFILE_FILE        = L"ExoSuite-profile.txt";
+
+// ── Details Columns ─────────────────────────────────────────
+static constexpr exo::ItemColumn kItemColumns[] = {
+    { L"Name",        240 },
+    { L"Category",    140 },
+    { L"Description", 360 },
+};
+
+// ── Applets ─────────────────────────────────────────────────
+// What the item view lists. `category` indexes exo::kCategories, whose
+// first entry (All) is the sidebar's unfiltered view.
+struct Applet {
+    const wchar_t* name;
+    int            category;
+    const wchar_t* description;
+    const char*    icon;
+};
+
+static constexpr Applet kApplets[] = {
+    { L"System Information",    1, L"Hardware, firmware and operating system details", "badge-info"   },
+    { L"Environment Variables", 1, L"User and system environment variables",           "string"       },
+    { L"Registry Editor",       1, L"Browse and edit registry keys and values",        "binary"       },
+    { L"Storage",               1, L"Drives, volumes and free space",                  "save"         },
+    { L"Network Adapters",      2, L"Adapters, addresses and link state",              "network"      },
+    { L"Hosts File",            2, L"Local host name overrides",                       "file"         },
+    { L"Firewall",              3, L"Inbound and outbound rules",                      "security"     },
+    { L"Credentials",           3, L"Saved Windows and web credentials",               "copy"         },
+    { L"Displays",              4, L"Resolution, scaling and arrangement",             "display"      },
+    { L"Appearance",            4, L"Light, dark or follow the system",                "theme-system" },
+    { L"Installed Programs",    5, L"Installed applications and their uninstallers",   "programs"     },
+    { L"Startup Apps",          5, L"Programs launched at sign-in",                    "folder-open"  },
+};
+
+// The applets of the sidebar's category, for the item view.
+class AppletModel final : public exo::ItemModel {
+public:
+    // Resolve the icons (once Lucide is loaded) and show every applet.
+    void Init() {
+        for (size_t i = 0; i < std::size(kApplets); i++)
+            m_icons[i] = exo::LucideIcons::Find(kApplets[i].icon);
+        Filter(0);
+    }
+
+    // Only `category`'s applets; 0 shows them all.
+    void Filter(int category) {
+        m_shown.clear();
+        for (int i = 0; i < static_cast<int>(std::size(kApplets)); i++) {
+            if (category == 0 || kApplets[i].category == category) m_shown.push_back(i);
+        }
+    }
+
+    int Count() const override { return static_cast<int>(m_shown.size()); }
+    std::wstring_view Label(int item) const override { return kApplets[m_shown[item]].name; }
+    int Icon(int item) const override { return m_icons[m_shown[item]]; }
+
+    std::wstring_view Detail(int item, int column) const override {
+        const Applet& a = kApplets[m_shown[item]];
+        switch (column) {
+        case 1: return exo::kCategories[a.category].label;
+        case 2: return a.description;
+        }
+        return {};
+    }
+
+private:
+    int              m_icons[std::size(kApplets)] = {};
+    std::vector<int> m_shown;                   // kApplets indices, in order
+};
+
 // ── Application State ───────────────────────────────────────
 struct AppState {
-    exo::Toolbar   toolbar;
-    exo::Sidebar   sidebar;
-    exo::StatusBar statusbar;
-    HWND           listView  = nullptr;
-    HBRUSH         bgBrush   = nullptr;
-    int            dpi       = 96;
+    AppletModel          applets;               // before itemView, which points at it
+    exo::Toolbar         toolbar;
+    exo::Sidebar         sidebar;
+    exo::StatusBar       statusbar;
+    exo::ItemView        itemView;
+    exo::ProfilerOverlay profiler;
+    exo::ProfileReport   overlayReport;         // rates since the last refresh
+    exo::ProfileReport   dumpReport;            // rates since the last dump
+    HBRUSH               bgBrush      = nullptr;
+    uint32_t             brushVersion = 0;      // Theme::Version() bgBrush was made at
+    uint32_t             themeSub     = 0;
+    int                  dpi          = 96;
 
     void DestroyBrushes() {
         if (bgBrush) { DeleteObject(bgBrush); bgBrush = nullptr; }
     }
 
     void UpdateBrushes() {
+        if (bgBrush && brushVersion == exo::Theme::Version()) return;
         DestroyBrushes();
-        bgBrush = CreateSolidBrush(exo::Theme::Colors().background);
+        bgBrush      = CreateSolidBrush(exo::Theme::Rgb(exo::ThemeToken::Background));
+        brushVersion = exo::Theme::Version();
     }
 };
 
@@ -56,30 +151,104 @@ static void LayoutChildren(HWND hwnd, AppState& app) {
     int contentH = clientH - toolbarH - statusH;
     app.sidebar.Resize(0, toolbarH, sidebarW, contentH);
 
-    MoveWindow(app.listView, sidebarW, toolbarH,
-        clientW - sidebarW, contentH, TRUE);
+    app.itemView.Resize(sidebarW, toolbarH, clientW - sidebarW, contentH);
 }
 
 // ── Theme Application ───────────────────────────────────────
+// Runs on every theme switch, toggled or from the system. The controls
+// notice the new Theme::Version() on their next paint; they only need
+// invalidating.
 static void ApplyTheme(HWND hwnd, AppState& app) {
     exo::Theme::ApplyToWindow(hwnd);
     app.UpdateBrushes();
+    RedrawWindow(hwnd, nullptr, nullptr, RDW_INVALIDATE | RDW_ALLCHILDREN);
+}
+
+// ── Icon Prewarming ─────────────────────────────────────────
+// Render the controls' icons for every monitor's DPI in the background,
+// so dragging the window across to one is a cache lookup, not a render.
+static void PrewarmIcons(AppState& app) {
+    int dpis[16];
+    int count = exo::Dpi::MonitorDpis(dpis, static_cast<int>(std::size(dpis)));
+    app.toolbar.PrewarmDpis(dpis, count);
+    app.sidebar.PrewarmDpis(dpis, count);
+    app.itemView.PrewarmDpis(dpis, count);
+}
+
+// ── Paint Profiler ──────────────────────────────────────────
+// Every control's paint counts, times and area, the shared caches' hit
+// rates, icon renders and atlas uploads. The overlay refreshes once a
+// second while shown; a dump adds each control's paint-time histogram.
+static void BuildReport(AppState& app, exo::ProfileReport& report, bool histograms) {
+    struct Row {
+        const char*        name;
+        exo::PaintSnapshot paint;
+    };
+    const Row rows[] = {
+        { "toolbar",  app.toolbar.GetPaintStats() },
+        { "sidebar",  app.sidebar.GetPaintStats() },
+        { "items",    app.itemView.GetPaintStats() },
+        { "status",   app.statusbar.GetPaintStats() },
+        { "profiler", app.profiler.GetPaintStats() },
+    };
+
+    report.Begin(static_cast<double>(GetTickCount64()));
+    for (const auto& r : rows) report.Paint(r.name, r.paint);
+
+    auto render = exo::RenderContext::CacheStats();
+    report.Hits("formats", render.textFormatHits, render.textFormatMisses);
+    report.Hits("brushes", render.brushHits, render.brushMisses);
+    report.Hits("layouts", render.layoutHits, render.layoutMisses);
+
+    // A miss that the disk cache can't answer is a rasterization.
+    auto icons = exo::LucideIcons::CacheStats();
+    report.Hits("icons", icons.hits, icons.misses);
+    report.Rate("renders", icons.misses - (std::min)(icons.diskHits, icons.misses));
+    report.Rate("uploads", app.toolbar.GetAtlasStats().uploads + app.sidebar.GetAtlasStats().uploads +
+                           app.itemView.GetAtlasStats().uploads);
+    report.Rate("frames", exo::Animator::Stats().frames);
+
+    if (histograms) {
+        for (const auto& r : rows) report.Histogram(r.name, r.paint);
+    }
+}
 
-    auto& c = exo::Theme::Colors();
-    ListView_SetBkColor(app.listView, c.background);
-    ListView_SetTextBkColor(app.listView, c.background);
-    ListView_SetTextColor(app.listView, c.text);
+static void RefreshProfiler(AppState& app) {
+    BuildReport(app, app.overlayReport, false);
+    app.profiler.SetLines(app.overlayReport.Lines());
+}
 
-    if (exo::Theme::IsDark()) {
-        SetWindowTheme(app.listView, L"", L"");
+static void ToggleProfiler(HWND hwnd, AppState& app) {
+    bool show = !app.profiler.Visible();
+    if (show) {
+        RefreshProfiler(app);
+        SetTimer(hwnd, TIMER_PROFILER, PROFILER_REFRESH_MS, nullptr);
     } else {
-        SetWindowTheme(app.listView, L"Explorer", nullptr);
+        KillTimer(hwnd, TIMER_PROFILER);
     }
+    app.profiler.Show(show);
+}
 
-    app.toolbar.Repaint();
-    app.sidebar.Repaint();
-    app.statusbar.Repaint();
-    InvalidateRect(hwnd, nullptr, TRUE);
+// Written next to the executable, replacing the previous dump.
+static void DumpProfile(AppState& app) {
+    BuildReport(app, app.dumpReport, true);
+    std::string text = app.dumpReport.Text();
+
+    std::wstring path(MAX_PATH, L'\0');
+    path.resize(GetModuleFileNameW(nullptr, path.data(), MAX_PATH));
+    path.erase(path.find_last_of(L'\\') + 1);
+    path += PROFILE_FILE;
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    DWORD written = 0;
+    bool ok = file != INVALID_HANDLE_VALUE &&
+              WriteFile(file, text.data(), static_cast<DWORD>(text.size()), &written, nullptr) &&
+              written == text.size();
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+    std::wstring status = ok ? L"Paint profile written to " : L"Couldn't write ";
+    app.statusbar.SetText((status + PROFILE_FILE).c_str());
 }
 
 // ── Window Procedure ────────────────────────────────────────
@@ -103,59 +272,83 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
         app->sidebar.Create(hwnd, hInst, IDC_SIDEBAR);
         app->statusbar.Create(hwnd, hInst, IDC_STATUSBAR);
 
-        app->listView = CreateWindowExW(
-            0, WC_LISTVIEWW, nullptr,
-            WS_CHILD | WS_VISIBLE | LVS_ICON | LVS_AUTOARRANGE | LVS_SINGLESEL,
-            0, 0, 400, 400,
-            hwnd, reinterpret_cast<HMENU>(static_cast<INT_PTR>(IDC_LISTVIEW)),
-            hInst, nullptr
-        );
-        ListView_SetExtendedListViewStyle(app->listView,
-            LVS_EX_DOUBLEBUFFER | LVS_EX_FULLROWSELECT);
+        app->itemView.Create(hwnd, hInst, IDC_ITEMVIEW);
+        app->itemView.SetColumns(kItemColumns, static_cast<int>(std::size(kItemColumns)));
+        app->applets.Init();
+        app->itemView.SetModel(&app->applets);
 
+        app->profiler.Create(hwnd, hInst);
+        app->profiler.Place(app->itemView.Handle());
+
+        app->themeSub = exo::Theme::Subscribe([hwnd, app] { ApplyTheme(hwnd, *app); });
         ApplyTheme(hwnd, *app);
+        // Laid out already so the item view knows which icons are in view.
+        LayoutChildren(hwnd, *app);
+        PrewarmIcons(*app);
         return 0;
     }
 
     case WM_SIZE:
-        if (app) LayoutChildren(hwnd, *app);
+        if (app) {
+            LayoutChildren(hwnd, *app);
+            app->profiler.Place(app->itemView.Handle());
+        }
+        return 0;
+
+    // The overlay is a popup: it doesn't move with the window by itself.
+    case WM_MOVE:
+        if (app) app->profiler.Place(app->itemView.Handle());
+        return 0;
+
+    case WM_TIMER:
+        if (wp == TIMER_PROFILER) RefreshProfiler(*app);
         return 0;
 
     case WM_COMMAND: {
         WORD id = LOWORD(wp);
         switch (id) {
+        // HIWORD is the category the sidebar moved to.
+        case IDC_SIDEBAR:
+            app->applets.Filter(HIWORD(wp));
+            app->itemView.ModelChanged();
+            app->statusbar.SetText((std::to_wstring(app->applets.Count()) + L" items").c_str());
+            break;
+
         case exo::IDC_TB_THEME:
             exo::Theme::Toggle();
-            ApplyTheme(hwnd, *app);
             break;
 
         case exo::IDC_TB_VIEW_LARGE:
-            SetWindowLongPtrW(app->listView, GWL_STYLE,
-                (GetWindowLongPtrW(app->listView, GWL_STYLE) & ~LVS_TYPEMASK) | LVS_ICON);
+            app->itemView.SetMode(exo::ItemViewMode::LargeIcons);
             app->statusbar.SetText(L"Large Icons");
             break;
 
         case exo::IDC_TB_VIEW_SMALL:
-            SetWindowLongPtrW(app->listView, GWL_STYLE,
-                (GetWindowLongPtrW(app->listView, GWL_STYLE) & ~LVS_TYPEMASK) | LVS_SMALLICON);
+            app->itemView.SetMode(exo::ItemViewMode::SmallIcons);
             app->statusbar.SetText(L"Small Icons");
             break;
 
         case exo::IDC_TB_VIEW_LIST:
-            SetWindowLongPtrW(app->listView, GWL_STYLE,
-                (GetWindowLongPtrW(app->listView, GWL_STYLE) & ~LVS_TYPEMASK) | LVS_LIST);
+            app->itemView.SetMode(exo::ItemViewMode::List);
             app->statusbar.SetText(L"List");
             break;
 
         case exo::IDC_TB_VIEW_DETAILS:
-            SetWindowLongPtrW(app->listView, GWL_STYLE,
-                (GetWindowLongPtrW(app->listView, GWL_STYLE) & ~LVS_TYPEMASK) | LVS_REPORT);
+            app->itemView.SetMode(exo::ItemViewMode::Details);
             app->statusbar.SetText(L"Details");
             break;
 
         case exo::IDC_TB_REFRESH:
             app->statusbar.SetText(L"Refreshing...");
             break;
+
+        case IDM_PROFILER:
+            ToggleProfiler(hwnd, *app);
+            break;
+
+        case IDM_PROFILER_DUMP:
+            DumpProfile(*app);
+            break;
         }
         return 0;
     }
@@ -166,6 +359,7 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
         app->toolbar.UpdateDpi(newDpi);
         app->sidebar.UpdateDpi(newDpi);
         app->statusbar.UpdateDpi(newDpi);
+        app->itemView.UpdateDpi(newDpi);
 
         auto* suggested = reinterpret_cast<RECT*>(lp);
         SetWindowPos(hwnd, nullptr,
@@ -176,19 +370,18 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
         return 0;
     }
 
-    case WM_SETTINGCHANGE:
-        if (lp && wcscmp(reinterpret_cast<LPCWSTR>(lp), L"ImmersiveColorSet") == 0) {
-            exo::Theme::SetDark(exo::Theme::IsDarkMode());
-            ApplyTheme(hwnd, *app);
-        }
+    // A monitor was attached, removed or rescaled.
+    case WM_DISPLAYCHANGE:
+        PrewarmIcons(*app);
         return 0;
 
     case WM_PAINT: {
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hwnd, &ps);
-        HBRUSH br = CreateSolidBrush(exo::Theme::Colors().background);
-        FillRect(hdc, &ps.rcPaint, br);
-        DeleteObject(br);
+        if (app) {
+            app->UpdateBrushes();
+            FillRect(hdc, &ps.rcPaint, app->bgBrush);
+        }
         EndPaint(hwnd, &ps);
         return 0;
     }
@@ -197,7 +390,11 @@ static LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
         return 1;
 
     case WM_DESTROY:
-        if (app) app->DestroyBrushes();
+        if (app) {
+            KillTimer(hwnd, TIMER_PROFILER);
+            exo::Theme::Unsubscribe(app->themeSub);
+            app->DestroyBrushes();
+        }
         PostQuitMessage(0);
         return 0;
     }
@@ -212,7 +409,7 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int nCmdShow) {
 
     INITCOMMONCONTROLSEX icc{};
     icc.dwSize = sizeof(icc);
-    icc.dwICC  = ICC_STANDARD_CLASSES | ICC_LISTVIEW_CLASSES | ICC_BAR_CLASSES;
+    icc.dwICC  = ICC_STANDARD_CLASSES | ICC_BAR_CLASSES;
     InitCommonControlsEx(&icc);
 
     // Initialize ExoUI (D2D, DirectWrite, Lucide icons)
@@ -257,11 +454,22 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR, int nCmdShow) {
     ShowWindow(hwnd, nCmdShow);
     UpdateWindow(hwnd);
 
+    ACCEL accels[] = {
+        { FVIRTKEY,            VK_F12, IDM_PROFILER },
+        { FVIRTKEY | FCONTROL, VK_F12, IDM_PROFILER_DUMP },
+    };
+    HACCEL accel = CreateAcceleratorTableW(accels, static_cast<int>(std::size(accels)));
+
     MSG msg{};
     while (GetMessageW(&msg, nullptr, 0, 0)) {
+        if (accel && TranslateAcceleratorW(hwnd, accel, &msg)) continue;
         TranslateMessage(&msg);
         DispatchMessageW(&msg);
     }
+    if (accel) DestroyAcceleratorTable(accel);
 
+    exo::IconService::Shutdown();
+    exo::Animator::Shutdown();
+    exo::Theme::Shutdown();
     return static_cast<int>(msg.wParam);
 }